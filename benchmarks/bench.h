@@ -0,0 +1,100 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#pragma once
+
+#include "fc/core/ticker.h"
+
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace Bench
+{
+
+struct Result
+{
+    std::string name;
+    size_t ops;
+    double seconds;
+
+    [[nodiscard]] double nsPerOp() const
+    {
+        return (seconds * 1e9) / ops;
+    }
+};
+
+/**
+ * Written to after each run so the compiler can't optimize away the benchmarked code
+ */
+inline volatile size_t SINK = 0;
+
+/**
+ * Runs `fn` `rounds` times and keeps the fastest round.
+ * `fn` should do `opsPerRound` operations and return something that depends on their results
+ */
+template<typename Fn>
+Result Run(const std::string& name, size_t opsPerRound, Fn&& fn, size_t rounds = 10)
+{
+    // warmup
+    SINK = SINK + fn();
+
+    double best = 0;
+    for (size_t i = 0; i < rounds; i++) {
+        double start = Ticker::getTime();
+        SINK = SINK + fn();
+        double elapsed = Ticker::getTime() - start;
+
+        if (i == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    return {
+        .name = name,
+        .ops = opsPerRound,
+        .seconds = best,
+    };
+}
+
+inline void Print(const std::vector<Result>& results)
+{
+    for (const auto& result : results) {
+        std::cout << std::format("{:<48} {:>10.2f} ns/op\n", result.name, result.nsPerOp());
+    }
+}
+
+/**
+ * Same as Print but as a JSON array, so results can be saved and compared between commits
+ */
+inline void PrintJson(const std::vector<Result>& results)
+{
+    std::cout << "[\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+
+        std::string name;
+        for (char c : result.name) {
+            if (c == '"' || c == '\\') {
+                name += '\\';
+            }
+            name += c;
+        }
+
+        std::cout << std::format(
+            "  {{\"name\": \"{}\", \"ops\": {}, \"ns_per_op\": {:.3f}}}{}\n",
+            name,
+            result.ops,
+            result.nsPerOp(),
+            i + 1 < results.size() ? "," : ""
+        );
+    }
+    std::cout << "]\n";
+}
+
+};
@@ -0,0 +1,325 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "bench.h"
+
+#include "fc/core/bitStream.h"
+#include "fc/core/bufferPool.h"
+#include "fc/core/net/schema.h"
+
+#include <cstdint>
+#include <format>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+//
+// Writing and reading entity snapshots, mostly small unaligned fields
+//
+
+inline constexpr size_t ENTITY_COUNT = 4096;
+
+struct Entity
+{
+    uint16_t id;
+    bool alive;
+    uint8_t type;
+    uint32_t x;
+    uint32_t y;
+    int16_t velX;
+    int16_t velY;
+    uint8_t health;
+};
+
+/**
+ * Bits of each field in the order they're written
+ */
+inline constexpr uint8_t ID_BITS = 12;
+inline constexpr uint8_t TYPE_BITS = 5;
+inline constexpr uint8_t POS_BITS = 20;
+inline constexpr uint8_t VEL_BITS = 11;
+inline constexpr uint8_t HEALTH_BITS = 7;
+inline constexpr size_t FIELDS_PER_ENTITY = 8;
+inline constexpr size_t ENTITY_BITS = ID_BITS + 1 + TYPE_BITS + (POS_BITS * 2) + (VEL_BITS * 2) + HEALTH_BITS;
+
+using EntitySchema = Schema<
+    Entity,
+    IntField<&Entity::id, ID_BITS>,
+    BoolField<&Entity::alive>,
+    IntField<&Entity::type, TYPE_BITS>,
+    IntField<&Entity::x, POS_BITS>,
+    IntField<&Entity::y, POS_BITS>,
+    IntField<&Entity::velX, VEL_BITS>,
+    IntField<&Entity::velY, VEL_BITS>,
+    IntField<&Entity::health, HEALTH_BITS>>;
+
+static_assert(EntitySchema::BITS == ENTITY_BITS);
+
+static void writeEntity(BitStream& stream, const Entity& entity)
+{
+    stream.writeBits(entity.id, ID_BITS);
+    stream.writeBool(entity.alive);
+    stream.writeBits(entity.type, TYPE_BITS);
+    stream.writeBits(entity.x, POS_BITS);
+    stream.writeBits(entity.y, POS_BITS);
+    stream.writeBits(entity.velX, VEL_BITS);
+    stream.writeBits(entity.velY, VEL_BITS);
+    stream.writeBits(entity.health, HEALTH_BITS);
+}
+
+static void writeEntityUnchecked(BitStream::UncheckedWriter& writer, const Entity& entity)
+{
+    writer.writeBits(entity.id, ID_BITS);
+    writer.writeBool(entity.alive);
+    writer.writeBits(entity.type, TYPE_BITS);
+    writer.writeBits(entity.x, POS_BITS);
+    writer.writeBits(entity.y, POS_BITS);
+    writer.writeBits(entity.velX, VEL_BITS);
+    writer.writeBits(entity.velY, VEL_BITS);
+    writer.writeBits(entity.health, HEALTH_BITS);
+}
+
+static size_t readEntity(BitStream& stream)
+{
+    size_t sum = stream.readBits<uint16_t>(ID_BITS);
+    sum += stream.readBool() ? 1 : 0;
+    sum += stream.readBits<uint8_t>(TYPE_BITS);
+    sum += stream.readBits<uint32_t>(POS_BITS);
+    sum += stream.readBits<uint32_t>(POS_BITS);
+    sum += stream.readBits<int16_t>(VEL_BITS);
+    sum += stream.readBits<int16_t>(VEL_BITS);
+    sum += stream.readBits<uint8_t>(HEALTH_BITS);
+    return sum;
+}
+
+static size_t readEntityUnchecked(BitStream::UncheckedReader& reader)
+{
+    size_t sum = reader.readBits<uint16_t>(ID_BITS);
+    sum += reader.readBool() ? 1 : 0;
+    sum += reader.readBits<uint8_t>(TYPE_BITS);
+    sum += reader.readBits<uint32_t>(POS_BITS);
+    sum += reader.readBits<uint32_t>(POS_BITS);
+    sum += reader.readBits<int16_t>(VEL_BITS);
+    sum += reader.readBits<int16_t>(VEL_BITS);
+    sum += reader.readBits<uint8_t>(HEALTH_BITS);
+    return sum;
+}
+
+int main()
+{
+    std::mt19937 rng(1337);
+    std::uniform_int_distribution<uint32_t> posDist(0, (1 << POS_BITS) - 1);
+    std::uniform_int_distribution<int16_t> velDist(-1000, 1000);
+
+    std::vector<Entity> entities;
+    for (size_t i = 0; i < ENTITY_COUNT; i++) {
+        entities.push_back({
+            .id = (uint16_t)i,
+            .alive = (rng() & 1) != 0,
+            .type = (uint8_t)(rng() % 32),
+            .x = posDist(rng),
+            .y = posDist(rng),
+            .velX = velDist(rng),
+            .velY = velDist(rng),
+            .health = (uint8_t)(rng() % 100),
+        });
+    }
+
+    std::vector<uint8_t> buff(ENTITY_COUNT * 16);
+    constexpr size_t OPS = ENTITY_COUNT * FIELDS_PER_ENTITY;
+
+    std::vector<Bench::Result> results;
+
+    results.push_back(Bench::Run("Write fields", OPS, [&] {
+        BitStream stream(buff.data(), buff.size());
+        for (const Entity& entity : entities) {
+            writeEntity(stream, entity);
+        }
+        return stream.bitIndex();
+    }));
+
+    results.push_back(Bench::Run("Write fields unchecked", OPS, [&] {
+        BitStream stream(buff.data(), buff.size());
+        BitStream::UncheckedWriter writer(stream, ENTITY_BITS * ENTITY_COUNT);
+        for (const Entity& entity : entities) {
+            writeEntityUnchecked(writer, entity);
+        }
+        return stream.bitIndex();
+    }));
+
+    results.push_back(Bench::Run("Write fields schema", OPS, [&] {
+        BitStream stream(buff.data(), buff.size());
+        for (const Entity& entity : entities) {
+            EntitySchema::write(stream, entity);
+        }
+        return stream.bitIndex();
+    }));
+
+    results.push_back(Bench::Run("Write fields schema, all entities", OPS, [&] {
+        BitStream stream(buff.data(), buff.size());
+        EntitySchema::write(stream, std::span<const Entity>(entities));
+        return stream.bitIndex();
+    }));
+
+    // a new packet each round like each client each tick, starting small so it grows
+    BufferPool pool;
+    results.push_back(Bench::Run("Write fields growable", OPS, [&] {
+        BitStream stream(pool);
+        for (const Entity& entity : entities) {
+            writeEntity(stream, entity);
+        }
+        std::vector<uint8_t> packet = stream.takeBytes();
+        size_t size = packet.size();
+        pool.release(std::move(packet));
+        return size;
+    }));
+
+    results.push_back(Bench::Run("Read fields", OPS, [&] {
+        BitStream stream(buff.data(), buff.size());
+        size_t sum = 0;
+        for (size_t i = 0; i < ENTITY_COUNT; i++) {
+            sum += readEntity(stream);
+        }
+        return sum;
+    }));
+
+    results.push_back(Bench::Run("Read fields unchecked", OPS, [&] {
+        BitStream stream(buff.data(), buff.size());
+        BitStream::UncheckedReader reader(stream, ENTITY_BITS * ENTITY_COUNT);
+        size_t sum = 0;
+        for (size_t i = 0; i < ENTITY_COUNT; i++) {
+            sum += readEntityUnchecked(reader);
+        }
+        return sum;
+    }));
+
+    results.push_back(Bench::Run("Read fields schema", OPS, [&] {
+        BitStream stream(buff.data(), buff.size());
+        size_t sum = 0;
+        for (size_t i = 0; i < ENTITY_COUNT; i++) {
+            sum += EntitySchema::read(stream).x;
+        }
+        return sum;
+    }));
+
+    results.push_back(Bench::Run("Write 64 bit values", ENTITY_COUNT, [&] {
+        BitStream stream(buff.data(), buff.size());
+        stream.writeBool(true);
+        for (const Entity& entity : entities) {
+            stream.writeUint64(((uint64_t)entity.x << 32) | entity.y);
+        }
+        return stream.bitIndex();
+    }));
+
+    results.push_back(Bench::Run("Read 64 bit values", ENTITY_COUNT, [&] {
+        BitStream stream(buff.data(), buff.size());
+        size_t sum = stream.readBool() ? 1 : 0;
+        for (size_t i = 0; i < ENTITY_COUNT; i++) {
+            sum += stream.readUint64();
+        }
+        return sum;
+    }));
+
+    // IDs and counts are mostly tiny
+    std::geometric_distribution<uint32_t> smallDist(0.05);
+    std::vector<uint32_t> smallValues;
+    for (size_t i = 0; i < ENTITY_COUNT; i++) {
+        smallValues.push_back(smallDist(rng));
+    }
+
+    size_t fixedBits = 0;
+    size_t varBits = 0;
+    size_t golombBits = 0;
+
+    results.push_back(Bench::Run("Write small values uint32", ENTITY_COUNT, [&] {
+        BitStream stream(buff.data(), buff.size());
+        for (uint32_t value : smallValues) {
+            stream.writeUint32(value);
+        }
+        fixedBits = stream.bitIndex();
+        return fixedBits;
+    }));
+
+    results.push_back(Bench::Run("Write small values LEB128", ENTITY_COUNT, [&] {
+        BitStream stream(buff.data(), buff.size());
+        for (uint32_t value : smallValues) {
+            stream.writeVarUint(value);
+        }
+        varBits = stream.bitIndex();
+        return varBits;
+    }));
+
+    results.push_back(Bench::Run("Read small values LEB128", ENTITY_COUNT, [&] {
+        BitStream stream(buff.data(), buff.size());
+        size_t sum = 0;
+        for (size_t i = 0; i < ENTITY_COUNT; i++) {
+            sum += stream.readVarUint();
+        }
+        return sum;
+    }));
+
+    results.push_back(Bench::Run("Write small values exp-Golomb k=3", ENTITY_COUNT, [&] {
+        BitStream stream(buff.data(), buff.size());
+        for (uint32_t value : smallValues) {
+            stream.writeExpGolomb(value, 3);
+        }
+        golombBits = stream.bitIndex();
+        return golombBits;
+    }));
+
+    results.push_back(Bench::Run("Read small values exp-Golomb k=3", ENTITY_COUNT, [&] {
+        BitStream stream(buff.data(), buff.size());
+        size_t sum = 0;
+        for (size_t i = 0; i < ENTITY_COUNT; i++) {
+            sum += stream.readExpGolomb(3);
+        }
+        return sum;
+    }));
+
+    // player names and chat
+    std::vector<std::string> strings;
+    size_t stringBytes = 0;
+    for (size_t i = 0; i < 256; i++) {
+        strings.push_back(std::string(8 + (rng() % 56), (char)('a' + (i % 26))));
+        stringBytes += strings.back().size();
+    }
+
+    results.push_back(Bench::Run("Write strings", stringBytes, [&] {
+        BitStream stream(buff.data(), buff.size());
+        for (const std::string& str : strings) {
+            stream.writeString(str);
+        }
+        return stream.bitIndex();
+    }));
+
+    results.push_back(Bench::Run("Read strings", stringBytes, [&] {
+        BitStream stream(buff.data(), buff.size());
+        size_t sum = 0;
+        for (size_t i = 0; i < strings.size(); i++) {
+            sum += stream.readString().size();
+        }
+        return sum;
+    }));
+
+    results.push_back(Bench::Run("Read string views", stringBytes, [&] {
+        BitStream stream(buff.data(), buff.size());
+        size_t sum = 0;
+        for (size_t i = 0; i < strings.size(); i++) {
+            sum += stream.readStringView().size();
+        }
+        return sum;
+    }));
+
+    Bench::Print(results);
+    std::cout << std::format(
+        "small values: {:.1f} bits as uint32, {:.1f} bits as LEB128, {:.1f} bits as exp-Golomb\n",
+        (double)fixedBits / ENTITY_COUNT,
+        (double)varBits / ENTITY_COUNT,
+        (double)golombBits / ENTITY_COUNT
+    );
+    std::cout << std::format("{} buffers allocated by the pool\n", pool.allocations());
+}
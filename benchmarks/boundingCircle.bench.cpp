@@ -0,0 +1,110 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "bench.h"
+
+#include "fc/core/collision/collision.h"
+#include "fc/core/collision/shape.h"
+
+#include <format>
+#include <limits>
+#include <random>
+#include <vector>
+
+//
+// Polygon tests for pairs of shapes that share a grid cell, most of them don't collide.
+// An infinite bounding radius disables the bounding circle early-out to measure the full separating axis test
+//
+
+inline constexpr size_t PAIR_COUNT = 4096;
+inline constexpr float CELL_SIZE = 32;
+inline constexpr float NO_RADIUS = std::numeric_limits<float>::infinity();
+
+struct Pairs
+{
+    std::vector<Circle> circles;
+    std::vector<Rect> rects;
+    std::vector<Polygon> polysA;
+    std::vector<Polygon> polysB;
+};
+
+static Pairs generatePairs()
+{
+    std::mt19937 rng(1337);
+    std::uniform_real_distribution<float> posDist(0, CELL_SIZE);
+    std::uniform_real_distribution<float> sizeDist(2, 5);
+    std::uniform_real_distribution<float> angleDist(0, 3);
+
+    Pairs pairs;
+    for (size_t i = 0; i < PAIR_COUNT; i++) {
+        Vec2F posA{posDist(rng), posDist(rng)};
+        Vec2F posB{posDist(rng), posDist(rng)};
+        float sizeA = sizeDist(rng);
+        float sizeB = sizeDist(rng);
+
+        pairs.circles.emplace_back(posA, sizeA);
+        pairs.rects.push_back(Rect::fromDims(sizeA * 2, sizeA * 2, posA));
+        pairs.polysA.push_back(Polygon::fromSides(6, posA, sizeA));
+        pairs.polysA.back().rotate(angleDist(rng));
+        pairs.polysB.push_back(Polygon::fromSides(8, posB, sizeB));
+        pairs.polysB.back().rotate(angleDist(rng));
+    }
+    return pairs;
+}
+
+int main()
+{
+    Pairs pairs = generatePairs();
+
+    size_t hits = 0;
+    for (size_t i = 0; i < PAIR_COUNT; i++) {
+        hits += pairs.polysA[i].getCollision(pairs.polysB[i], nullptr) ? 1 : 0;
+    }
+    std::cout << std::format("PolygonPolygon miss rate: {}%\n", 100 - (hits * 100 / PAIR_COUNT));
+
+    std::vector<Bench::Result> results;
+
+    for (bool early : {false, true}) {
+        std::string suffix = early ? " (bounding circle)" : "";
+
+        results.push_back(Bench::Run("CirclePolygon" + suffix, PAIR_COUNT, [&] {
+            size_t hits = 0;
+            for (size_t i = 0; i < PAIR_COUNT; i++) {
+                const Circle& a = pairs.circles[i];
+                const Polygon& b = pairs.polysB[i];
+                Collision::Response res;
+                hits += Collision::CirclePolygon(a.pos, a.rad, b.points, b.normals(), b.center(), early ? b.radius() : NO_RADIUS, &res) ? 1 : 0;
+            }
+            return hits;
+        }));
+
+        results.push_back(Bench::Run("RectPolygon" + suffix, PAIR_COUNT, [&] {
+            size_t hits = 0;
+            for (size_t i = 0; i < PAIR_COUNT; i++) {
+                const Rect& a = pairs.rects[i];
+                const Polygon& b = pairs.polysB[i];
+                hits += Collision::RectPolygon(a.min, a.max, b.points, b.normals(), b.center(), early ? b.radius() : NO_RADIUS, nullptr) ? 1 : 0;
+            }
+            return hits;
+        }));
+
+        results.push_back(Bench::Run("PolygonPolygon" + suffix, PAIR_COUNT, [&] {
+            size_t hits = 0;
+            for (size_t i = 0; i < PAIR_COUNT; i++) {
+                const Polygon& a = pairs.polysA[i];
+                const Polygon& b = pairs.polysB[i];
+                hits += Collision::PolygonPolygon(
+                    a.points, a.normals(), a.center(), early ? a.radius() : NO_RADIUS,
+                    b.points, b.normals(), b.center(), early ? b.radius() : NO_RADIUS,
+                    nullptr
+                ) ? 1 : 0;
+            }
+            return hits;
+        }));
+    }
+
+    Bench::Print(results);
+}
@@ -0,0 +1,334 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "bench.h"
+
+#include "fc/core/collision/collision.h"
+#include "fc/core/collision/shape.h"
+
+#include <array>
+#include <cmath>
+#include <format>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//
+// Every Collision function and Shape::getCollision against random pairs of shapes,
+// once with pairs that mostly collide and once with pairs that mostly don't.
+//
+// Run with --json to print the results as JSON, e.g to compare them between commits.
+//
+
+inline constexpr size_t PAIR_COUNT = 2048;
+inline constexpr std::array<size_t, 3> POLY_SIDES = {3, 8, 24};
+
+/**
+ * Pair i of every shape type has the same positions and bounding radius
+ * so results of different functions are comparable
+ */
+struct Fixture
+{
+    std::vector<Circle> circlesA;
+    std::vector<Circle> circlesB;
+    std::vector<Rect> rectsA;
+    std::vector<Rect> rectsB;
+    std::vector<Polygon> polysA;
+    std::vector<Polygon> polysB;
+
+    /**
+     * A's movement for the swept tests, B doesn't move
+     */
+    std::vector<Vec2F> movesA;
+
+    /**
+     * Point tests against B
+     */
+    std::vector<Vec2F> points;
+
+    /**
+     * Ray casts against B
+     */
+    std::vector<Vec2F> rayStarts;
+    std::vector<Vec2F> rayDeltas;
+
+    /**
+     * Random mix of the shapes above for Shape::getCollision
+     */
+    std::vector<const Shape*> shapesA;
+    std::vector<const Shape*> shapesB;
+};
+
+static Fixture generateFixture(bool hits, size_t sides, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> radDist(1, 2);
+    std::uniform_real_distribution<float> angleDist(0, M_PI * 2);
+    // as a multiple of the sum of both bounding radii, misses are mostly close enough
+    // for the bounding circles to overlap so they don't all take the early out
+    std::uniform_real_distribution<float> distDist = hits ? std::uniform_real_distribution<float>(0, 0.7F)
+                                                          : std::uniform_real_distribution<float>(0.9F, 1.5F);
+    std::uniform_int_distribution<int> typeDist(0, 2);
+
+    Fixture fixture;
+
+    for (size_t i = 0; i < PAIR_COUNT; i++) {
+        Vec2F posA{(float)(i % 64) * 20, (float)(i / 64) * 20};
+        float radA = radDist(rng);
+        float radB = radDist(rng);
+
+        float angle = angleDist(rng);
+        Vec2F dir{std::cos(angle), std::sin(angle)};
+        Vec2F posB = posA + (dir * (distDist(rng) * (radA + radB)));
+
+        fixture.circlesA.emplace_back(posA, radA);
+        fixture.circlesB.emplace_back(posB, radB);
+
+        // same bounding radius as the circles
+        fixture.rectsA.push_back(Rect::fromDims(radA * (float)M_SQRT2, radA * (float)M_SQRT2, posA));
+        fixture.rectsB.push_back(Rect::fromDims(radB * (float)M_SQRT2, radB * (float)M_SQRT2, posB));
+
+        fixture.polysA.push_back(Polygon::fromSides(sides, posA, radA).rotate(angleDist(rng)));
+        fixture.polysB.push_back(Polygon::fromSides(sides, posB, radB).rotate(angleDist(rng)));
+
+        // towards and past B, or away from it
+        fixture.movesA.push_back(hits ? (posB - posA) * 2 : dir * -(radA + radB));
+
+        // inside the incircle of a triangle, or outside the bounding circle
+        float pointAngle = angleDist(rng);
+        float pointDist = radB * (hits ? 0.45F : 1.2F);
+        fixture.points.push_back(posB + (Vec2F{std::cos(pointAngle), std::sin(pointAngle)} * pointDist));
+
+        // through B's center, or passing next to it
+        float rayAngle = angleDist(rng);
+        Vec2F rayDir{std::cos(rayAngle), std::sin(rayAngle)};
+        Vec2F rayStart = posB - (rayDir * (radB * 3));
+        if (!hits) {
+            rayStart += Vec2F{-rayDir.y, rayDir.x} * (radB * 1.1F);
+        }
+        fixture.rayStarts.push_back(rayStart);
+        fixture.rayDeltas.push_back(rayDir * (radB * 6));
+    }
+
+    auto pickShape = [&](const Circle& circle, const Rect& rect, const Polygon& poly) -> const Shape* {
+        switch (typeDist(rng)) {
+            case 0:
+                return &circle;
+            case 1:
+                return &rect;
+            default:
+                return &poly;
+        }
+    };
+
+    for (size_t i = 0; i < PAIR_COUNT; i++) {
+        fixture.shapesA.push_back(pickShape(fixture.circlesA[i], fixture.rectsA[i], fixture.polysA[i]));
+        fixture.shapesB.push_back(pickShape(fixture.circlesB[i], fixture.rectsB[i], fixture.polysB[i]));
+    }
+
+    return fixture;
+}
+
+/**
+ * Runs `check(i)` for every pair of the fixture
+ */
+template<typename Fn>
+static Bench::Result runPairs(const std::string& name, Fn&& check)
+{
+    return Bench::Run(name, PAIR_COUNT, [&] {
+        size_t hits = 0;
+        for (size_t i = 0; i < PAIR_COUNT; i++) {
+            hits += check(i) ? 1 : 0;
+        }
+        return hits;
+    });
+}
+
+/**
+ * Functions that don't involve polygons, only run once per distribution
+ */
+static void benchSimple(const Fixture& f, std::string_view suffix, std::vector<Bench::Result>& results)
+{
+    auto name = [&](std::string_view fn) {
+        return std::format("{} {}", fn, suffix);
+    };
+
+    Collision::Response res;
+    Collision::Manifold manifold;
+    Collision::TimeOfImpact toi;
+    Collision::RayHit hit;
+
+    results.push_back(runPairs(name("CircleCircle"), [&](size_t i) {
+        const Circle& a = f.circlesA[i];
+        const Circle& b = f.circlesB[i];
+        return Collision::CircleCircle(a.pos, a.rad, b.pos, b.rad, &res);
+    }));
+    results.push_back(runPairs(name("CircleRect"), [&](size_t i) {
+        const Circle& a = f.circlesA[i];
+        const Rect& b = f.rectsB[i];
+        return Collision::CircleRect(a.pos, a.rad, b.min, b.max, &res);
+    }));
+    results.push_back(runPairs(name("RectRect"), [&](size_t i) {
+        const Rect& a = f.rectsA[i];
+        const Rect& b = f.rectsB[i];
+        return Collision::RectRect(a.min, a.max, b.min, b.max, &res);
+    }));
+
+    results.push_back(runPairs(name("PointCircle"), [&](size_t i) {
+        return Collision::PointCircle(f.points[i], f.circlesB[i].pos, f.circlesB[i].rad);
+    }));
+    results.push_back(runPairs(name("PointRect"), [&](size_t i) {
+        return Collision::PointRect(f.points[i], f.rectsB[i].min, f.rectsB[i].max);
+    }));
+
+    results.push_back(runPairs(name("ManifoldCircleCircle"), [&](size_t i) {
+        const Circle& a = f.circlesA[i];
+        const Circle& b = f.circlesB[i];
+        return Collision::ManifoldCircleCircle(a.pos, a.rad, b.pos, b.rad, &manifold);
+    }));
+    results.push_back(runPairs(name("ManifoldCircleRect"), [&](size_t i) {
+        const Circle& a = f.circlesA[i];
+        const Rect& b = f.rectsB[i];
+        return Collision::ManifoldCircleRect(a.pos, a.rad, b.min, b.max, &manifold);
+    }));
+    results.push_back(runPairs(name("ManifoldRectRect"), [&](size_t i) {
+        const Rect& a = f.rectsA[i];
+        const Rect& b = f.rectsB[i];
+        return Collision::ManifoldRectRect(a.min, a.max, b.min, b.max, &manifold);
+    }));
+
+    results.push_back(runPairs(name("SweepCircleCircle"), [&](size_t i) {
+        const Circle& a = f.circlesA[i];
+        const Circle& b = f.circlesB[i];
+        return Collision::SweepCircleCircle(a.pos, a.rad, f.movesA[i], b.pos, b.rad, {}, &toi);
+    }));
+    results.push_back(runPairs(name("SweepCircleRect"), [&](size_t i) {
+        const Circle& a = f.circlesA[i];
+        const Rect& b = f.rectsB[i];
+        return Collision::SweepCircleRect(a.pos, a.rad, f.movesA[i], b.min, b.max, {}, &toi);
+    }));
+    results.push_back(runPairs(name("SweepRectRect"), [&](size_t i) {
+        const Rect& a = f.rectsA[i];
+        const Rect& b = f.rectsB[i];
+        return Collision::SweepRectRect(a.min, a.max, f.movesA[i], b.min, b.max, {}, &toi);
+    }));
+
+    results.push_back(runPairs(name("RayCircle"), [&](size_t i) {
+        const Circle& b = f.circlesB[i];
+        return Collision::RayCircle(f.rayStarts[i], f.rayDeltas[i], b.pos, b.rad, &hit);
+    }));
+    results.push_back(runPairs(name("RayRect"), [&](size_t i) {
+        const Rect& b = f.rectsB[i];
+        return Collision::RayRect(f.rayStarts[i], f.rayDeltas[i], b.min, b.max, &hit);
+    }));
+
+    results.push_back(runPairs(name("Shape::getCollision"), [&](size_t i) {
+        return f.shapesA[i]->getCollision(*f.shapesB[i], &res);
+    }));
+
+    Bench::SINK = Bench::SINK + (size_t)(res.depth + manifold.depths[0] + toi.time + hit.fraction);
+}
+
+/**
+ * Functions that take polygons, run for each polygon size
+ */
+static void benchPolygons(const Fixture& f, std::string_view suffix, std::vector<Bench::Result>& results)
+{
+    auto name = [&](std::string_view fn) {
+        return std::format("{} {}", fn, suffix);
+    };
+
+    Collision::Response res;
+    Collision::Manifold manifold;
+    Collision::TimeOfImpact toi;
+    Collision::RayHit hit;
+
+    results.push_back(runPairs(name("CirclePolygon"), [&](size_t i) {
+        const Circle& a = f.circlesA[i];
+        const Polygon& b = f.polysB[i];
+        return Collision::CirclePolygon(a.pos, a.rad, b.points, b.normals(), b.center(), b.radius(), &res);
+    }));
+    results.push_back(runPairs(name("RectPolygon"), [&](size_t i) {
+        const Rect& a = f.rectsA[i];
+        const Polygon& b = f.polysB[i];
+        return Collision::RectPolygon(a.min, a.max, b.points, b.normals(), b.center(), b.radius(), &res);
+    }));
+    results.push_back(runPairs(name("PolygonPolygon"), [&](size_t i) {
+        const Polygon& a = f.polysA[i];
+        const Polygon& b = f.polysB[i];
+        return Collision::PolygonPolygon(a.points, a.normals(), a.center(), a.radius(), b.points, b.normals(), b.center(), b.radius(), &res);
+    }));
+
+    results.push_back(runPairs(name("PointPolygon"), [&](size_t i) {
+        return Collision::PointPolygon(f.points[i], f.polysB[i].points);
+    }));
+
+    results.push_back(runPairs(name("ManifoldCirclePolygon"), [&](size_t i) {
+        const Circle& a = f.circlesA[i];
+        const Polygon& b = f.polysB[i];
+        return Collision::ManifoldCirclePolygon(a.pos, a.rad, b.points, b.normals(), b.center(), b.radius(), &manifold);
+    }));
+    results.push_back(runPairs(name("ManifoldRectPolygon"), [&](size_t i) {
+        const Rect& a = f.rectsA[i];
+        const Polygon& b = f.polysB[i];
+        return Collision::ManifoldRectPolygon(a.min, a.max, b.points, b.normals(), b.center(), b.radius(), &manifold);
+    }));
+    results.push_back(runPairs(name("ManifoldPolygonPolygon"), [&](size_t i) {
+        const Polygon& a = f.polysA[i];
+        const Polygon& b = f.polysB[i];
+        return Collision::ManifoldPolygonPolygon(a.points, a.normals(), a.center(), a.radius(), b.points, b.normals(), b.center(), b.radius(), &manifold);
+    }));
+
+    results.push_back(runPairs(name("SweepCirclePolygon"), [&](size_t i) {
+        const Circle& a = f.circlesA[i];
+        const Polygon& b = f.polysB[i];
+        return Collision::SweepCirclePolygon(a.pos, a.rad, f.movesA[i], b.points, b.normals(), b.center(), b.radius(), {}, &toi);
+    }));
+    results.push_back(runPairs(name("SweepRectPolygon"), [&](size_t i) {
+        const Rect& a = f.rectsA[i];
+        const Polygon& b = f.polysB[i];
+        return Collision::SweepRectPolygon(a.min, a.max, f.movesA[i], b.points, b.normals(), b.center(), b.radius(), {}, &toi);
+    }));
+    results.push_back(runPairs(name("SweepPolygonPolygon"), [&](size_t i) {
+        const Polygon& a = f.polysA[i];
+        const Polygon& b = f.polysB[i];
+        return Collision::SweepPolygonPolygon(
+            a.points, a.normals(), a.center(), a.radius(), f.movesA[i], b.points, b.normals(), b.center(), b.radius(), {}, &toi
+        );
+    }));
+
+    results.push_back(runPairs(name("RayPolygon"), [&](size_t i) {
+        const Polygon& b = f.polysB[i];
+        return Collision::RayPolygon(f.rayStarts[i], f.rayDeltas[i], b.points, b.normals(), b.center(), b.radius(), &hit);
+    }));
+
+    Bench::SINK = Bench::SINK + (size_t)(res.depth + manifold.depths[0] + toi.time + hit.fraction);
+}
+
+int main(int argc, char** argv)
+{
+    bool json = argc > 1 && std::string_view(argv[1]) == "--json";
+
+    std::vector<Bench::Result> results;
+
+    for (bool hits : {true, false}) {
+        std::string_view distribution = hits ? "hits" : "misses";
+
+        // Shape::getCollision mixes in polygons, use the middle size for it
+        benchSimple(generateFixture(hits, POLY_SIDES[1], 1337), distribution, results);
+
+        for (size_t sides : POLY_SIDES) {
+            benchPolygons(generateFixture(hits, sides, 1337), std::format("{} sides {}", sides, distribution), results);
+        }
+    }
+
+    if (json) {
+        Bench::PrintJson(results);
+    } else {
+        Bench::Print(results);
+    }
+}
@@ -0,0 +1,110 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "bench.h"
+
+#include "fc/core/collision/grid.h"
+#include "fc/core/collision/shape.h"
+
+#include <cstdint>
+#include <format>
+#include <random>
+#include <vector>
+
+//
+// Circles moving around a concave cave wall, either as a single compound polygon
+// or as separate triangles each with their own grid entry
+//
+
+inline constexpr size_t PROBE_COUNT = 4096;
+inline constexpr uint32_t WORLD_SIZE = 1024;
+inline constexpr uint32_t CELL_SIZE = 32;
+inline constexpr int TEETH = 48;
+
+/**
+ * Floor with stalagmites of random height
+ */
+static std::vector<Vec2F> caveOutline()
+{
+    std::mt19937 rng(1337);
+    std::uniform_real_distribution<float> heightDist(40, 200);
+
+    const float toothWidth = (float)WORLD_SIZE / TEETH;
+
+    std::vector<Vec2F> outline = {{0, 0}, {(float)WORLD_SIZE, 0}};
+    for (int tooth = TEETH - 1; tooth >= 0; tooth--) {
+        float left = tooth * toothWidth;
+        float height = heightDist(rng);
+
+        outline.emplace_back(left + toothWidth, 20);
+        outline.emplace_back(left + (toothWidth * 0.6F), height);
+        outline.emplace_back(left + (toothWidth * 0.4F), height);
+        outline.emplace_back(left, 20);
+    }
+    return outline;
+}
+
+int main()
+{
+    CompoundPolygon cave(caveOutline());
+
+    // fan triangulate the convex parts, what you'd get from a plain triangulation
+    std::vector<Polygon> triangles;
+    for (const auto& part : cave.parts()) {
+        for (size_t i = 1; i + 1 < part.points.size(); i++) {
+            triangles.emplace_back(std::vector<Vec2F>{part.points[0], part.points[i], part.points[i + 1]});
+        }
+    }
+
+    Grid<uint32_t, uint32_t> compoundGrid(WORLD_SIZE, CELL_SIZE, 2);
+    auto [caveMin, caveMax] = cave.getAABB();
+    compoundGrid.insertEntity(1, caveMin, caveMax);
+
+    Grid<uint32_t, uint32_t> triangleGrid(WORLD_SIZE, CELL_SIZE, triangles.size() + 1);
+    for (uint32_t i = 0; i < triangles.size(); i++) {
+        auto [min, max] = triangles[i].getAABB();
+        triangleGrid.insertEntity(i + 1, min, max);
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> xDist(0, WORLD_SIZE);
+    std::uniform_real_distribution<float> yDist(0, 250);
+    std::vector<Circle> probes;
+    for (size_t i = 0; i < PROBE_COUNT; i++) {
+        probes.emplace_back(Vec2F{xDist(rng), yDist(rng)}, 6);
+    }
+
+    std::cout << std::format("{} compound parts, {} triangles\n", cave.parts().size(), triangles.size());
+
+    std::vector<Bench::Result> results;
+
+    results.push_back(Bench::Run("Separate triangles", PROBE_COUNT, [&] {
+        size_t hits = 0;
+        for (const Circle& probe : probes) {
+            auto [min, max] = probe.getAABB();
+            for (uint32_t id : triangleGrid.queryAABB(min, max)) {
+                Collision::Response res;
+                hits += probe.getCollision(triangles[id - 1], &res) ? 1 : 0;
+            }
+        }
+        return hits;
+    }));
+
+    results.push_back(Bench::Run("Compound polygon", PROBE_COUNT, [&] {
+        size_t hits = 0;
+        for (const Circle& probe : probes) {
+            auto [min, max] = probe.getAABB();
+            for (uint32_t id : compoundGrid.queryAABB(min, max)) {
+                (void)id;
+                Collision::Response res;
+                hits += probe.getCollision(cave, &res) ? 1 : 0;
+            }
+        }
+        return hits;
+    }));
+
+    Bench::Print(results);
+}
@@ -0,0 +1,160 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "bench.h"
+
+#include "fc/core/bitStream.h"
+#include "fc/core/net/huffman.h"
+#include "fc/core/net/snapshot.h"
+
+#include <cstdint>
+#include <format>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+//
+// Compressing recorded packets with a model trained on other packets of the same game
+//
+
+inline constexpr size_t PACKET_COUNT = 256;
+inline constexpr size_t ENTITY_COUNT = 512;
+
+using Packets = std::vector<std::vector<uint8_t>>;
+
+/**
+ * Delta snapshots of entities wandering around, bit packed
+ */
+static Packets recordSnapshots(std::mt19937& rng)
+{
+    // x, y, animation frame, health
+    SnapshotEncoder encoder({16, 16, 4, 7}, 8);
+
+    std::vector<uint32_t> state(ENTITY_COUNT * 4);
+    for (size_t i = 0; i < ENTITY_COUNT; i++) {
+        state[i * 4] = rng() & 0xFFFF;
+        state[(i * 4) + 1] = rng() & 0xFFFF;
+        state[(i * 4) + 3] = 100;
+    }
+
+    Packets packets;
+    std::vector<uint8_t> buff(ENTITY_COUNT * 16);
+    for (uint32_t tick = 1; tick <= PACKET_COUNT; tick++) {
+        Snapshot& snapshot = encoder.next(tick);
+        for (size_t i = 0; i < ENTITY_COUNT; i++) {
+            uint32_t* fields = &state[i * 4];
+            if (rng() % 4 == 0) {
+                fields[0] = (fields[0] + (rng() % 5) - 2) & 0xFFFF;
+                fields[1] = (fields[1] + (rng() % 5) - 2) & 0xFFFF;
+                fields[2] = (fields[2] + 1) & 0xF;
+            }
+            snapshot.add(i, std::span<const uint32_t>(fields, 4));
+        }
+
+        BitStream stream(buff.data(), buff.size());
+        encoder.write(stream, tick - 1);
+        packets.emplace_back(buff.begin(), buff.begin() + stream.byteIndex());
+    }
+    return packets;
+}
+
+/**
+ * Byte aligned events: entity IDs, small varint deltas and chat
+ */
+static Packets recordEvents(std::mt19937& rng)
+{
+    std::geometric_distribution<int32_t> deltaDist(0.2);
+    const std::vector<std::string> chat = {"gg", "nice shot", "left side!", "lol", "one more?"};
+
+    Packets packets;
+    std::vector<uint8_t> buff(4096);
+    for (size_t i = 0; i < PACKET_COUNT; i++) {
+        BitStream stream(buff.data(), buff.size());
+
+        size_t events = 20 + (rng() % 40);
+        for (size_t j = 0; j < events; j++) {
+            stream.writeUint8(rng() % 6);
+            stream.writeVarUint(rng() % 300);
+            stream.writeVarInt(deltaDist(rng) * ((rng() & 1) != 0 ? 1 : -1));
+            stream.writeVarInt(deltaDist(rng) * ((rng() & 1) != 0 ? 1 : -1));
+            if (rng() % 16 == 0) {
+                stream.writeString(chat[rng() % chat.size()]);
+            }
+        }
+        packets.emplace_back(buff.begin(), buff.begin() + stream.byteIndex());
+    }
+    return packets;
+}
+
+static void benchTraffic(const std::string& name, const Packets& packets, std::vector<Bench::Result>& results)
+{
+    // train on the first half, compress the second half
+    size_t half = packets.size() / 2;
+
+    HuffmanModel::ByteCounts counts{};
+    for (size_t i = 0; i < half; i++) {
+        HuffmanModel::count(counts, packets[i]);
+    }
+    HuffmanModel model(counts);
+
+    size_t rawBytes = 0;
+    size_t compressedBytes = 0;
+    std::vector<std::vector<uint8_t>> compressed;
+    std::vector<uint8_t> buff(1 << 16);
+
+    for (size_t i = half; i < packets.size(); i++) {
+        BitStream stream(buff.data(), buff.size());
+        model.compress(stream, packets[i]);
+
+        rawBytes += packets[i].size();
+        compressedBytes += stream.byteIndex();
+        compressed.emplace_back(buff.begin(), buff.begin() + stream.byteIndex());
+    }
+
+    size_t count = packets.size() - half;
+
+    results.push_back(Bench::Run(std::format("Compress {} packets", name), count, [&] {
+        size_t sum = 0;
+        for (size_t i = half; i < packets.size(); i++) {
+            BitStream stream(buff.data(), buff.size());
+            model.compress(stream, packets[i]);
+            sum += stream.bitIndex();
+        }
+        return sum;
+    }));
+
+    std::vector<uint8_t> decompressed;
+    results.push_back(Bench::Run(std::format("Decompress {} packets", name), count, [&] {
+        size_t sum = 0;
+        for (auto& packet : compressed) {
+            BitStream stream(packet.data(), packet.size());
+            model.decompress(stream, decompressed);
+            sum += decompressed.size();
+        }
+        return sum;
+    }));
+
+    std::cout << std::format(
+        "{}: {} bytes per packet, {} compressed ({:.1f}%)\n",
+        name,
+        rawBytes / count,
+        compressedBytes / count,
+        100.0 * (double)compressedBytes / (double)rawBytes
+    );
+}
+
+int main()
+{
+    std::mt19937 rng(1337);
+
+    std::vector<Bench::Result> results;
+    benchTraffic("snapshot", recordSnapshots(rng), results);
+    benchTraffic("event", recordEvents(rng), results);
+
+    // per packet
+    Bench::Print(results);
+}
@@ -0,0 +1,137 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "bench.h"
+
+#include "fc/core/bitStream.h"
+#include "fc/core/net/interestManager.h"
+#include "fc/core/net/snapshot.h"
+#include "fc/core/threadPool.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+//
+// Clients each seeing a part of a big world, what interest management saves on the wire and what it costs
+//
+
+inline constexpr uint32_t WORLD_SIZE = 8192;
+inline constexpr uint32_t CELL_SIZE = 128;
+inline constexpr uint32_t ENTITY_COUNT = 10'000;
+inline constexpr uint32_t CLIENT_COUNT = 256;
+inline constexpr float VIEW_SIZE = 1024;
+
+int main()
+{
+    std::mt19937 rng(1337);
+    std::uniform_real_distribution<float> position(0, WORLD_SIZE - 1);
+    std::uniform_real_distribution<float> step(-4, 4);
+
+    // IDs start at 1 and the grid's are below its max
+    InterestManager::SpatialGrid grid(WORLD_SIZE, CELL_SIZE, ENTITY_COUNT + 1);
+    std::vector<Vec2F> positions(ENTITY_COUNT + 1);
+    for (uint32_t id = 1; id <= ENTITY_COUNT; id++) {
+        positions[id] = {position(rng), position(rng)};
+        grid.insertEntity(id, positions[id], positions[id]);
+    }
+
+    InterestManager interest(CLIENT_COUNT);
+    for (uint32_t client = 1; client <= CLIENT_COUNT; client++) {
+        Vec2F center = positions[client];
+        interest.setView(client, center - (VIEW_SIZE / 2), center + (VIEW_SIZE / 2));
+    }
+
+    // every entity moving a bit, so the sets change between updates
+    auto moveEntities = [&] {
+        for (uint32_t id = 1; id <= ENTITY_COUNT; id++) {
+            Vec2F& pos = positions[id];
+            pos.x = std::clamp(pos.x + step(rng), 0.F, (float)WORLD_SIZE - 1);
+            pos.y = std::clamp(pos.y + step(rng), 0.F, (float)WORLD_SIZE - 1);
+            grid.insertEntity(id, pos, pos);
+        }
+    };
+
+    std::vector<Bench::Result> results;
+
+    // the entities move between rounds, not inside them
+    results.push_back(Bench::Run("Update serial", CLIENT_COUNT, [&] {
+        interest.update(grid);
+        return interest.visible(1).size();
+    }));
+
+    ThreadPool pool(std::max(1U, std::thread::hardware_concurrency()) - 1);
+    results.push_back(Bench::Run(std::format("Update {} threads", pool.workerCount() + 1), CLIENT_COUNT, [&] {
+        interest.update(grid, &pool);
+        return interest.visible(1).size();
+    }));
+
+    // bytes per client per tick, everything vs what's in view, both as deltas against the last tick
+    auto fill = [&](Snapshot& snapshot, uint32_t tick) {
+        snapshot.clear(tick);
+        for (uint32_t id = 1; id <= ENTITY_COUNT; id++) {
+            snapshot.add(id, std::array{(uint32_t)positions[id].x, (uint32_t)positions[id].y});
+        }
+    };
+
+    Snapshot world(2);
+    std::vector<uint8_t> buff(1 << 20);
+    SnapshotEncoder everything({13, 13}, 4);
+    std::vector<std::unique_ptr<SnapshotEncoder>> filtered;
+    for (uint32_t client = 0; client <= CLIENT_COUNT; client++) {
+        filtered.push_back(std::make_unique<SnapshotEncoder>(std::vector<uint8_t>{13, 13}, 4));
+    }
+
+    size_t everythingBytes = 0;
+    size_t filteredBytes = 0;
+    size_t visible = 0;
+    for (uint32_t tick = 1; tick <= 2; tick++) {
+        moveEntities();
+        interest.update(grid);
+        fill(world, tick);
+        fill(everything.next(tick), tick);
+
+        BitStream stream(buff.data(), buff.size());
+        everything.write(stream, tick - 1);
+        everythingBytes = stream.byteIndex();
+
+        filteredBytes = 0;
+        visible = 0;
+        for (uint32_t client = 1; client <= CLIENT_COUNT; client++) {
+            interest.filter(client, world, filtered[client]->next(tick));
+            BitStream clientStream(buff.data(), buff.size());
+            filtered[client]->write(clientStream, tick - 1);
+            filteredBytes += clientStream.byteIndex();
+            visible += interest.visible(client).size();
+        }
+    }
+
+    results.push_back(Bench::Run("Filter snapshots", CLIENT_COUNT, [&] {
+        size_t sum = 0;
+        for (uint32_t client = 1; client <= CLIENT_COUNT; client++) {
+            Snapshot& out = filtered[client]->next(3);
+            interest.filter(client, world, out);
+            sum += out.size();
+        }
+        return sum;
+    }));
+
+    // per client
+    Bench::Print(results);
+
+    std::cout << std::format(
+        "{} entities, {} visible per client: {} bytes per client without interest, {} with\n",
+        ENTITY_COUNT,
+        visible / CLIENT_COUNT,
+        everythingBytes,
+        filteredBytes / CLIENT_COUNT
+    );
+}
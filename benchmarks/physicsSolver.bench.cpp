@@ -0,0 +1,76 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "bench.h"
+
+#include "fc/core/collision/shape.h"
+#include "fc/core/physics/physicsWorld.h"
+
+#include <algorithm>
+#include <format>
+#include <memory>
+#include <thread>
+#include <vector>
+
+//
+// Steps a dense pile of bodies that never goes to sleep with different solver thread counts
+//
+
+inline constexpr int PILE_WIDTH = 60;
+inline constexpr int PILE_HEIGHT = 40;
+inline constexpr size_t STEPS_PER_ROUND = 10;
+
+static std::unique_ptr<PhysicsWorld> createPile(uint32_t threads)
+{
+    PhysicsWorld::Config config;
+    config.worldSize = 2048;
+    config.maxBodies = 4096;
+    config.gravity = {0, 100};
+    config.solverThreads = threads;
+    config.timeToSleep = 1e9F;
+
+    auto world = std::make_unique<PhysicsWorld>(config);
+
+    world->addBody(std::make_unique<Rect>(Vec2F{0, 2000}, Vec2F{2048, 2048}), {.mass = 0});
+
+    for (int y = 0; y < PILE_HEIGHT; y++) {
+        for (int x = 0; x < PILE_WIDTH; x++) {
+            Vec2F pos{100.F + (x * 21.F) + (y % 2 * 5.F), 1990.F - (y * 21.F)};
+            if ((x + y) % 2 == 0) {
+                world->addBody(std::make_unique<Circle>(pos, 10), {});
+            } else {
+                world->addBody(std::make_unique<Polygon>(Polygon::fromSides(6, pos, 10)), {});
+            }
+        }
+    }
+
+    // let the pile settle so every round has about the same amount of contacts
+    for (int i = 0; i < 60; i++) {
+        world->step(1.F / 60.F);
+    }
+
+    return world;
+}
+
+int main()
+{
+    std::vector<Bench::Result> results;
+
+    uint32_t maxThreads = std::max(1U, std::thread::hardware_concurrency());
+
+    for (uint32_t threads = 0; threads < maxThreads; threads = threads == 0 ? 1 : threads * 2) {
+        auto world = createPile(threads);
+
+        results.push_back(Bench::Run(std::format("PhysicsWorld::step {} solver threads", threads), STEPS_PER_ROUND, [&] {
+            for (size_t i = 0; i < STEPS_PER_ROUND; i++) {
+                world->step(1.F / 60.F);
+            }
+            return world->awakeCount();
+        }));
+    }
+
+    Bench::Print(results);
+}
@@ -0,0 +1,102 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "bench.h"
+
+#include "fc/core/bitStream.h"
+#include "fc/core/math/vec2.h"
+#include "fc/core/net/priorityAccumulator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <random>
+#include <string>
+#include <vector>
+
+//
+// A client seeing more entities than fit in its packets, filling a 1200 byte packet every tick
+//
+
+inline constexpr uint32_t ENTITY_COUNT = 2000;
+inline constexpr size_t PACKET_BITS = 1200 * 8;
+inline constexpr size_t TICKS = 300;
+
+int main()
+{
+    std::mt19937 rng(1337);
+    std::uniform_real_distribution<float> position(0, 2048);
+    std::uniform_real_distribution<float> relevance(0.5F, 2);
+
+    std::vector<Vec2F> positions(ENTITY_COUNT + 1);
+    std::vector<float> relevances(ENTITY_COUNT + 1);
+    for (uint32_t id = 1; id <= ENTITY_COUNT; id++) {
+        positions[id] = {position(rng), position(rng)};
+        relevances[id] = relevance(rng);
+    }
+    Vec2F player(1024, 1024);
+
+    PriorityAccumulator accumulator(ENTITY_COUNT);
+    // room for an entity past the budget, it's written before it's known not to fit
+    std::vector<uint8_t> buff((PACKET_BITS / 8) + 16);
+
+    // x and y quantized to 12 bits and a 16 bit state
+    auto writeEntity = [&](BitStream& stream, uint32_t id) {
+        stream.writeBits<uint32_t>((uint32_t)positions[id].x, 12);
+        stream.writeBits<uint32_t>((uint32_t)positions[id].y, 12);
+        stream.writeUint16(id);
+    };
+
+    auto tick = [&] {
+        for (uint32_t id = 1; id <= ENTITY_COUNT; id++) {
+            float distance = positions[id].distanceTo(player);
+            accumulator.accumulate(id, PriorityAccumulator::byDistance(relevances[id], distance, 256));
+        }
+
+        BitStream stream(buff.data(), buff.size());
+        return accumulator.write(stream, PACKET_BITS, writeEntity);
+    };
+
+    std::vector<Bench::Result> results;
+    results.push_back(Bench::Run("Accumulate and write a packet", 1, tick));
+    // per tick
+    Bench::Print(results);
+
+    // how long entities wait by distance, close ones should be sent far more often
+    std::vector<uint32_t> lastSent(ENTITY_COUNT + 1, 0);
+    std::vector<double> waitSums(4, 0);
+    std::vector<size_t> waitCounts(4, 0);
+    for (uint32_t t = 1; t <= TICKS; t++) {
+        for (uint32_t id = 1; id <= ENTITY_COUNT; id++) {
+            float distance = positions[id].distanceTo(player);
+            accumulator.accumulate(id, PriorityAccumulator::byDistance(relevances[id], distance, 256));
+        }
+
+        BitStream stream(buff.data(), buff.size());
+        accumulator.write(stream, PACKET_BITS, writeEntity);
+
+        stream.setBitIndex(0);
+        PriorityAccumulator::read(stream, accumulator.idBits(), [&](BitStream& in, uint32_t id) {
+            (void)in.readBits<uint32_t>(12);
+            (void)in.readBits<uint32_t>(12);
+            (void)in.readUint16();
+
+            size_t band = std::min<size_t>(positions[id].distanceTo(player) / 256, 3);
+            waitSums[band] += t - lastSent[id];
+            waitCounts[band]++;
+            lastSent[id] = t;
+        });
+    }
+
+    for (size_t band = 0; band < 4; band++) {
+        std::cout << std::format(
+            "{} to {} away: sent every {:.1f} ticks\n",
+            band * 256,
+            band == 3 ? std::string("more") : std::to_string((band + 1) * 256),
+            waitSums[band] / (double)std::max<size_t>(waitCounts[band], 1)
+        );
+    }
+}
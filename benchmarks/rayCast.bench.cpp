@@ -0,0 +1,100 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "bench.h"
+
+#include "fc/core/collision/collision.h"
+
+#include <random>
+#include <vector>
+
+//
+// Compares casting rays against shapes one by one and with the batched versions,
+// like refining the candidates of a grid line query
+//
+
+inline constexpr size_t SHAPE_COUNT = 256;
+inline constexpr size_t RAY_COUNT = 256;
+
+int main()
+{
+    std::mt19937 rng(1337);
+    std::uniform_real_distribution<float> posDist(0, 500);
+    std::uniform_real_distribution<float> sizeDist(2, 10);
+
+    std::vector<float> posX, posY, rads;
+    std::vector<float> minX, minY, maxX, maxY;
+    for (size_t i = 0; i < SHAPE_COUNT; i++) {
+        posX.push_back(posDist(rng));
+        posY.push_back(posDist(rng));
+        rads.push_back(sizeDist(rng));
+
+        minX.push_back(posX.back() - sizeDist(rng));
+        minY.push_back(posY.back() - sizeDist(rng));
+        maxX.push_back(posX.back() + sizeDist(rng));
+        maxY.push_back(posY.back() + sizeDist(rng));
+    }
+
+    std::vector<Vec2F> rayStarts, rayDeltas;
+    for (size_t i = 0; i < RAY_COUNT; i++) {
+        rayStarts.push_back({posDist(rng), posDist(rng)});
+        rayDeltas.push_back(Vec2F{posDist(rng), posDist(rng)} - rayStarts.back());
+    }
+
+    std::vector<float> fractions(SHAPE_COUNT);
+
+    // counts the hits so the results are used
+    auto countHits = [&] {
+        size_t hits = 0;
+        for (float fraction : fractions) {
+            hits += fraction != Collision::RAY_MISS ? 1 : 0;
+        }
+        return hits;
+    };
+
+    std::vector<Bench::Result> results;
+    constexpr size_t OPS = SHAPE_COUNT * RAY_COUNT;
+
+    results.push_back(Bench::Run("RayCircle", OPS, [&] {
+        size_t hits = 0;
+        for (size_t r = 0; r < RAY_COUNT; r++) {
+            for (size_t i = 0; i < SHAPE_COUNT; i++) {
+                hits += Collision::RayCircle(rayStarts[r], rayDeltas[r], {posX[i], posY[i]}, rads[i], nullptr) ? 1 : 0;
+            }
+        }
+        return hits;
+    }));
+
+    results.push_back(Bench::Run("RayCircles", OPS, [&] {
+        size_t hits = 0;
+        for (size_t r = 0; r < RAY_COUNT; r++) {
+            Collision::RayCircles(rayStarts[r], rayDeltas[r], posX, posY, rads, fractions);
+            hits += countHits();
+        }
+        return hits;
+    }));
+
+    results.push_back(Bench::Run("RayRect", OPS, [&] {
+        size_t hits = 0;
+        for (size_t r = 0; r < RAY_COUNT; r++) {
+            for (size_t i = 0; i < SHAPE_COUNT; i++) {
+                hits += Collision::RayRect(rayStarts[r], rayDeltas[r], {minX[i], minY[i]}, {maxX[i], maxY[i]}, nullptr) ? 1 : 0;
+            }
+        }
+        return hits;
+    }));
+
+    results.push_back(Bench::Run("RayRects", OPS, [&] {
+        size_t hits = 0;
+        for (size_t r = 0; r < RAY_COUNT; r++) {
+            Collision::RayRects(rayStarts[r], rayDeltas[r], minX, minY, maxX, maxY, fractions);
+            hits += countHits();
+        }
+        return hits;
+    }));
+
+    Bench::Print(results);
+}
@@ -0,0 +1,127 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "bench.h"
+
+#include "fc/core/collision/collision.h"
+#include "fc/core/collision/shape.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+//
+// Compares the separating axis test with and without a SatCache
+// for pairs of shapes that orbit each other slowly, close enough to collide sometimes
+//
+
+inline constexpr size_t PAIR_COUNT = 512;
+inline constexpr size_t FRAME_COUNT = 64;
+inline constexpr size_t POLY_SIDES = 8;
+
+struct Frame
+{
+    std::vector<Polygon> polysA;
+    std::vector<Polygon> polysB;
+    std::vector<Rect> rects;
+};
+
+static std::vector<Frame> generateFrames()
+{
+    std::mt19937 rng(1337);
+    std::uniform_real_distribution<float> distDist(1.9F, 3.F);
+    std::uniform_real_distribution<float> angleDist(0, M_PI * 2);
+
+    std::vector<float> dists(PAIR_COUNT);
+    std::vector<float> angles(PAIR_COUNT);
+    for (size_t i = 0; i < PAIR_COUNT; i++) {
+        dists[i] = distDist(rng);
+        angles[i] = angleDist(rng);
+    }
+
+    std::vector<Frame> frames(FRAME_COUNT);
+
+    for (size_t f = 0; f < FRAME_COUNT; f++) {
+        Frame& frame = frames[f];
+
+        for (size_t i = 0; i < PAIR_COUNT; i++) {
+            Vec2F base{(float)(i % 32) * 10, (float)(i / 32) * 10};
+
+            float angle = angles[i] + (f * 0.01F);
+            Vec2F offset{std::cos(angle) * dists[i], std::sin(angle) * dists[i]};
+
+            frame.polysA.push_back(Polygon::fromSides(POLY_SIDES, base, 1));
+
+            Polygon polyB = Polygon::fromSides(POLY_SIDES, base + offset, 1);
+            polyB.rotate(f * 0.005F);
+            frame.polysB.push_back(polyB);
+
+            frame.rects.push_back(Rect::fromDims(1.6F, 1.6F, base));
+        }
+    }
+
+    return frames;
+}
+
+int main()
+{
+    const std::vector<Frame> frames = generateFrames();
+    const size_t ops = PAIR_COUNT * FRAME_COUNT;
+
+    std::vector<Bench::Result> results;
+
+    results.push_back(Bench::Run("PolygonPolygon", ops, [&]() {
+        size_t hits = 0;
+        for (const auto& frame : frames) {
+            for (size_t i = 0; i < PAIR_COUNT; i++) {
+                const Polygon& a = frame.polysA[i];
+                const Polygon& b = frame.polysB[i];
+                hits += Collision::PolygonPolygon(a.points, a.normals(), a.center(), a.radius(), b.points, b.normals(), b.center(), b.radius(), nullptr);
+            }
+        }
+        return hits;
+    }));
+
+    results.push_back(Bench::Run("PolygonPolygon + SatCache", ops, [&]() {
+        std::vector<Collision::SatCache> caches(PAIR_COUNT);
+        size_t hits = 0;
+        for (const auto& frame : frames) {
+            for (size_t i = 0; i < PAIR_COUNT; i++) {
+                const Polygon& a = frame.polysA[i];
+                const Polygon& b = frame.polysB[i];
+                hits += Collision::PolygonPolygon(a.points, a.normals(), a.center(), a.radius(), b.points, b.normals(), b.center(), b.radius(), nullptr, &caches[i]);
+            }
+        }
+        return hits;
+    }));
+
+    results.push_back(Bench::Run("RectPolygon", ops, [&]() {
+        size_t hits = 0;
+        for (const auto& frame : frames) {
+            for (size_t i = 0; i < PAIR_COUNT; i++) {
+                const Rect& a = frame.rects[i];
+                const Polygon& b = frame.polysB[i];
+                hits += Collision::RectPolygon(a.min, a.max, b.points, b.normals(), b.center(), b.radius(), nullptr);
+            }
+        }
+        return hits;
+    }));
+
+    results.push_back(Bench::Run("RectPolygon + SatCache", ops, [&]() {
+        std::vector<Collision::SatCache> caches(PAIR_COUNT);
+        size_t hits = 0;
+        for (const auto& frame : frames) {
+            for (size_t i = 0; i < PAIR_COUNT; i++) {
+                const Rect& a = frame.rects[i];
+                const Polygon& b = frame.polysB[i];
+                hits += Collision::RectPolygon(a.min, a.max, b.points, b.normals(), b.center(), b.radius(), nullptr, &caches[i]);
+            }
+        }
+        return hits;
+    }));
+
+    Bench::Print(results);
+}
@@ -0,0 +1,87 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "bench.h"
+
+#include "fc/core/bitStream.h"
+#include "fc/core/net/snapshot.h"
+
+#include <cstdint>
+#include <format>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+//
+// Snapshots of a mostly static world, a few entities move each tick
+//
+
+inline constexpr size_t ENTITY_COUNT = 4096;
+inline constexpr size_t FIELD_COUNT = 5;
+
+int main()
+{
+    // x, y, type, animation frame, health
+    const std::vector<uint8_t> fieldBits = {20, 20, 5, 6, 7};
+
+    std::mt19937 rng(1337);
+    std::vector<uint32_t> state(ENTITY_COUNT * FIELD_COUNT);
+    for (size_t i = 0; i < state.size(); i++) {
+        state[i] = rng() & ((1u << fieldBits[i % FIELD_COUNT]) - 1);
+    }
+
+    SnapshotEncoder encoder(fieldBits, 32);
+    std::vector<uint8_t> buff(ENTITY_COUNT * 16);
+
+    auto fillSnapshot = [&](uint32_t tick) {
+        Snapshot& snapshot = encoder.next(tick);
+        for (size_t i = 0; i < ENTITY_COUNT; i++) {
+            snapshot.add(i, std::span(state).subspan(i * FIELD_COUNT, FIELD_COUNT));
+        }
+    };
+
+    std::vector<Bench::Result> results;
+    std::vector<std::string> sizes;
+
+    for (uint32_t movingPercent : {1, 5, 25}) {
+        // the baseline and the tick after it
+        fillSnapshot(movingPercent * 2);
+        for (size_t i = 0; i < ENTITY_COUNT; i++) {
+            if (rng() % 100 < movingPercent) {
+                state[i * FIELD_COUNT] += 1;
+                state[(i * FIELD_COUNT) + 1] += 1;
+            }
+        }
+        fillSnapshot((movingPercent * 2) + 1);
+
+        size_t fullBits = 0;
+        size_t deltaBits = 0;
+
+        results.push_back(Bench::Run(std::format("Full snapshot, {}% moving", movingPercent), ENTITY_COUNT, [&] {
+            BitStream stream(buff.data(), buff.size());
+            encoder.write(stream, SnapshotEncoder::NO_BASELINE);
+            fullBits = stream.bitIndex();
+            return fullBits;
+        }));
+
+        results.push_back(Bench::Run(std::format("Delta snapshot, {}% moving", movingPercent), ENTITY_COUNT, [&] {
+            BitStream stream(buff.data(), buff.size());
+            encoder.write(stream, movingPercent * 2);
+            deltaBits = stream.bitIndex();
+            return deltaBits;
+        }));
+
+        sizes.push_back(
+            std::format("{}% moving: {} bytes full, {} bytes delta", movingPercent, fullBits / 8, deltaBits / 8)
+        );
+    }
+
+    Bench::Print(results);
+    for (const std::string& size : sizes) {
+        std::cout << size << "\n";
+    }
+}
@@ -2,6 +2,11 @@
 # SPDX-FileCopyrightText: 2026 firecat2d developers
 
 function(findLibuv)
+    # already fetched, fc_core and uSockets on windows both need it
+    if (TARGET libuv)
+        return()
+    endif()
+
     FetchContent_Declare(
         libuv
         GIT_REPOSITORY https://github.com/libuv/libuv
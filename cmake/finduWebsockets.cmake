@@ -28,6 +28,12 @@ function(finduWebsockets)
 
     target_include_directories(uSockets PUBLIC ${usockets_SOURCE_DIR}/src)
     target_compile_definitions(uSockets PRIVATE LIBUS_NO_SSL)
+    # epoll and kqueue are used on linux and macos, windows needs libuv
+    if (WIN32)
+        findLibuv()
+        target_compile_definitions(uSockets PUBLIC LIBUS_USE_LIBUV)
+        target_link_libraries(uSockets PUBLIC libuv)
+    endif()
 
     FetchContent_Declare(
         uWebSockets
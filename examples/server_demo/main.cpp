@@ -0,0 +1,226 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/math/vec2.h"
+#include "fc/core/net/interestManager.h"
+#include "fc/core/net/snapshot.h"
+#include "fc/server/gameServer.h"
+#include "fc/server/serverCluster.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <numbers>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+inline constexpr uint32_t WORLD_SIZE = 4096;
+inline constexpr uint32_t CELL_SIZE = 64;
+inline constexpr uint32_t BOT_COUNT = 2000;
+inline constexpr float BOT_SPEED = 80;
+inline constexpr float BOT_RADIUS = 16;
+inline constexpr float VIEW_SIZE = 1024;
+
+/**
+ * Bots wandering around and steering away from each other.
+ * Each client follows a bot and gets delta snapshots of the bots around it.
+ * Clients send back the u32 tick of each snapshot they received, it's used as their next baseline.
+ *
+ * Each worker of the cluster runs one of these as its room
+ */
+class DemoServer : public GameServer
+{
+public:
+    explicit DemoServer(size_t worker) :
+        GameServer({.tickRate = 30}),
+        m_worker(worker),
+        m_grid(WORLD_SIZE, CELL_SIZE, BOT_COUNT + 1),
+        m_interest(config().maxClients),
+        m_bots(BOT_COUNT + 1),
+        m_encoders(config().maxClients + 1),
+        m_ackedTicks(config().maxClients + 1, SnapshotEncoder::NO_BASELINE)
+    {
+        std::uniform_real_distribution<float> position(0, WORLD_SIZE - 1);
+        std::uniform_real_distribution<float> heading(-std::numbers::pi_v<float>, std::numbers::pi_v<float>);
+
+        // IDs start at 1 like the grid's
+        for (uint32_t id = 1; id <= BOT_COUNT; id++) {
+            Bot& bot = m_bots[id];
+            bot.position = {position(m_rng), position(m_rng)};
+            bot.heading = heading(m_rng);
+            m_grid.insertEntity(id, bot.position - BOT_RADIUS, bot.position + BOT_RADIUS);
+        }
+    }
+
+protected:
+    void onConnect(ClientID client) override
+    {
+        // x, y, heading
+        m_encoders[client] = std::make_unique<SnapshotEncoder>(std::vector<uint8_t>{12, 12, 6}, 32);
+        m_ackedTicks[client] = SnapshotEncoder::NO_BASELINE;
+        std::cout << std::format("worker {}: client {} connected\n", m_worker, client);
+    }
+
+    void onMessage(ClientID client, BitStream& message) override
+    {
+        m_ackedTicks[client] = message.readUint32();
+    }
+
+    void onDisconnect(ClientID client) override
+    {
+        m_interest.removeClient(client);
+        m_encoders[client].reset();
+        std::cout << std::format("worker {}: client {} disconnected\n", m_worker, client);
+    }
+
+    void onTick(uint32_t tick, float dt) override
+    {
+        simulate(dt);
+
+        m_world.clear(tick);
+        for (uint32_t id = 1; id <= BOT_COUNT; id++) {
+            const Bot& bot = m_bots[id];
+            float turn = bot.heading / (2 * std::numbers::pi_v<float>) + 0.5F;
+            m_world.add(
+                id,
+                std::array{
+                    (uint32_t)bot.position.x,
+                    (uint32_t)bot.position.y,
+                    (uint32_t)(turn * 63),
+                }
+            );
+        }
+
+        for (ClientID client = 1; client < m_encoders.size(); client++) {
+            if (m_encoders[client] != nullptr) {
+                Vec2F center = m_bots[((client - 1) % BOT_COUNT) + 1].position;
+                m_interest.setView(client, center - (VIEW_SIZE / 2), center + (VIEW_SIZE / 2));
+            }
+        }
+        m_interest.update(m_grid);
+
+        for (ClientID client = 1; client < m_encoders.size(); client++) {
+            if (m_encoders[client] == nullptr) {
+                continue;
+            }
+
+            SnapshotEncoder& encoder = *m_encoders[client];
+            m_interest.filter(client, m_world, encoder.next(tick));
+
+            BitStream stream(bufferPool(), 1024);
+            encoder.write(stream, m_ackedTicks[client]);
+            send(client, stream);
+        }
+
+        // every 5 seconds
+        if (tick % (config().tickRate * 5) == 0 && tick > 0) {
+            printStats();
+        }
+    }
+
+private:
+    struct Bot
+    {
+        Vec2F position;
+        float heading = 0;
+    };
+
+    size_t m_worker;
+    InterestManager::SpatialGrid m_grid;
+    InterestManager m_interest;
+    std::vector<Bot> m_bots;
+
+    /**
+     * Every bot, filtered per client
+     */
+    Snapshot m_world{3};
+
+    /**
+     * By client ID, each client has its own encoder since it sees its own entities
+     */
+    std::vector<std::unique_ptr<SnapshotEncoder>> m_encoders;
+    std::vector<uint32_t> m_ackedTicks;
+    std::mt19937 m_rng{1337};
+
+    void simulate(float dt)
+    {
+        std::uniform_real_distribution<float> wander(-0.3F, 0.3F);
+
+        for (uint32_t id = 1; id <= BOT_COUNT; id++) {
+            Bot& bot = m_bots[id];
+
+            // turn away from the bots sharing its cells, otherwise wander
+            Vec2F away;
+            for (uint32_t other : m_grid.queryEntity(id)) {
+                if (other != id) {
+                    away += bot.position - m_bots[other].position;
+                }
+            }
+
+            if (away.x != 0 || away.y != 0) {
+                bot.heading = std::atan2(away.y, away.x);
+            } else {
+                bot.heading += wander(m_rng);
+            }
+
+            Vec2F velocity(std::cos(bot.heading), std::sin(bot.heading));
+            bot.position += velocity * BOT_SPEED * dt;
+
+            // bounce off the edges
+            float max = WORLD_SIZE - 1;
+            if (bot.position.x < 0 || bot.position.x > max || bot.position.y < 0 || bot.position.y > max) {
+                bot.position.x = std::clamp(bot.position.x, 0.F, max);
+                bot.position.y = std::clamp(bot.position.y, 0.F, max);
+                bot.heading += std::numbers::pi_v<float>;
+            }
+            bot.heading = std::remainder(bot.heading, 2 * std::numbers::pi_v<float>);
+
+            m_grid.insertEntity(id, bot.position - BOT_RADIUS, bot.position + BOT_RADIUS);
+        }
+    }
+
+    void printStats()
+    {
+        const Stats& stats = this->stats();
+        std::cout << std::format(
+            "worker {} tick {}: {} clients, {:.3f} ms per tick, {} messages ({} KiB) sent, {} dropped\n",
+            m_worker,
+            currentTick(),
+            clientCount(),
+            stats.tickSeconds * 1000 / (double)stats.ticks,
+            stats.messagesSent,
+            stats.bytesSent / 1024,
+            stats.messagesDropped
+        );
+    }
+};
+
+/**
+ * Usage: server_demo [worker count], one worker per core by default
+ */
+int main(int argc, char** argv)
+{
+    size_t workers = std::max(1U, std::thread::hardware_concurrency());
+    if (argc > 1) {
+        workers = std::stoul(argv[1]);
+    }
+
+    ServerCluster cluster(9001, workers, [](size_t worker) {
+        return std::make_unique<DemoServer>(worker);
+    });
+    std::cout << std::format("listening on port 9001 with {} workers\n", workers);
+
+    if (!cluster.run()) {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -13,12 +13,17 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <format>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <type_traits>
+#include <vector>
 
 #include "fc/core/buffer.h"
+#include "fc/core/bufferPool.h"
+#include "fc/core/math/vec2.h"
 
 class BitStream
 {
@@ -26,6 +31,26 @@ public:
     BitStream(uint8_t* data, size_t size) : m_buff(data, size) { };
     BitStream(const Uint8Buffer& buff) : m_buff(buff) { };
 
+    /**
+     * Growable writer, instead of throwing when a write doesn't fit it moves to a bigger buffer from the pool.
+     * Use takeBytes to get the written bytes once done.
+     *
+     * @param initialSize Bytes to acquire right away, e.g the usual size of what's written
+     */
+    explicit BitStream(BufferPool& pool, size_t initialSize = 0);
+
+    BitStream(const BitStream& other);
+    BitStream(BitStream&& other) noexcept;
+
+    BitStream& operator=(BitStream other);
+
+    ~BitStream();
+
+    [[nodiscard]] const uint8_t* data() const
+    {
+        return m_buff.data();
+    }
+
     [[nodiscard]] size_t byteSize() const
     {
         return m_buff.size();
@@ -46,6 +71,20 @@ public:
         return m_bitIndex;
     }
 
+    [[nodiscard]] bool isGrowable() const
+    {
+        return m_pool != nullptr;
+    }
+
+    /**
+     * Moves the bytes written so far out of a growable stream without copying them,
+     * the stream is then empty and can be written to again.
+     * Give the buffer back to the pool once it's not needed anymore.
+     *
+     * @return The buffer sized to byteIndex()
+     */
+    [[nodiscard]] std::vector<uint8_t> takeBytes();
+
     void setBitIndex(size_t index)
     {
         if (index > bitSize()) {
@@ -112,10 +151,43 @@ public:
         return std::bit_cast<double>(readUint64());
     }
 
+    /**
+     * `value` quantized to `bitCount` bits in [min, max], the round trip error is at most `(max - min) / (2^bitCount - 1) / 2`
+     *
+     * @throws std::out_of_range if `value` isn't in [min, max]
+     */
     void writeFloat(float value, float min, float max, uint8_t bitCount);
 
     float readFloat(float min, float max, uint8_t bitCount);
 
+    /**
+     * Each axis quantized like writeFloat, e.g positions in a 4096 wide world with 16 bits each are 1/16 precise
+     *
+     * @throws std::out_of_range if `value` isn't in the [min, max] box
+     */
+    void writeVec2(Vec2F value, Vec2F min, Vec2F max, uint8_t bitCount);
+
+    [[nodiscard]] Vec2F readVec2(Vec2F min, Vec2F max, uint8_t bitCount);
+
+    /**
+     * Angle in radians, any value is wrapped to a turn so it can't be out of range.
+     * The round trip error is at most `pi / 2^bitCount`
+     */
+    void writeAngle(float radians, uint8_t bitCount);
+
+    /**
+     * @return The angle in [-pi, pi)
+     */
+    [[nodiscard]] float readAngle(uint8_t bitCount);
+
+    /**
+     * Direction of a normalized vector written as its angle, uniformly precise in every direction.
+     * The read vector is normalized and at most `pi / 2^bitCount` away from the written one
+     */
+    void writeUnitVec2(Vec2F normal, uint8_t bitCount);
+
+    [[nodiscard]] Vec2F readUnitVec2(uint8_t bitCount);
+
     void writeBool(bool value)
     {
         writeBits<uint8_t>(value ? 1 : 0, 1);
@@ -130,132 +202,418 @@ public:
 
     [[nodiscard]] std::string readString(size_t maxSize = 0);
 
+    /**
+     * Same format as readString but without copying, the view points into the stream's buffer.
+     * Only valid while the buffer is, growable streams move to a new buffer when they grow.
+     *
+     * @throws std::logic_error if the bit index isn't byte aligned
+     * @throws std::out_of_range if the string runs past the end of the buffer
+     */
+    [[nodiscard]] std::string_view readStringView(size_t maxSize = 0);
+
+    /**
+     * Raw bytes, a single copy when the bit index is byte aligned, shifted 8 bytes at a time otherwise
+     */
+    void writeBytes(const uint8_t* data, size_t size);
+
+    /**
+     * @throws std::out_of_range if there's less than `size` bytes left
+     */
+    void readBytes(uint8_t* data, size_t size);
+
+    //
+    // Variable length integers, small values take less bits.
+    // Signed versions are zigzag encoded first so small negative values are small too.
+    //
+
+    /**
+     * LEB128, 7 bits of the value then a continuation bit, so 8 bits up to 127, 16 bits up to 16383, etc
+     */
+    void writeVarUint(uint64_t value);
+    void writeVarInt(int64_t value);
+
+    /**
+     * @throws std::out_of_range if the value doesn't fit in 64 bits
+     */
+    [[nodiscard]] uint64_t readVarUint();
+    [[nodiscard]] int64_t readVarInt();
+
+    /**
+     * Exp-Golomb code of order `k`, bit granular: `2 * floor(log2(value + 2^k)) + 1 - k` bits,
+     * 1 bit for 0 with `k == 0`, 3 bits up to 2, 5 bits up to 6, etc.
+     * A bigger `k` costs more bits for tiny values and less for larger ones.
+     *
+     * @note `value` has to be at most `UINT64_MAX - 2^k`
+     */
+    void writeExpGolomb(uint64_t value, uint8_t k = 0);
+    void writeExpGolombInt(int64_t value, uint8_t k = 0);
+
+    /**
+     * @throws std::out_of_range if the value doesn't fit in 64 bits
+     */
+    [[nodiscard]] uint64_t readExpGolomb(uint8_t k = 0);
+    [[nodiscard]] int64_t readExpGolombInt(uint8_t k = 0);
+
+    /**
+     * Maps 0, -1, 1, -2, 2, ... to 0, 1, 2, 3, 4, ...
+     */
+    [[nodiscard]] static constexpr uint64_t zigzagEncode(int64_t value)
+    {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    [[nodiscard]] static constexpr int64_t zigzagDecode(uint64_t value)
+    {
+        return static_cast<int64_t>((value >> 1) ^ (0 - (value & 1)));
+    }
+
+    /**
+     * Makes sure `bitCount` more bits can be written from the current index, growable streams grow if needed
+     *
+     * @throws std::out_of_range if a fixed stream doesn't have enough space left
+     */
+    void reserveBits(size_t bitCount);
+
+    /**
+     * Next `bitCount` bits without moving the index, bits past the end of the buffer are 0.
+     * For table driven decoders that look ahead then skip what they used with setBitIndex
+     */
+    [[nodiscard]] uint64_t peekBits(uint8_t bitCount) const
+    {
+        assert(bitCount <= 56);
+
+        size_t byteOffset = m_bitIndex / 8;
+        if (byteOffset >= m_buff.size()) {
+            return 0;
+        }
+
+        return (loadWord(byteOffset) >> (m_bitIndex & 7)) & lowBitsMask(bitCount);
+    }
+
+    class UncheckedWriter;
+    class UncheckedReader;
+
 private:
     Uint8Buffer m_buff;
 
     size_t m_bitIndex = 0;
+
+    /**
+     * Only set for growable streams, m_buff then points to m_owned
+     */
+    BufferPool* m_pool = nullptr;
+    std::vector<uint8_t> m_owned;
+
+    /**
+     * Moves to a buffer of at least `minSize` bytes from the pool, keeping the current bytes
+     */
+    void grow(size_t minSize);
+
+    static void swap(BitStream& lhs, BitStream& rhs) noexcept;
+
+    /**
+     * Only checked in debug builds, callers have to check the size first
+     */
+    template<typename T>
+        requires(std::is_integral_v<T>)
+    [[nodiscard]] T readBitsUnchecked(uint8_t bitCount);
+
+    template<typename T>
+        requires(std::is_integral_v<T>)
+    void writeBitsUnchecked(T value, uint8_t bitCount);
+
+    /**
+     * Out of line so formatting the message doesn't get inlined in every read / write
+     */
+    [[noreturn]] void throwReadPastEnd(size_t bitCount) const;
+    [[noreturn]] void throwWritePastEnd(size_t bitCount) const;
+
+    [[nodiscard]] static constexpr uint64_t lowBitsMask(uint8_t bitCount)
+    {
+        return bitCount >= 64 ? ~uint64_t{0} : (uint64_t{1} << bitCount) - 1;
+    }
+
+    /**
+     * Little endian load of the 8 bytes at `byteOffset`, bytes past the end of the buffer are 0
+     */
+    [[nodiscard]] uint64_t loadWord(size_t byteOffset) const
+    {
+        // zero bit reads at the end, the buffer can even be null before a growable stream's first grow
+        if (byteOffset >= m_buff.size()) {
+            return 0;
+        }
+
+        uint64_t word = 0;
+        // constant size so it compiles to a single unaligned load
+        if (byteOffset + 8 <= m_buff.size()) {
+            std::memcpy(&word, m_buff.data() + byteOffset, 8);
+        } else {
+            std::memcpy(&word, m_buff.data() + byteOffset, m_buff.size() - byteOffset);
+        }
+
+        if constexpr (std::endian::native == std::endian::big) {
+            word = std::byteswap(word);
+        }
+        return word;
+    }
+
+    /**
+     * Stores the bytes of a word from loadWord back, bytes past the end of the buffer are dropped
+     */
+    void storeWord(size_t byteOffset, uint64_t word)
+    {
+        if (byteOffset >= m_buff.size()) {
+            return;
+        }
+
+        if constexpr (std::endian::native == std::endian::big) {
+            word = std::byteswap(word);
+        }
+
+        if (byteOffset + 8 <= m_buff.size()) {
+            std::memcpy(m_buff.data() + byteOffset, &word, 8);
+        } else {
+            std::memcpy(m_buff.data() + byteOffset, &word, m_buff.size() - byteOffset);
+        }
+    }
 };
 
-template<typename T>
-    requires(std::is_integral_v<T>)
-T BitStream::readBits(uint8_t bitCount)
+/**
+ * Writes a block of fields with a single size check, for layouts whose maximum size is known up front.
+ *
+ * Fields are gathered in a 64 bit word that's stored once full, instead of a load and a store per field.
+ * The stream's bit index is only updated when the writer is destroyed, don't use the stream until then.
+ * Writing more than the reserved bits is only caught by asserts in debug builds.
+ *
+ * @example
+ * ```
+ *   {
+ *       BitStream::UncheckedWriter writer(stream, ENTITY_BITS * entities.size());
+ *       for (const auto& entity : entities) {
+ *           writer.writeBits(entity.id, 12);
+ *           writer.writeBool(entity.alive);
+ *       }
+ *   }
+ *   send(stream);
+ * ```
+ */
+class BitStream::UncheckedWriter
 {
-    assert(bitCount <= (sizeof(T) * 8));
+public:
+    /**
+     * @throws std::out_of_range if a fixed stream doesn't have `bitCount` bits left
+     */
+    UncheckedWriter(BitStream& stream, size_t bitCount) :
+        m_stream(stream),
+        m_end(stream.bitIndex() + bitCount),
+        m_byteOffset(stream.bitIndex() / 8),
+        m_scratchBits(stream.bitIndex() & 7)
+    {
+        stream.reserveBits(bitCount);
+
+        // keep the bits before the index in the first byte
+        if (m_scratchBits > 0) {
+            m_scratch = stream.m_buff[m_byteOffset] & lowBitsMask(m_scratchBits);
+        }
+    }
+
+    UncheckedWriter(const UncheckedWriter&) = delete;
+    UncheckedWriter& operator=(const UncheckedWriter&) = delete;
+
+    ~UncheckedWriter()
+    {
+        // last partial word, keeping the bits after it
+        if (m_scratchBits > 0) {
+            uint64_t mask = lowBitsMask(m_scratchBits);
+            uint64_t word = m_stream.loadWord(m_byteOffset);
+            m_stream.storeWord(m_byteOffset, (word & ~mask) | m_scratch);
+        }
+
+        m_stream.m_bitIndex = bitIndex();
+    }
+
+    template<typename T>
+        requires(std::is_integral_v<T>)
+    void writeBits(T value, uint8_t bitCount)
+    {
+        assert(bitCount <= (sizeof(T) * 8));
+        assert(bitIndex() + bitCount <= m_end);
 
-    size_t byteIndex = this->byteIndex();
-    size_t bitIndex = this->bitIndex();
-    size_t byteCount = bitCount / 8;
+        uint64_t bits = static_cast<uint64_t>(static_cast<std::make_unsigned_t<T>>(value)) & lowBitsMask(bitCount);
+        m_scratch |= bits << m_scratchBits;
 
-    size_t newIndex = (bitIndex + bitCount);
-    if (newIndex > this->bitSize()) {
-        throw std::out_of_range(
-            std::format(
-                "readBits: trying to read past the end of the buffer, buff size: {}, buff index: {}, bits to read: {}",
-                this->bitSize(),
-                bitIndex,
-                bitCount
-            )
-        );
+        uint8_t total = m_scratchBits + bitCount;
+        if (total < 64) {
+            m_scratchBits = total;
+            return;
+        }
+
+        // full word, all of its bits are in the reserved block so it can be stored as is
+        m_stream.storeWord(m_byteOffset, m_scratch);
+        m_byteOffset += 8;
+        m_scratchBits = total - 64;
+        m_scratch = m_scratchBits > 0 ? bits >> (bitCount - m_scratchBits) : 0;
     }
 
-    T result = 0;
+    void writeBool(bool value)
+    {
+        writeBits<uint8_t>(value ? 1 : 0, 1);
+    }
 
-    size_t offset = bitIndex;
+    void writeFloat32(float value)
+    {
+        writeBits(std::bit_cast<uint32_t>(value), 32);
+    }
 
-    // Ported from bitBuffer https://github.com/inolen/bit-buffer/blob/7b6ec454866090fac7c1b2e5d67f43ffe9ad6942/bit-buffer.js
-    // licensed under MIT
-    for (size_t i = 0; i < bitCount;) {
-        uint8_t remaining = bitCount - i;
-        uint8_t bitOffset = offset & 7;
+    /**
+     * Bits left of the reserved block
+     */
+    [[nodiscard]] size_t remainingBits() const
+    {
+        return m_end - bitIndex();
+    }
 
-        // the max number of bits we can read from the current byte
-        uint8_t read = std::min<size_t>(remaining, 8 - bitOffset);
+private:
+    BitStream& m_stream;
+    size_t m_end;
 
-        // create a mask with the correct bit width
-        uint8_t mask = (1 << read) - 1;
+    /**
+     * Where m_scratch will be stored
+     */
+    size_t m_byteOffset;
+    uint64_t m_scratch = 0;
+    uint8_t m_scratchBits;
 
-        // shift the bits we want to the start of the byte and mask off the rest
-        T val = (m_buff[offset / 8] >> bitOffset) & mask;
+    [[nodiscard]] size_t bitIndex() const
+    {
+        return (m_byteOffset * 8) + m_scratchBits;
+    }
+};
 
-        result |= val << i;
+/**
+ * Reads a block of fields after a single length check, e.g once the packet's size was validated
+ */
+class BitStream::UncheckedReader
+{
+public:
+    /**
+     * @throws std::out_of_range if the stream doesn't have `bitCount` bits left
+     */
+    UncheckedReader(BitStream& stream, size_t bitCount) : m_stream(stream), m_end(stream.bitIndex() + bitCount)
+    {
+        if (m_end > stream.bitSize()) {
+            stream.throwReadPastEnd(bitCount);
+        }
+    }
 
-        offset += read;
-        i += read;
+    template<typename T>
+        requires(std::is_integral_v<T>)
+    [[nodiscard]] T readBits(uint8_t bitCount)
+    {
+        assert(m_stream.m_bitIndex + bitCount <= m_end);
+        return m_stream.readBitsUnchecked<T>(bitCount);
     }
 
-    // if working with a signed number and the bit count is not the full type size
-    // we need to add the sign bit to the first bit
-    if (
-        std::is_signed_v<T>
-        && bitCount != (sizeof(T) * 8)
-        && result & (1 << (bitCount - 1))
-    ) {
-        result |= -1 ^ ((1 << bitCount) - 1);
+    [[nodiscard]] bool readBool()
+    {
+        return readBits<uint8_t>(1) != 0;
     }
 
-    m_bitIndex = newIndex;
+    [[nodiscard]] float readFloat32()
+    {
+        return std::bit_cast<float>(readBits<uint32_t>(32));
+    }
 
-    assert(offset == newIndex);
+    [[nodiscard]] size_t remainingBits() const
+    {
+        return m_end - m_stream.m_bitIndex;
+    }
+
+private:
+    BitStream& m_stream;
+    size_t m_end;
+};
+
+template<typename T>
+    requires(std::is_integral_v<T>)
+T BitStream::readBits(uint8_t bitCount)
+{
+    if (m_bitIndex + bitCount > this->bitSize()) {
+        throwReadPastEnd(bitCount);
+    }
 
-    return result;
+    return readBitsUnchecked<T>(bitCount);
 }
 
 template<typename T>
     requires(std::is_integral_v<T>)
 void BitStream::writeBits(T value, uint8_t bitCount)
 {
-    assert(bitCount <= (sizeof(T) * 8));
+    size_t newIndex = m_bitIndex + bitCount;
+    if (newIndex > this->bitSize() && m_pool != nullptr) {
+        grow((newIndex + 7) / 8);
+    } else if (newIndex > this->bitSize()) {
+        throwWritePastEnd(bitCount);
+    }
 
-    size_t byteIndex = this->byteIndex();
-    size_t bitIndex = this->bitIndex();
-    size_t byteCount = bitCount / 8;
-
-    size_t newIndex = (bitIndex + bitCount);
-    if (newIndex > this->bitSize()) {
-        throw std::out_of_range(
-            std::format(
-                "writeBits: trying to write past the end of the buffer, buff size: {}, buff index: {}, bits to write: {}",
-                this->bitSize(),
-                bitIndex,
-                bitCount
-            )
-        );
-    }
-
-    size_t offset = bitIndex;
-
-    // Ported from bitBuffer https://github.com/inolen/bit-buffer/blob/7b6ec454866090fac7c1b2e5d67f43ffe9ad6942/bit-buffer.js
-    // licensed under MIT
-    for (size_t i = 0; i < bitCount;) {
-        uint8_t wrote = 0;
-
-        // Write an entire byte if we can.
-        if (bitCount - i >= 8 && (offset & 7) == 0) {
-            m_buff[offset / 8] = value & 0xff;
-            wrote = 8;
-        } else {
-            uint8_t remaining = bitCount - i;
-            uint8_t bitOffset = offset & 7;
-            size_t byteOffset = offset / 8;
-            wrote = std::min<uint8_t>(remaining, 8 - bitOffset);
+    writeBitsUnchecked(value, bitCount);
+}
+
+template<typename T>
+    requires(std::is_integral_v<T>)
+T BitStream::readBitsUnchecked(uint8_t bitCount)
+{
+    assert(bitCount <= (sizeof(T) * 8));
+    assert(m_bitIndex + bitCount <= this->bitSize());
 
-            // create a mask with the correct bit width
-            uint8_t mask = ~(0xff << wrote);
-            // shift the bits we want to the start of the byte and mask off the rest
-            uint8_t writeBits = value & mask;
+    size_t byteOffset = m_bitIndex / 8;
+    uint8_t bitOffset = m_bitIndex & 7;
 
-            // destination mask to zero all the bits we're changing first
-            uint8_t destMask = ~(mask << bitOffset);
+    uint64_t result = loadWord(byteOffset) >> bitOffset;
+    // a 57+ bit value that isn't byte aligned spills into a 9th byte
+    if (bitOffset + bitCount > 64) {
+        result |= (uint64_t)m_buff[byteOffset + 8] << (64 - bitOffset);
+    }
+    result &= lowBitsMask(bitCount);
 
-            m_buff[byteOffset] = (m_buff[byteOffset] & destMask) | (writeBits << bitOffset);
+    // if working with a signed number and the bit count is not the full type size
+    // we need to extend the sign bit to the upper bits
+    if constexpr (std::is_signed_v<T>) {
+        if (bitCount != 0 && bitCount != 64) {
+            uint8_t unused = 64 - bitCount;
+            result = static_cast<uint64_t>(static_cast<int64_t>(result << unused) >> unused);
         }
-
-        offset += wrote;
-        i += wrote;
-        value = value >> wrote;
     }
 
-    m_bitIndex = newIndex;
+    m_bitIndex += bitCount;
+
+    return static_cast<T>(result);
+}
+
+template<typename T>
+    requires(std::is_integral_v<T>)
+void BitStream::writeBitsUnchecked(T value, uint8_t bitCount)
+{
+    assert(bitCount <= (sizeof(T) * 8));
+    assert(m_bitIndex + bitCount <= this->bitSize());
+
+    size_t byteOffset = m_bitIndex / 8;
+    uint8_t bitOffset = m_bitIndex & 7;
+
+    uint64_t mask = lowBitsMask(bitCount);
+    // two's complement bits of signed values, same as the unsigned value of the same size
+    uint64_t bits = static_cast<uint64_t>(static_cast<std::make_unsigned_t<T>>(value)) & mask;
+
+    // zero the bits we're changing first, keeping the ones around them
+    uint64_t word = loadWord(byteOffset);
+    word = (word & ~(mask << bitOffset)) | (bits << bitOffset);
+    storeWord(byteOffset, word);
+
+    // a 57+ bit value that isn't byte aligned spills into a 9th byte
+    if (bitOffset + bitCount > 64) {
+        uint8_t spill = 64 - bitOffset;
+        m_buff[byteOffset + 8] = (m_buff[byteOffset + 8] & ~(mask >> spill)) | (bits >> spill);
+    }
 
-    assert(offset == newIndex);
+    m_bitIndex += bitCount;
 }
@@ -0,0 +1,92 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Reuses byte buffers so building packets every tick doesn't allocate once the pool is warmed up.
+ *
+ * Buffers are kept in power of 2 size classes, `acquire` gives back a released buffer of the right class if there's one.
+ *
+ * @note Not thread safe, use one pool per thread
+ *
+ * @example
+ * ```
+ *   BufferPool pool;
+ *   BitStream stream(pool);
+ *   stream.writeUint32(tick);
+ *   std::vector<uint8_t> packet = stream.takeBytes();
+ *   socket.send(packet);
+ *   pool.release(std::move(packet));
+ * ```
+ */
+class BufferPool
+{
+public:
+    static constexpr size_t MIN_SIZE = 64;
+
+    /**
+     * @return A buffer with a size of at least `minSize` bytes, its content is unspecified
+     */
+    [[nodiscard]] std::vector<uint8_t> acquire(size_t minSize)
+    {
+        size_t sizeClass = std::bit_width(std::max(minSize, MIN_SIZE) - 1);
+
+        // bigger than any class, release wouldn't keep it either
+        if (sizeClass >= m_free.size()) {
+            m_allocations++;
+            return std::vector<uint8_t>(minSize);
+        }
+
+        auto& freeList = m_free[sizeClass];
+        if (freeList.empty()) {
+            m_allocations++;
+            return std::vector<uint8_t>(size_t{1} << sizeClass);
+        }
+
+        std::vector<uint8_t> buff = std::move(freeList.back());
+        freeList.pop_back();
+        buff.resize(size_t{1} << sizeClass);
+        return buff;
+    }
+
+    /**
+     * Gives a buffer back to the pool, it doesn't have to come from `acquire`
+     */
+    void release(std::vector<uint8_t>&& buff)
+    {
+        if (buff.capacity() < MIN_SIZE) {
+            return;
+        }
+
+        // the class it can fully serve
+        size_t sizeClass = std::bit_width(buff.capacity()) - 1;
+        if (sizeClass >= m_free.size()) {
+            return;
+        }
+
+        m_free[sizeClass].push_back(std::move(buff));
+    }
+
+    /**
+     * Number of buffers allocated by `acquire` since the pool was created
+     */
+    [[nodiscard]] size_t allocations() const
+    {
+        return m_allocations;
+    }
+
+private:
+    std::array<std::vector<std::vector<uint8_t>>, 48> m_free;
+    size_t m_allocations = 0;
+};
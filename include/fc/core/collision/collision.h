@@ -6,97 +6,474 @@
 
 #pragma once
 
+#include "fc/core/math/fixed.h"
 #include "fc/core/math/vec2.h"
 
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
 #include <vector>
 
+/**
+ * Every test works with floats or with Fixed for deterministic simulations,
+ * the number type is taken from the Vec2 arguments.
+ * The Fx aliases are the fixed point versions of the result structs.
+ */
 namespace Collision
 {
 
+/**
+ * Keeps scalar and result arguments from deducing the number type,
+ * so `CircleCircle(posA, 1, posB, 1, nullptr)` works
+ */
+template<typename T>
+using NoDeduce = std::type_identity_t<T>;
+
 /**
  *  Collision response between 2 shapes.
  *
  *  To separate them you can move them by the normal multiplied by the depth
  */
-struct Response
+template<typename T>
+struct BasicResponse
 {
     /**
      * The direction to move the shapes so they separate
      */
-    Vec2F normal;
+    Vec2<T> normal;
     /**
      * How much the shapes are colliding
      */
-    float depth;
+    T depth;
 };
 
+using Response = BasicResponse<float>;
+using ResponseFx = BasicResponse<Fixed>;
+
+/**
+ *  Time of impact between 2 moving shapes.
+ *
+ *  Movement is given per step (e.g velocity * dt), so a time of 0.5 means the shapes
+ *  start touching halfway through the step.
+ */
+template<typename T>
+struct BasicTimeOfImpact
+{
+    /**
+     * Fraction of the movement, from 0 to 1, where the shapes first touch
+     * 0 if the shapes are already colliding at the start of the movement
+     */
+    T time;
+    /**
+     * The collision normal at the time of impact, pointing from the first shape to the second
+     */
+    Vec2<T> normal;
+};
+
+using TimeOfImpact = BasicTimeOfImpact<float>;
+using TimeOfImpactFx = BasicTimeOfImpact<Fixed>;
+
+/**
+ *  Contact points between 2 colliding shapes.
+ *
+ *  In 2D 2 points are enough to describe any contact between convex shapes,
+ *  edge to edge contacts have 2 points and everything else has 1.
+ */
+template<typename T>
+struct BasicManifold
+{
+    /**
+     * The direction to move the shapes so they separate, same as BasicResponse::normal
+     */
+    Vec2<T> normal;
+    /**
+     * How many entries of points and depths are valid
+     */
+    uint8_t pointCount = 0;
+    /**
+     * Contact points in world space
+     */
+    std::array<Vec2<T>, 2> points;
+    /**
+     * How much the shapes are colliding at each contact point
+     */
+    std::array<T, 2> depths;
+};
+
+using Manifold = BasicManifold<float>;
+using ManifoldFx = BasicManifold<Fixed>;
+
+/**
+ *  Where a ray first hits a shape.
+ *
+ *  Rays are segments from `rayStart` to `rayStart + rayDelta`,
+ *  use a long delta for rays that should go "forever".
+ */
+template<typename T>
+struct BasicRayHit
+{
+    /**
+     * Fraction of the ray, from 0 to 1, where it hits the shape
+     */
+    T fraction;
+    /**
+     * Surface normal at the hit point, pointing out of the shape
+     */
+    Vec2<T> normal;
+};
+
+using RayHit = BasicRayHit<float>;
+using RayHitFx = BasicRayHit<Fixed>;
+
+/**
+ * Fraction written by the batched ray casts for shapes that weren't hit
+ */
+inline constexpr float RAY_MISS = std::numeric_limits<float>::max();
+
+/**
+ *  Last axis that separated a pair of shapes in a separating axis test.
+ *
+ *  Shapes that move slowly are usually still separated by the same axis on the next check,
+ *  so testing it first lets most checks exit after a single projection.
+ *  Keep one per pair of shapes and pass it to every check of that pair (always in the same order).
+ */
+struct SatCache
+{
+    /**
+     * Which shape the cached axis belongs to, 0 for the first shape and 1 for the second
+     */
+    uint8_t shape = 0;
+    /**
+     * Index of the axis in the shape normals
+     */
+    uint32_t index = 0;
+    /**
+     * Only valid if the last check found a separating axis
+     */
+    bool valid = false;
+};
+
+template<typename T>
 bool CircleCircle(
-    Vec2F posA,
-    float radA,
+    Vec2<T> posA,
+    NoDeduce<T> radA,
 
-    Vec2F posB,
-    float radB,
+    Vec2<T> posB,
+    NoDeduce<T> radB,
 
-    Collision::Response* res
+    Collision::BasicResponse<NoDeduce<T>>* res
 );
 
+template<typename T>
 bool CircleRect(
-    Vec2F circlePos,
-    float circleRad,
+    Vec2<T> circlePos,
+    NoDeduce<T> circleRad,
 
-    Vec2F rectMin,
-    Vec2F rectMax,
+    Vec2<T> rectMin,
+    Vec2<T> rectMax,
 
-    Collision::Response* res
+    Collision::BasicResponse<NoDeduce<T>>* res
 );
 
+template<typename T>
 bool CirclePolygon(
-    Vec2F circlePos,
-    float circleRad,
+    Vec2<T> circlePos,
+    NoDeduce<T> circleRad,
 
-    const std::vector<Vec2F>& polyPoints,
-    const std::vector<Vec2F>& polyNormals,
-    Vec2F polyCenter,
+    const std::vector<Vec2<T>>& polyPoints,
+    const std::vector<Vec2<T>>& polyNormals,
+    Vec2<T> polyCenter,
+    NoDeduce<T> polyRadius,
 
-    Collision::Response* res
+    Collision::BasicResponse<NoDeduce<T>>* res
 );
 
+template<typename T>
 bool RectRect(
-    Vec2F rectAMin,
-    Vec2F rectAMax,
+    Vec2<T> rectAMin,
+    Vec2<T> rectAMax,
 
-    Vec2F rectBMin,
-    Vec2F rectBMax,
+    Vec2<T> rectBMin,
+    Vec2<T> rectBMax,
 
-    Collision::Response* res
+    Collision::BasicResponse<NoDeduce<T>>* res
 );
 
+template<typename T>
 bool RectPolygon(
-    Vec2F rectMin,
-    Vec2F rectMax,
+    Vec2<T> rectMin,
+    Vec2<T> rectMax,
 
-    const std::vector<Vec2F>& polyPoints,
-    const std::vector<Vec2F>& polyNormals,
-    Vec2F polyCenter,
+    const std::vector<Vec2<T>>& polyPoints,
+    const std::vector<Vec2<T>>& polyNormals,
+    Vec2<T> polyCenter,
+    NoDeduce<T> polyRadius,
 
-    Collision::Response* res
+    Collision::BasicResponse<NoDeduce<T>>* res,
+    Collision::SatCache* cache = nullptr
 );
 
+template<typename T>
 bool PolygonPolygon(
-    const std::vector<Vec2F>& pointsA,
-    const std::vector<Vec2F>& normalsA,
-    Vec2F centerA,
+    const std::vector<Vec2<T>>& pointsA,
+    const std::vector<Vec2<T>>& normalsA,
+    Vec2<T> centerA,
+    NoDeduce<T> radiusA,
+
+    const std::vector<Vec2<T>>& pointsB,
+    const std::vector<Vec2<T>>& normalsB,
+    Vec2<T> centerB,
+    NoDeduce<T> radiusB,
+
+    Collision::BasicResponse<NoDeduce<T>>* res,
+    Collision::SatCache* cache = nullptr
+);
+
+template<typename T>
+bool PointCircle(Vec2<T> point, Vec2<T> circlePos, NoDeduce<T> circleRad);
+
+template<typename T>
+bool PointRect(Vec2<T> point, Vec2<T> rectMin, Vec2<T> rectMax);
+
+template<typename T>
+bool PointPolygon(Vec2<T> point, const std::vector<Vec2<T>>& points);
+
+//
+// Contact manifolds, same as the overlap tests but also find the contact points
+//
 
-    const std::vector<Vec2F>& pointsB,
-    const std::vector<Vec2F>& normalsB,
-    Vec2F centerB,
+template<typename T>
+bool ManifoldCircleCircle(
+    Vec2<T> posA,
+    NoDeduce<T> radA,
 
-    Collision::Response* res
+    Vec2<T> posB,
+    NoDeduce<T> radB,
+
+    Collision::BasicManifold<NoDeduce<T>>* res
+);
+
+template<typename T>
+bool ManifoldCircleRect(
+    Vec2<T> circlePos,
+    NoDeduce<T> circleRad,
+
+    Vec2<T> rectMin,
+    Vec2<T> rectMax,
+
+    Collision::BasicManifold<NoDeduce<T>>* res
+);
+
+template<typename T>
+bool ManifoldCirclePolygon(
+    Vec2<T> circlePos,
+    NoDeduce<T> circleRad,
+
+    const std::vector<Vec2<T>>& polyPoints,
+    const std::vector<Vec2<T>>& polyNormals,
+    Vec2<T> polyCenter,
+    NoDeduce<T> polyRadius,
+
+    Collision::BasicManifold<NoDeduce<T>>* res
+);
+
+template<typename T>
+bool ManifoldRectRect(
+    Vec2<T> rectAMin,
+    Vec2<T> rectAMax,
+
+    Vec2<T> rectBMin,
+    Vec2<T> rectBMax,
+
+    Collision::BasicManifold<NoDeduce<T>>* res
+);
+
+template<typename T>
+bool ManifoldRectPolygon(
+    Vec2<T> rectMin,
+    Vec2<T> rectMax,
+
+    const std::vector<Vec2<T>>& polyPoints,
+    const std::vector<Vec2<T>>& polyNormals,
+    Vec2<T> polyCenter,
+    NoDeduce<T> polyRadius,
+
+    Collision::BasicManifold<NoDeduce<T>>* res
 );
 
-bool PointCircle(Vec2F point, Vec2F circlePos, float circleRad);
+template<typename T>
+bool ManifoldPolygonPolygon(
+    const std::vector<Vec2<T>>& pointsA,
+    const std::vector<Vec2<T>>& normalsA,
+    Vec2<T> centerA,
+    NoDeduce<T> radiusA,
+
+    const std::vector<Vec2<T>>& pointsB,
+    const std::vector<Vec2<T>>& normalsB,
+    Vec2<T> centerB,
+    NoDeduce<T> radiusB,
+
+    Collision::BasicManifold<NoDeduce<T>>* res
+);
+
+//
+// Swept tests, for fast moving shapes that could skip past each other in a single step
+//
+
+template<typename T>
+bool SweepCircleCircle(
+    Vec2<T> posA,
+    NoDeduce<T> radA,
+    Vec2<T> moveA,
+
+    Vec2<T> posB,
+    NoDeduce<T> radB,
+    Vec2<T> moveB,
+
+    Collision::BasicTimeOfImpact<NoDeduce<T>>* res
+);
+
+template<typename T>
+bool SweepCircleRect(
+    Vec2<T> circlePos,
+    NoDeduce<T> circleRad,
+    Vec2<T> circleMove,
+
+    Vec2<T> rectMin,
+    Vec2<T> rectMax,
+    Vec2<T> rectMove,
+
+    Collision::BasicTimeOfImpact<NoDeduce<T>>* res
+);
+
+template<typename T>
+bool SweepCirclePolygon(
+    Vec2<T> circlePos,
+    NoDeduce<T> circleRad,
+    Vec2<T> circleMove,
+
+    const std::vector<Vec2<T>>& polyPoints,
+    const std::vector<Vec2<T>>& polyNormals,
+    Vec2<T> polyCenter,
+    NoDeduce<T> polyRadius,
+    Vec2<T> polyMove,
+
+    Collision::BasicTimeOfImpact<NoDeduce<T>>* res
+);
 
-bool PointRect(Vec2F point, Vec2F rectMin, Vec2F rectMax);
+template<typename T>
+bool SweepRectRect(
+    Vec2<T> rectAMin,
+    Vec2<T> rectAMax,
+    Vec2<T> rectAMove,
 
-bool PointPolygon(Vec2F point, const std::vector<Vec2F>& points);
+    Vec2<T> rectBMin,
+    Vec2<T> rectBMax,
+    Vec2<T> rectBMove,
+
+    Collision::BasicTimeOfImpact<NoDeduce<T>>* res
+);
+
+template<typename T>
+bool SweepRectPolygon(
+    Vec2<T> rectMin,
+    Vec2<T> rectMax,
+    Vec2<T> rectMove,
+
+    const std::vector<Vec2<T>>& polyPoints,
+    const std::vector<Vec2<T>>& polyNormals,
+    Vec2<T> polyCenter,
+    NoDeduce<T> polyRadius,
+    Vec2<T> polyMove,
+
+    Collision::BasicTimeOfImpact<NoDeduce<T>>* res
+);
+
+template<typename T>
+bool SweepPolygonPolygon(
+    const std::vector<Vec2<T>>& pointsA,
+    const std::vector<Vec2<T>>& normalsA,
+    Vec2<T> centerA,
+    NoDeduce<T> radiusA,
+    Vec2<T> moveA,
+
+    const std::vector<Vec2<T>>& pointsB,
+    const std::vector<Vec2<T>>& normalsB,
+    Vec2<T> centerB,
+    NoDeduce<T> radiusB,
+    Vec2<T> moveB,
+
+    Collision::BasicTimeOfImpact<NoDeduce<T>>* res
+);
+
+//
+// Ray casts, rays starting inside a shape don't hit it
+//
+
+template<typename T>
+bool RayCircle(
+    Vec2<T> rayStart,
+    Vec2<T> rayDelta,
+
+    Vec2<T> circlePos,
+    NoDeduce<T> circleRad,
+
+    Collision::BasicRayHit<NoDeduce<T>>* res
+);
+
+template<typename T>
+bool RayRect(
+    Vec2<T> rayStart,
+    Vec2<T> rayDelta,
+
+    Vec2<T> rectMin,
+    Vec2<T> rectMax,
+
+    Collision::BasicRayHit<NoDeduce<T>>* res
+);
+
+template<typename T>
+bool RayPolygon(
+    Vec2<T> rayStart,
+    Vec2<T> rayDelta,
+
+    const std::vector<Vec2<T>>& polyPoints,
+    const std::vector<Vec2<T>>& polyNormals,
+    Vec2<T> polyCenter,
+    NoDeduce<T> polyRadius,
+
+    Collision::BasicRayHit<NoDeduce<T>>* res
+);
+
+//
+// Batched ray casts of a single ray against many shapes, float only.
+// Shapes are given as separate arrays of each component so the loops can be vectorized,
+// the fraction of each shape is written to `outFractions` (RAY_MISS if it wasn't hit).
+// Use the single shape versions on the closest hit to get its normal.
+//
+
+void RayCircles(
+    Vec2F rayStart,
+    Vec2F rayDelta,
+
+    std::span<const float> circlePosX,
+    std::span<const float> circlePosY,
+    std::span<const float> circleRads,
+
+    std::span<float> outFractions
+);
+
+void RayRects(
+    Vec2F rayStart,
+    Vec2F rayDelta,
+
+    std::span<const float> rectMinX,
+    std::span<const float> rectMinY,
+    std::span<const float> rectMaxX,
+    std::span<const float> rectMaxY,
+
+    std::span<float> outFractions
+);
 };
@@ -0,0 +1,154 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#pragma once
+
+#include "fc/core/collision/grid.h"
+#include "fc/core/collision/shape.h"
+#include "fc/core/idPool.h"
+#include "fc/core/math/vec2.h"
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * Owns Shapes by ID and keeps them in a Grid.
+ *
+ * Shapes that are changed through `modify` are marked dirty and only those are re-inserted in the grid
+ * on the next `update`, with their AABB computed once and cached until they change again.
+ * Queries use the grid and cached AABBs as of the last `update`.
+ *
+ * @example
+ * ```
+ *   CollisionWorld world({});
+ *   auto player = world.add(std::make_unique<Circle>(Vec2F{10, 10}, 4));
+ *
+ *   // every tick
+ *   world.modify(player).translate(velocity * dt);
+ *   world.update();
+ *   for (auto other : world.queryShape(world.shape(player))) { ... }
+ * ```
+ */
+class CollisionWorld
+{
+public:
+    using ShapeID = uint32_t;
+    using AABB = std::pair<Vec2F, Vec2F>;
+
+    struct Config
+    {
+        /**
+         * Width and height of the world, shapes outside of it are clamped to the grid edges
+         */
+        uint32_t worldSize = 1024;
+        uint32_t cellSize = 32;
+        ShapeID maxShapes = 1024;
+    };
+
+    explicit CollisionWorld(const Config& config);
+
+    CollisionWorld(const CollisionWorld&) = delete;
+    CollisionWorld& operator=(const CollisionWorld&) = delete;
+
+    /**
+     * The shape is inserted in the grid right away
+     *
+     * @throws std::runtime_error if there's no IDs left
+     */
+    ShapeID add(std::unique_ptr<Shape> shape);
+
+    void remove(ShapeID id);
+
+    [[nodiscard]] const Shape& shape(ShapeID id) const
+    {
+        assert(isValid(id));
+        return *m_shapes[id];
+    }
+
+    /**
+     * Marks the shape dirty and returns it so it can be moved, it's re-inserted in the grid on the next update
+     */
+    [[nodiscard]] Shape& modify(ShapeID id);
+
+    /**
+     * Re-inserts the shapes modified since the last update in the grid
+     */
+    void update();
+
+    /**
+     * AABB of the shape as of the last update
+     */
+    [[nodiscard]] const AABB& getAABB(ShapeID id) const
+    {
+        assert(isValid(id));
+        return m_aabbs[id];
+    }
+
+    /**
+     * Shapes whose AABB overlaps `min` to `max`
+     *
+     * @note The result is only valid until the next query
+     */
+    [[nodiscard]] const std::vector<ShapeID>& queryAABB(Vec2F min, Vec2F max);
+
+    /**
+     * Shapes colliding with `shape`, which can be one of the world's shapes (it won't be in the result)
+     *
+     * @note The result is only valid until the next query
+     */
+    [[nodiscard]] const std::vector<ShapeID>& queryShape(const Shape& shape);
+
+    [[nodiscard]] bool isValid(ShapeID id) const
+    {
+        return id < m_flags.size() && (m_flags[id] & ALIVE) != 0;
+    }
+
+    [[nodiscard]] bool isDirty(ShapeID id) const
+    {
+        assert(isValid(id));
+        return (m_flags[id] & DIRTY) != 0;
+    }
+
+    /**
+     * Number of shapes waiting for the next update
+     */
+    [[nodiscard]] size_t dirtyCount() const
+    {
+        return m_dirty.size();
+    }
+
+    [[nodiscard]] const Config& config() const
+    {
+        return m_config;
+    }
+
+private:
+    enum Flags : uint8_t {
+        ALIVE = 1 << 0,
+        DIRTY = 1 << 1,
+    };
+
+    Config m_config;
+
+    IdPool<ShapeID> m_idPool;
+    Grid<uint32_t, ShapeID> m_grid;
+
+    //
+    // Shape data, indexed by shape ID
+    //
+
+    std::vector<std::unique_ptr<Shape>> m_shapes;
+    std::vector<AABB> m_aabbs;
+    std::vector<uint8_t> m_flags;
+
+    std::vector<ShapeID> m_dirty;
+    std::vector<ShapeID> m_queryResult;
+
+    void insert(ShapeID id);
+};
@@ -0,0 +1,295 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#pragma once
+
+#include "fc/core/collision/collision.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Remembers which pairs of entities were touching on the last tick
+ * to turn the narrowphase results into begin / stay / end events.
+ *
+ * Each tick:
+ * ```
+ *   cache.beginTick();
+ *   for (each colliding pair) {
+ *       cache.addContact(idA, idB, manifold);
+ *   }
+ *   cache.endTick();
+ *
+ *   for (const auto& contact : cache.began()) { ... }
+ *   for (const auto& contact : cache.ended()) { ... }
+ * ```
+ *
+ * Pairs are unordered, (A, B) and (B, A) are the same pair.
+ * Each contact keeps the IDs in the order they were last reported
+ * so the manifold normal always points from `a` to `b`.
+ */
+template<typename EntityID_T>
+    requires(std::is_unsigned_v<EntityID_T> && sizeof(EntityID_T) <= sizeof(uint32_t))
+class ContactCache
+{
+public:
+    struct Contact
+    {
+        EntityID_T a;
+        EntityID_T b;
+        Collision::Manifold manifold;
+    };
+
+    void beginTick()
+    {
+        m_tick++;
+
+        m_began.clear();
+        m_stayed.clear();
+        m_ended.clear();
+    }
+
+    /**
+     * Report that 2 entities are touching this tick
+     */
+    void addContact(EntityID_T a, EntityID_T b, const Collision::Manifold& manifold)
+    {
+        uint64_t key = pairKey(a, b);
+
+        // it was touching the whole time it was parked
+        if (!m_parked.empty()) {
+            restore(key, m_tick - 1);
+        }
+
+        auto [it, inserted] = m_pairs.try_emplace(key);
+        Entry& entry = it->second;
+
+        // reported twice in the same tick
+        if (!inserted && entry.tick == m_tick) {
+            entry.contact = {.a = a, .b = b, .manifold = manifold};
+            return;
+        }
+
+        bool touchedLastTick = !inserted && entry.tick == m_tick - 1;
+
+        entry.tick = m_tick;
+        entry.contact = {.a = a, .b = b, .manifold = manifold};
+
+        if (touchedLastTick) {
+            m_stayed.push_back(entry.contact);
+        } else {
+            m_began.push_back(entry.contact);
+        }
+    }
+
+    /**
+     * Moves pairs where `park(contact)` is true out of the per tick bookkeeping,
+     * e.g pairs between sleeping entities that won't be tested until one of them wakes up.
+     *
+     * Parked pairs stay touching without being reported and don't show up in stayed(),
+     * call outside of beginTick / endTick.
+     */
+    template<typename Fn>
+    void park(Fn&& park)
+    {
+        for (auto it = m_pairs.begin(); it != m_pairs.end();) {
+            const Contact& contact = it->second.contact;
+
+            // tick 0 means the pair was removed
+            if (it->second.tick == 0 || !park(contact)) {
+                ++it;
+                continue;
+            }
+
+            m_parkedByEntity[contact.a].push_back(it->first);
+            m_parkedByEntity[contact.b].push_back(it->first);
+
+            auto next = std::next(it);
+            m_parked.insert(m_pairs.extract(it));
+            it = next;
+        }
+    }
+
+    /**
+     * Brings back the parked pairs of an entity as if they were touching on this tick, e.g when it wakes up
+     */
+    void unpark(EntityID_T id)
+    {
+        auto it = m_parkedByEntity.find(id);
+        if (it == m_parkedByEntity.end()) {
+            return;
+        }
+
+        std::vector<uint64_t> keys = std::move(it->second);
+        m_parkedByEntity.erase(it);
+
+        for (uint64_t key : keys) {
+            restore(key, m_tick);
+        }
+    }
+
+    /**
+     * Ends every pair that wasn't reported this tick
+     */
+    void endTick()
+    {
+        for (auto it = m_pairs.begin(); it != m_pairs.end();) {
+            if (it->second.tick != m_tick) {
+                m_ended.push_back(it->second.contact);
+                it = m_pairs.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    /**
+     * Ends all pairs of an entity on the next endTick, e.g when its removed from the world
+     */
+    void removeEntity(EntityID_T id)
+    {
+        unpark(id);
+
+        for (auto& [key, entry] : m_pairs) {
+            if (entry.contact.a == id || entry.contact.b == id) {
+                entry.tick = 0;
+            }
+        }
+    }
+
+    /**
+     * Pairs that started touching this tick
+     */
+    [[nodiscard]] const std::vector<Contact>& began() const
+    {
+        return m_began;
+    }
+
+    /**
+     * Pairs that were already touching on the last tick and still are
+     */
+    [[nodiscard]] const std::vector<Contact>& stayed() const
+    {
+        return m_stayed;
+    }
+
+    /**
+     * Pairs that stopped touching this tick, with the last manifold they had
+     */
+    [[nodiscard]] const std::vector<Contact>& ended() const
+    {
+        return m_ended;
+    }
+
+    [[nodiscard]] bool touching(EntityID_T a, EntityID_T b) const
+    {
+        uint64_t key = pairKey(a, b);
+        return m_pairs.contains(key) || m_parked.contains(key);
+    }
+
+    /**
+     * @return the last contact between 2 entities or nullptr if they aren't touching
+     */
+    [[nodiscard]] const Contact* find(EntityID_T a, EntityID_T b) const
+    {
+        uint64_t key = pairKey(a, b);
+
+        auto it = m_pairs.find(key);
+        if (it != m_pairs.end()) {
+            return &it->second.contact;
+        }
+
+        it = m_parked.find(key);
+        if (it != m_parked.end()) {
+            return &it->second.contact;
+        }
+        return nullptr;
+    }
+
+    /**
+     * Pairs touching, parked ones included
+     */
+    [[nodiscard]] size_t size() const
+    {
+        return m_pairs.size() + m_parked.size();
+    }
+
+    [[nodiscard]] size_t parkedCount() const
+    {
+        return m_parked.size();
+    }
+
+private:
+    struct Entry
+    {
+        uint32_t tick = 0;
+        Contact contact;
+    };
+
+    static uint64_t pairKey(EntityID_T a, EntityID_T b)
+    {
+        if (a > b) {
+            std::swap(a, b);
+        }
+        return ((uint64_t)a << 32) | b;
+    }
+
+    /**
+     * Moves a parked pair back with the given tick, does nothing if it isn't parked
+     */
+    void restore(uint64_t key, uint32_t tick)
+    {
+        auto node = m_parked.extract(key);
+        if (node.empty()) {
+            return;
+        }
+
+        node.mapped().tick = tick;
+        forgetParked(node.mapped().contact.a, key);
+        forgetParked(node.mapped().contact.b, key);
+        m_pairs.insert(std::move(node));
+    }
+
+    void forgetParked(EntityID_T id, uint64_t key)
+    {
+        auto it = m_parkedByEntity.find(id);
+        if (it == m_parkedByEntity.end()) {
+            return;
+        }
+
+        std::vector<uint64_t>& keys = it->second;
+        auto found = std::ranges::find(keys, key);
+        if (found != keys.end()) {
+            *found = keys.back();
+            keys.pop_back();
+        }
+        if (keys.empty()) {
+            m_parkedByEntity.erase(it);
+        }
+    }
+
+    /**
+     * Starts at 1 so entries with tick 0 are never considered as touching
+     */
+    uint32_t m_tick = 1;
+
+    std::unordered_map<uint64_t, Entry> m_pairs;
+
+    /**
+     * Pairs left out of endTick, with the keys of each entity's so waking one doesn't search them all
+     */
+    std::unordered_map<uint64_t, Entry> m_parked;
+    std::unordered_map<EntityID_T, std::vector<uint64_t>> m_parkedByEntity;
+
+    std::vector<Contact> m_began;
+    std::vector<Contact> m_stayed;
+    std::vector<Contact> m_ended;
+};
@@ -10,20 +10,27 @@
 
 #include <algorithm>
 #include <cassert>
-#include <cfloat>
 #include <cmath>
 #include <cstdint>
+#include <limits>
 #include <type_traits>
 #include <vector>
 
 template<typename GridSize_T, typename EntityID_T>
 concept GridC = std::is_unsigned_v<GridSize_T> && std::is_unsigned_v<EntityID_T>;
 
-template<typename GridSize_T, typename EntityID_T>
+/**
+ * Uniform grid broadphase.
+ *
+ * Coord_T is the number type of world positions, float by default or Fixed for deterministic simulations
+ */
+template<typename GridSize_T, typename EntityID_T, typename Coord_T = float>
     requires(GridC<GridSize_T, EntityID_T>)
 class Grid
 {
 public:
+    using Vec = Vec2<Coord_T>;
+
     Grid(GridSize_T worldSize, GridSize_T cellSize, EntityID_T maxEntityID);
 
     Grid(const Grid&) = delete;
@@ -53,17 +60,24 @@ public:
         return m_maxEntityID;
     }
 
-    void insertEntity(EntityID_T entityID, Vec2F min, Vec2F max);
+    void insertEntity(EntityID_T entityID, Vec min, Vec max);
 
     void removeEntity(EntityID_T entityID);
 
-    const std::vector<EntityID_T>& queryAABB(Vec2F min, Vec2F max) const;
+    const std::vector<EntityID_T>& queryAABB(Vec min, Vec max) const;
+
+    /**
+     * Appends the entities in the cells overlapping [min, max] to `out`.
+     * Unlike the other queries it doesn't touch the grid's query state, so threads can run it at once
+     * while nothing is inserted or removed. An entity spanning several cells is appended once per cell
+     */
+    void queryAABB(Vec min, Vec max, std::vector<EntityID_T>& out) const;
 
-    const std::vector<EntityID_T>& queryPosition(Vec2F pos) const;
+    const std::vector<EntityID_T>& queryPosition(Vec pos) const;
 
     const std::vector<EntityID_T>& queryEntity(EntityID_T entityID) const;
 
-    const std::vector<EntityID_T>& queryLine(Vec2F lineStart, Vec2F lineEnd) const;
+    const std::vector<EntityID_T>& queryLine(Vec lineStart, Vec lineEnd) const;
 
 private:
     struct Cell
@@ -81,7 +95,7 @@ private:
     };
 
     using GridAABB = AABB<GridPos>;
-    using WorldAABB = AABB<Vec2F>;
+    using WorldAABB = AABB<Vec>;
 
     struct EntityGridData
     {
@@ -90,14 +104,28 @@ private:
         GridAABB bounds;
     };
 
-    GridPos roundToGrid(Vec2F pos) const
+    GridPos roundToGrid(Vec pos) const
     {
+        const Coord_T cellSize((int)m_cellSize);
         return {
-            (GridSize_T)std::clamp((int)(pos.x / m_cellSize), 0, (int)m_gridSize - 1),
-            (GridSize_T)std::clamp((int)(pos.y / m_cellSize), 0, (int)m_gridSize - 1),
+            (GridSize_T)std::clamp((int)(pos.x / cellSize), 0, (int)m_gridSize - 1),
+            (GridSize_T)std::clamp((int)(pos.y / cellSize), 0, (int)m_gridSize - 1),
         };
     }
 
+    /**
+     * Position inside the cell from 0 to 1
+     */
+    Coord_T cellFraction(Coord_T pos) const
+    {
+        const Coord_T cells = pos / Coord_T((int)m_cellSize);
+        if constexpr (std::is_floating_point_v<Coord_T>) {
+            return std::fmod(cells, Coord_T(1));
+        } else {
+            return cells - Coord_T((int)cells);
+        }
+    }
+
     const std::vector<EntityID_T>& queryGridAABB(GridAABB bounds) const
     {
         m_resultCache.clear();
@@ -172,9 +200,9 @@ private:
     }
 };
 
-template<typename GridSize_T, typename EntityID_T>
+template<typename GridSize_T, typename EntityID_T, typename Coord_T>
     requires(GridC<GridSize_T, EntityID_T>)
-Grid<GridSize_T, EntityID_T>::Grid(GridSize_T worldSize, GridSize_T cellSize, EntityID_T maxEntityID) :
+Grid<GridSize_T, EntityID_T, Coord_T>::Grid(GridSize_T worldSize, GridSize_T cellSize, EntityID_T maxEntityID) :
     m_worldSize(worldSize),
     m_cellSize(cellSize),
     m_gridSize(worldSize / cellSize),
@@ -187,17 +215,17 @@ Grid<GridSize_T, EntityID_T>::Grid(GridSize_T worldSize, GridSize_T cellSize, En
     m_resultCache.reserve(256);
 }
 
-template<typename GridSize_T, typename EntityID_T>
+template<typename GridSize_T, typename EntityID_T, typename Coord_T>
     requires(GridC<GridSize_T, EntityID_T>)
-Grid<GridSize_T, EntityID_T>::~Grid()
+Grid<GridSize_T, EntityID_T, Coord_T>::~Grid()
 {
     delete[] m_cells;
     delete[] m_entityCache;
 }
 
-template<typename GridSize_T, typename EntityID_T>
+template<typename GridSize_T, typename EntityID_T, typename Coord_T>
     requires(GridC<GridSize_T, EntityID_T>)
-void Grid<GridSize_T, EntityID_T>::insertEntity(EntityID_T entityID, Vec2F min, Vec2F max)
+void Grid<GridSize_T, EntityID_T, Coord_T>::insertEntity(EntityID_T entityID, Vec min, Vec max)
 {
     EntityGridData& entity = getEntityData(entityID);
 
@@ -248,9 +276,9 @@ void Grid<GridSize_T, EntityID_T>::insertEntity(EntityID_T entityID, Vec2F min,
     }
 }
 
-template<typename GridSize_T, typename EntityID_T>
+template<typename GridSize_T, typename EntityID_T, typename Coord_T>
     requires(GridC<GridSize_T, EntityID_T>)
-void Grid<GridSize_T, EntityID_T>::removeEntity(EntityID_T entityID)
+void Grid<GridSize_T, EntityID_T, Coord_T>::removeEntity(EntityID_T entityID)
 {
     EntityGridData& entity = getEntityData(entityID);
 
@@ -283,9 +311,9 @@ void Grid<GridSize_T, EntityID_T>::removeEntity(EntityID_T entityID)
     entity.bounds = {{0, 0}, {0, 0}};
 }
 
-template<typename GridSize_T, typename EntityID_T>
+template<typename GridSize_T, typename EntityID_T, typename Coord_T>
     requires(GridC<GridSize_T, EntityID_T>)
-const std::vector<EntityID_T>& Grid<GridSize_T, EntityID_T>::queryAABB(Vec2F min, Vec2F max) const
+const std::vector<EntityID_T>& Grid<GridSize_T, EntityID_T, Coord_T>::queryAABB(Vec min, Vec max) const
 {
     GridAABB bounds = {
         .min = roundToGrid(min),
@@ -295,48 +323,69 @@ const std::vector<EntityID_T>& Grid<GridSize_T, EntityID_T>::queryAABB(Vec2F min
     return queryGridAABB(bounds);
 }
 
-template<typename GridSize_T, typename EntityID_T>
+template<typename GridSize_T, typename EntityID_T, typename Coord_T>
+    requires(GridC<GridSize_T, EntityID_T>)
+void Grid<GridSize_T, EntityID_T, Coord_T>::queryAABB(Vec min, Vec max, std::vector<EntityID_T>& out) const
+{
+    GridPos gridMin = roundToGrid(min);
+    GridPos gridMax = roundToGrid(max);
+
+    for (GridSize_T y = gridMin.y; y <= gridMax.y; y++) {
+        for (GridSize_T x = gridMin.x; x <= gridMax.x; x++) {
+            const Cell& cell = cellAt(x, y);
+            out.insert(out.end(), cell.items.begin(), cell.items.end());
+        }
+    }
+}
+
+template<typename GridSize_T, typename EntityID_T, typename Coord_T>
     requires(GridC<GridSize_T, EntityID_T>)
-const std::vector<EntityID_T>& Grid<GridSize_T, EntityID_T>::queryPosition(Vec2F pos) const
+const std::vector<EntityID_T>& Grid<GridSize_T, EntityID_T, Coord_T>::queryPosition(Vec pos) const
 {
     GridPos gridPos = roundToGrid(pos);
     return cellAt(gridPos.x, gridPos.y).items;
 }
 
-template<typename GridSize_T, typename EntityID_T>
+template<typename GridSize_T, typename EntityID_T, typename Coord_T>
     requires(GridC<GridSize_T, EntityID_T>)
-const std::vector<EntityID_T>& Grid<GridSize_T, EntityID_T>::queryEntity(EntityID_T entityID) const
+const std::vector<EntityID_T>& Grid<GridSize_T, EntityID_T, Coord_T>::queryEntity(EntityID_T entityID) const
 {
     EntityGridData& entity = m_entityCache[entityID];
     assert(entity.valid);
     return queryGridAABB(entity.bounds);
 }
 
-template<typename GridSize_T, typename EntityID_T>
+template<typename GridSize_T, typename EntityID_T, typename Coord_T>
     requires(GridC<GridSize_T, EntityID_T>)
-const std::vector<EntityID_T>& Grid<GridSize_T, EntityID_T>::queryLine(Vec2F lineStart, Vec2F lineEnd) const
+const std::vector<EntityID_T>& Grid<GridSize_T, EntityID_T, Coord_T>::queryLine(Vec lineStart, Vec lineEnd) const
 {
-    Vec2F diff = lineEnd - lineStart;
+    using std::abs;
+
+    Vec diff = lineEnd - lineStart;
 
     int gridDirX = lineEnd.x >= lineStart.x ? 1 : -1;
     int gridDirY = lineEnd.y >= lineStart.y ? 1 : -1;
 
-    float dirX =
-        std::abs(diff.x) > 0.00001
-        ? (gridDirX * (int)m_cellSize) / diff.x
-        : FLT_MAX;
+    const Coord_T minDiff(0.00001F);
+    const Coord_T never = std::numeric_limits<Coord_T>::max();
+
+    Coord_T dirX =
+        abs(diff.x) > minDiff
+        ? Coord_T(gridDirX * (int)m_cellSize) / diff.x
+        : never;
 
-    float dirY =
-        std::abs(diff.y) > 0.00001
-        ? (gridDirY * (int)m_cellSize) / diff.y
-        : FLT_MAX;
+    Coord_T dirY =
+        abs(diff.y) > minDiff
+        ? Coord_T(gridDirY * (int)m_cellSize) / diff.y
+        : never;
 
     // cell relative
-    float relativeX = std::fmod(lineStart.x / m_cellSize, 1.F);
-    float relativeY = std::fmod(lineStart.y / m_cellSize, 1.F);
+    Coord_T relativeX = cellFraction(lineStart.x);
+    Coord_T relativeY = cellFraction(lineStart.y);
 
-    float x = dirX * (gridDirX > 0 ? 1.F - relativeX : relativeX);
-    float y = dirY * (gridDirY > 0 ? 1.F - relativeY : relativeY);
+    // fixed point would wrap around when scaling `never`
+    Coord_T x = dirX == never ? never : dirX * (gridDirX > 0 ? Coord_T(1) - relativeX : relativeX);
+    Coord_T y = dirY == never ? never : dirY * (gridDirY > 0 ? Coord_T(1) - relativeY : relativeY);
 
     GridPos start = roundToGrid(lineStart);
     GridPos endCell = roundToGrid(lineEnd);
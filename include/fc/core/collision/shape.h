@@ -9,37 +9,57 @@
 #include "fc/core/collision/collision.h"
 #include "fc/core/math/vec2.h"
 
+#include <array>
 #include <cassert>
 #include <cstdint>
 #include <string>
 #include <vector>
 
-class Shape
+template<typename T>
+class BasicShape
 {
 public:
     enum Type : uint8_t {
         CIRCLE,
         RECT,
         POLYGON,
+        COMPOUND,
         COUNT
     };
 
     const Type type;
 
     [[nodiscard]] virtual std::string toString() const = 0;
-    [[nodiscard]] virtual bool pointInside(Vec2F point) const = 0;
+    [[nodiscard]] virtual bool pointInside(Vec2<T> point) const = 0;
 
-    [[nodiscard]] virtual Vec2F center() const = 0;
+    /**
+     * Cast a ray from `rayStart` to `rayStart + rayDelta` against this Shape.
+     *
+     * @return true if the ray hits the shape, rays starting inside the shape never hit it
+     *
+     * @param res Where the ray hits the shape, optional / can be nullptr
+     *
+     * @example
+     * ```
+     *   Collision::RayHit hit;
+     *   if (wall.rayCast(eyePos, target - eyePos, &hit)) {
+     *       Vec2F hitPos = eyePos + ((target - eyePos) * hit.fraction);
+     *   }
+     * ```
+     */
+    [[nodiscard]] virtual bool rayCast(Vec2<T> rayStart, Vec2<T> rayDelta, Collision::BasicRayHit<T>* res) const = 0;
 
-    virtual Shape& translate(Vec2F posToAdd) = 0;
-    virtual Shape& scale(float scale) = 0;
+    [[nodiscard]] virtual Vec2<T> center() const = 0;
 
-    [[nodiscard]] virtual std::pair<Vec2F, Vec2F> getAABB() const = 0;
+    virtual BasicShape& translate(Vec2<T> posToAdd) = 0;
+    virtual BasicShape& scale(T scale) = 0;
 
-    virtual ~Shape() = default;
+    [[nodiscard]] virtual std::pair<Vec2<T>, Vec2<T>> getAABB() const = 0;
 
-    Shape& operator=(const Shape&) = delete;
-    Shape& operator=(Shape&&) noexcept = delete;
+    virtual ~BasicShape() = default;
+
+    BasicShape& operator=(const BasicShape&) = delete;
+    BasicShape& operator=(BasicShape&&) noexcept = delete;
 
     /**
      * Check collision between this and another Shape.
@@ -48,6 +68,7 @@ public:
      *
      * @param other The second shape
      * @param res A collision response pointer, optional / can be nullptr
+     * @param cache Separating axis cache for this pair of shapes, optional / can be nullptr
      *
      * @note The collision response will only be valid if this function returned true.
      * @note The collision response normal will always be relative to this instance.
@@ -63,132 +84,346 @@ public:
      *   }
      * ```
      */
-    [[nodiscard]] bool getCollision(const Shape& other, Collision::Response* res) const;
+    [[nodiscard]] bool getCollision(const BasicShape& other, Collision::BasicResponse<T>* res, Collision::SatCache* cache = nullptr) const;
+
+    /**
+     * Same as getCollision but also finds the contact points between both shapes.
+     *
+     * @return true if both shapes collide
+     *
+     * @param other The second shape
+     * @param res A contact manifold pointer, optional / can be nullptr
+     *
+     * @note The manifold will only be valid if this function returned true.
+     * @note The manifold normal will always be relative to this instance.
+     */
+    [[nodiscard]] bool getManifold(const BasicShape& other, Collision::BasicManifold<T>* res) const;
+
+    /**
+     * Find when this Shape first touches another Shape while both are moving.
+     *
+     * Use this instead of getCollision for fast moving shapes (e.g bullets)
+     * that could move past thin shapes in a single step.
+     *
+     * @return true if the shapes touch at some point of the movement
+     *
+     * @param move How much this shape moves during the step (e.g velocity * dt)
+     * @param other The second shape
+     * @param otherMove How much the second shape moves during the step
+     * @param res A time of impact pointer, optional / can be nullptr
+     *
+     * @note The normal will always be relative to this instance.
+     *
+     * @example
+     * ```
+     *   Circle bullet({0, 0}, 1);
+     *   Rect wall({50, -10}, {51, 10});
+     *   Vec2F move = bulletVel * dt;
+     *   Collision::TimeOfImpact toi;
+     *   if (bullet.getTimeOfImpact(move, wall, {}, &toi)) {
+     *       // move the bullet up to the wall
+     *       bullet.translate(move * toi.time);
+     *   }
+     * ```
+     */
+    [[nodiscard]] bool getTimeOfImpact(Vec2<T> move, const BasicShape& other, Vec2<T> otherMove, Collision::BasicTimeOfImpact<T>* res) const;
 
-    friend std::ostream& operator<<(std::ostream& os, const Shape& shape)
+    friend std::ostream& operator<<(std::ostream& os, const BasicShape& shape)
     {
         os << shape.toString();
         return os;
     }
 
 protected:
-    explicit Shape(Type type) : type(type)
+    explicit BasicShape(Type type) : type(type)
     {
     }
 };
 
-class Circle : public Shape
+template<typename T>
+class BasicCircle : public BasicShape<T>
 {
 public:
-    Vec2F pos;
-    float rad;
+    Vec2<T> pos;
+    T rad;
 
-    Circle(const Circle& circ);
-    Circle(Circle&& circ) noexcept;
-    Circle(Vec2F pos, float rad);
+    BasicCircle(const BasicCircle& circ);
+    BasicCircle(BasicCircle&& circ) noexcept;
+    BasicCircle(Vec2<T> pos, T rad);
 
-    Circle& operator=(Circle circ);
+    BasicCircle& operator=(BasicCircle circ);
 
     [[nodiscard]] std::string toString() const override;
-    [[nodiscard]] bool pointInside(Vec2F point) const override;
+    [[nodiscard]] bool pointInside(Vec2<T> point) const override;
+    [[nodiscard]] bool rayCast(Vec2<T> rayStart, Vec2<T> rayDelta, Collision::BasicRayHit<T>* res) const override;
 
-    [[nodiscard]] Vec2F center() const override;
+    [[nodiscard]] Vec2<T> center() const override;
 
-    Circle& translate(Vec2F posToAdd) override;
-    Circle& scale(float scale) override;
+    BasicCircle& translate(Vec2<T> posToAdd) override;
+    BasicCircle& scale(T scale) override;
 
-    [[nodiscard]] std::pair<Vec2F, Vec2F> getAABB() const override;
+    [[nodiscard]] std::pair<Vec2<T>, Vec2<T>> getAABB() const override;
 
 private:
-    static void swap(Circle& lhs, Circle& rhs) noexcept;
+    static void swap(BasicCircle& lhs, BasicCircle& rhs) noexcept;
 };
 
-class Rect : public Shape
+template<typename T>
+class BasicRect : public BasicShape<T>
 {
 public:
-    Vec2F min;
-    Vec2F max;
+    Vec2<T> min;
+    Vec2<T> max;
 
-    Rect(const Rect&);
-    Rect(Rect&&) noexcept;
-    Rect(Vec2F min, Vec2F max);
+    BasicRect(const BasicRect&);
+    BasicRect(BasicRect&&) noexcept;
+    BasicRect(Vec2<T> min, Vec2<T> max);
 
-    Rect& operator=(Rect rect);
+    BasicRect& operator=(BasicRect rect);
 
-    static Rect fromDims(float width, float height, Vec2F center = {0, 0});
+    static BasicRect fromDims(T width, T height, Vec2<T> center = {0, 0});
 
-    [[nodiscard]] float width() const
+    [[nodiscard]] T width() const
     {
         return max.x - min.x;
     }
 
-    [[nodiscard]] float height() const
+    [[nodiscard]] T height() const
     {
         return max.y - min.y;
     }
 
-    [[nodiscard]] std::vector<Vec2F> getPoints() const;
+    [[nodiscard]] std::vector<Vec2<T>> getPoints() const;
 
     [[nodiscard]] std::string toString() const override;
-    [[nodiscard]] bool pointInside(Vec2F point) const override;
+    [[nodiscard]] bool pointInside(Vec2<T> point) const override;
+    [[nodiscard]] bool rayCast(Vec2<T> rayStart, Vec2<T> rayDelta, Collision::BasicRayHit<T>* res) const override;
 
-    [[nodiscard]] Vec2F center() const override;
+    [[nodiscard]] Vec2<T> center() const override;
 
-    Rect& translate(Vec2F posToAdd) override;
-    Rect& scale(float scale) override;
+    BasicRect& translate(Vec2<T> posToAdd) override;
+    BasicRect& scale(T scale) override;
 
-    [[nodiscard]] std::pair<Vec2F, Vec2F> getAABB() const override;
+    [[nodiscard]] std::pair<Vec2<T>, Vec2<T>> getAABB() const override;
 
 private:
-    static void swap(Rect& lhs, Rect& rhs) noexcept;
+    static void swap(BasicRect& lhs, BasicRect& rhs) noexcept;
 };
 
-class Polygon : public Shape
+template<typename T>
+class BasicPolygon : public BasicShape<T>
 {
 public:
     /**
      * Always specified in counter-clockwise order
      */
-    std::vector<Vec2F> points;
+    std::vector<Vec2<T>> points;
 
-    explicit Polygon(std::vector<Vec2F> points);
-    Polygon(const Polygon&);
-    Polygon(Polygon&&) noexcept;
+    explicit BasicPolygon(std::vector<Vec2<T>> points);
+    BasicPolygon(const BasicPolygon&);
+    BasicPolygon(BasicPolygon&&) noexcept;
 
-    Polygon& operator=(Polygon poly);
+    BasicPolygon& operator=(BasicPolygon poly);
 
-    static Polygon fromSides(size_t sides, Vec2F center, float radius);
+    static BasicPolygon fromSides(size_t sides, Vec2<T> center, T radius);
 
     void calculateNormals();
 
+    /**
+     * Also updates the bounding radius
+     */
     void calculateCenter();
 
-    [[nodiscard]] const std::vector<Vec2F>& normals() const
+    [[nodiscard]] const std::vector<Vec2<T>>& normals() const
     {
         return m_normals;
     };
 
+    /**
+     * Distance from the center to the furthest point
+     */
+    [[nodiscard]] T radius() const
+    {
+        return m_radius;
+    }
+
     [[nodiscard]] std::string toString() const override;
-    [[nodiscard]] bool pointInside(Vec2F point) const override;
+    [[nodiscard]] bool pointInside(Vec2<T> point) const override;
+    [[nodiscard]] bool rayCast(Vec2<T> rayStart, Vec2<T> rayDelta, Collision::BasicRayHit<T>* res) const override;
 
-    [[nodiscard]] Vec2F center() const override;
+    [[nodiscard]] Vec2<T> center() const override;
 
-    Polygon& translate(Vec2F posToAdd) override;
-    Polygon& scale(float scale) override;
+    BasicPolygon& translate(Vec2<T> posToAdd) override;
+    BasicPolygon& scale(T scale) override;
 
-    Polygon& rotate(float rotation);
+    BasicPolygon& rotate(T rotation);
 
-    [[nodiscard]] std::pair<Vec2F, Vec2F> getAABB() const override;
+    [[nodiscard]] std::pair<Vec2<T>, Vec2<T>> getAABB() const override;
 
-    [[nodiscard]] static bool isCounterClockwise(Vec2F a, Vec2F b, Vec2F c);
-    [[nodiscard]] static bool isConvex(const std::vector<Vec2F>& points);
+    [[nodiscard]] static bool isCounterClockwise(Vec2<T> a, Vec2<T> b, Vec2<T> c);
+    [[nodiscard]] static bool isConvex(const std::vector<Vec2<T>>& points);
 
 private:
     /**
      * `normals[i]` == normal of segment `points[i]` to `points[(i + 1) % size]`
      */
-    std::vector<Vec2F> m_normals;
-    Vec2F m_center;
+    std::vector<Vec2<T>> m_normals;
+    Vec2<T> m_center;
+    /**
+     * Radius of the bounding circle around m_center, lets collision checks skip far apart shapes
+     */
+    T m_radius = 0;
+
+    static void swap(BasicPolygon& lhs, BasicPolygon& rhs) noexcept;
+};
+
+/**
+ * Concave polygon, split into convex parts once when it's created.
+ *
+ * Collision checks go through each part so it's a lot cheaper than a separate Polygon for each piece of
+ * the outline: the whole shape has a single AABB (and grid entry) and an AABB tree over the parts skips the ones
+ * that can't touch the other shape before doing any separating axis test.
+ *
+ * The outline is triangulated with ear clipping and the triangles are merged back together
+ * while they stay convex (Hertel-Mehlhorn), which gives at most 4 times the minimum number of parts.
+ *
+ * @note Manifolds only have the contact points of the deepest part
+ * @note SatCache isn't used since each pair of parts would need its own
+ */
+template<typename T>
+class BasicCompoundPolygon : public BasicShape<T>
+{
+public:
+    /**
+     * @param outline Points of a simple (non self-intersecting) polygon in counter-clockwise order
+     * @throws std::invalid_argument if the outline isn't one, see decompose
+     */
+    explicit BasicCompoundPolygon(const std::vector<Vec2<T>>& outline);
+    BasicCompoundPolygon(const BasicCompoundPolygon&);
+    BasicCompoundPolygon(BasicCompoundPolygon&&) noexcept;
+
+    BasicCompoundPolygon& operator=(BasicCompoundPolygon compound);
+
+    [[nodiscard]] const std::vector<BasicPolygon<T>>& parts() const
+    {
+        return m_parts;
+    }
+
+    /**
+     * Calls `fn(part)` for each part whose AABB overlaps `min` to `max`, stops early if `fn` returns false.
+     *
+     * @return false if `fn` stopped the query
+     */
+    template<typename Fn>
+    bool queryParts(Vec2<T> min, Vec2<T> max, Fn&& fn) const
+    {
+        std::array<uint32_t, MAX_TREE_DEPTH> stack; // NOLINT(cppcoreguidelines-pro-type-member-init)
+        size_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0) {
+            uint32_t nodeIdx = stack[--stackSize];
+            const PartNode& node = m_nodes[nodeIdx];
+
+            if (node.max.x < min.x || max.x < node.min.x || node.max.y < min.y || max.y < node.min.y) {
+                continue;
+            }
+
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                    if (!fn(m_parts[i])) {
+                        return false;
+                    }
+                }
+                continue;
+            }
+
+            assert(stackSize + 2 <= stack.size());
+            stack[stackSize++] = node.first;
+            stack[stackSize++] = nodeIdx + 1;
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] std::string toString() const override;
+    [[nodiscard]] bool pointInside(Vec2<T> point) const override;
+    [[nodiscard]] bool rayCast(Vec2<T> rayStart, Vec2<T> rayDelta, Collision::BasicRayHit<T>* res) const override;
+
+    [[nodiscard]] Vec2<T> center() const override;
+
+    BasicCompoundPolygon& translate(Vec2<T> posToAdd) override;
+    BasicCompoundPolygon& scale(T scale) override;
+
+    BasicCompoundPolygon& rotate(T rotation);
+
+    [[nodiscard]] std::pair<Vec2<T>, Vec2<T>> getAABB() const override;
+
+    /**
+     * Splits a simple polygon in counter-clockwise order into convex polygons, also in counter-clockwise order
+     *
+     * @throws std::invalid_argument if the outline has less than 3 points, is clockwise or self-intersecting.
+     *         Not every self-intersecting outline is caught, only the ones that can't be clipped into ears
+     */
+    [[nodiscard]] static std::vector<std::vector<Vec2<T>>> decompose(const std::vector<Vec2<T>>& outline);
+
+private:
+    static constexpr size_t MAX_TREE_DEPTH = 64;
+    static constexpr uint32_t PARTS_PER_LEAF = 1;
+
+    /**
+     * Node of the AABB tree over the parts, so queries don't have to check every part.
+     * The left child of a branch is always right after it, nodes come after their parent.
+     */
+    struct PartNode
+    {
+        Vec2<T> min;
+        Vec2<T> max;
+        /**
+         * First part index for leaves, right child index for branches
+         */
+        uint32_t first = 0;
+        /**
+         * Part count for leaves, 0 for branches
+         */
+        uint32_t count = 0;
+    };
+
+    std::vector<BasicPolygon<T>> m_parts;
+    std::vector<PartNode> m_nodes;
+    Vec2<T> m_center;
+
+    /**
+     * Sorts the parts `begin` to `end` into a subtree
+     *
+     * @return Index of the subtree's root node
+     */
+    uint32_t buildTree(uint32_t begin, uint32_t end, size_t depth);
+
+    /**
+     * Moves every point of every part, used by scale and rotate
+     */
+    template<typename Fn>
+    void transformPoints(Fn&& fn);
 
-    static void swap(Polygon& lhs, Polygon& rhs) noexcept;
+    /**
+     * Updates the AABB of every node from the parts
+     */
+    void calculateAABB();
+
+    static void swap(BasicCompoundPolygon& lhs, BasicCompoundPolygon& rhs) noexcept;
 };
+
+// fixed point shapes are for deterministic simulations, see Fixed
+
+using Shape = BasicShape<float>;
+using Circle = BasicCircle<float>;
+using Rect = BasicRect<float>;
+using Polygon = BasicPolygon<float>;
+using CompoundPolygon = BasicCompoundPolygon<float>;
+
+using ShapeFx = BasicShape<Fixed>;
+using CircleFx = BasicCircle<Fixed>;
+using RectFx = BasicRect<Fixed>;
+using PolygonFx = BasicPolygon<Fixed>;
+using CompoundPolygonFx = BasicCompoundPolygon<Fixed>;
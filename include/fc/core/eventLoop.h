@@ -0,0 +1,149 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Event loop for headless servers and tools, backed by libuv.
+ * Sleeps until a timer is due or a file operation finishes instead of busy looping.
+ *
+ * Everything but `post` must be called from the thread running the loop and every callback runs on it.
+ * Callbacks mustn't throw, they're called from inside libuv.
+ *
+ * @example
+ * ```
+ *   EventLoop loop;
+ *   loop.setTicker(30, [&](uint32_t tick, double dt) {
+ *       world.step(dt);
+ *   });
+ *   loop.readFile("replay.bin", [&](EventLoop::ReadResult result) {
+ *       if (result) {
+ *           replay.load(*result);
+ *       }
+ *   });
+ *   loop.run();
+ * ```
+ */
+class EventLoop
+{
+public:
+    /**
+     * Timers, tickers and idle callbacks, never reused so cancelling an old ID is harmless
+     */
+    using HandleID = uint32_t;
+
+    using Callback = std::function<void()>;
+    using TickCallback = std::function<void(uint32_t tick, double dt)>;
+
+    /**
+     * The file's bytes or why it couldn't be read
+     */
+    using ReadResult = std::expected<std::vector<uint8_t>, std::string>;
+    using ReadCallback = std::function<void(ReadResult result)>;
+
+    using WriteResult = std::expected<void, std::string>;
+    using WriteCallback = std::function<void(WriteResult result)>;
+
+    EventLoop();
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop(EventLoop&&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+    EventLoop& operator=(EventLoop&&) = delete;
+
+    /**
+     * Runs until `stop` or until there's no timer, ticker, idle callback or file operation left
+     */
+    void run();
+
+    /**
+     * Handles what's ready without waiting, e.g to drive the loop from another loop
+     *
+     * @return If there's still something to wait for
+     */
+    bool runOnce();
+
+    /**
+     * Makes `run` return after the current callback
+     */
+    void stop();
+
+    /**
+     * Monotonic time in seconds, nanosecond precise
+     */
+    [[nodiscard]] static double now();
+
+    HandleID setTimeout(double seconds, Callback fn);
+
+    HandleID setInterval(double seconds, Callback fn);
+
+    /**
+     * Calls `fn` `rate` times per second, `dt` is always `1 / rate`.
+     * Each tick is scheduled from the real time so they don't drift like an interval does,
+     * a tick that's late by up to 8 ticks is caught up, after that they're skipped.
+     */
+    HandleID setTicker(uint32_t rate, TickCallback fn);
+
+    /**
+     * Calls `fn` on every loop iteration, the loop doesn't sleep while there's one
+     */
+    HandleID setIdle(Callback fn);
+
+    /**
+     * Stops a timer, ticker or idle callback, it can be called from inside its own callback
+     */
+    void cancel(HandleID id);
+
+    /**
+     * Runs `fn` on the loop's thread and wakes it up, safe to call from any thread.
+     * Posting alone doesn't keep `run` going, a post after it returned runs on the next run
+     */
+    void post(Callback fn);
+
+    /**
+     * Reads a whole file without blocking, the reads run on libuv's thread pool
+     */
+    void readFile(const std::string& path, ReadCallback fn);
+
+    /**
+     * Replaces the file's content with `bytes` without blocking
+     */
+    void writeFile(const std::string& path, std::vector<uint8_t> bytes, WriteCallback fn);
+
+private:
+    /**
+     * libuv types stay out of this header
+     */
+    struct Impl;
+    struct Handle;
+    struct FileOp;
+    std::unique_ptr<Impl> m_impl;
+
+    std::unordered_map<HandleID, std::unique_ptr<Handle>> m_handles;
+    HandleID m_nextHandleID = 1;
+
+    std::mutex m_postMutex;
+    std::vector<Callback> m_posted;
+
+    Handle& addHandle();
+    void runTicks(Handle& handle);
+    void runPosted();
+
+    /**
+     * Moves a file read or write to its next step once the previous one finished with `result`
+     */
+    void fileStep(FileOp* op, intptr_t result);
+};
@@ -4,6 +4,8 @@
     SPDX-FileCopyrightText: 2026 firecat2d developers
 */
 
+#pragma once
+
 #include <list>
 #include <stdexcept>
 #include <type_traits>
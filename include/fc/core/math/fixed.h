@@ -0,0 +1,282 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#pragma once
+
+#include "fc/core/math/vec2.h"
+
+#include <cassert>
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+
+/**
+ * Fixed point number with 16 fractional bits.
+ *
+ * Every operation is done with integers so results are bit-identical on every platform and compiler,
+ * unlike floats where sin / cos and the compiler's choice of instructions can change the last bits.
+ *
+ * The value is stored in 64 bits so squared distances between world coordinates fit,
+ * products and the numerator of divisions have to stay within about ±2 billion.
+ * Overflow wraps around instead of being undefined.
+ *
+ * sqrt, abs, sin and cos are found by ADL so generic code can do
+ * ```
+ *   using std::sqrt;
+ *   T length = sqrt(lengthSqr);
+ * ```
+ */
+class Fixed
+{
+public:
+    static constexpr int FRACTION_BITS = 16;
+    static constexpr int64_t ONE = int64_t{1} << FRACTION_BITS;
+
+    constexpr Fixed() = default;
+
+    // NOLINTNEXTLINE(google-explicit-constructor) so integer literals work like they do with floats
+    constexpr Fixed(int value) : m_raw(int64_t{value} * ONE)
+    {
+    }
+
+    /**
+     * Rounds to the closest fixed point value, only use for constants or values that don't need to be deterministic
+     * since the float itself might not be
+     */
+    constexpr explicit Fixed(float value) : Fixed(static_cast<double>(value))
+    {
+    }
+
+    constexpr explicit Fixed(double value) :
+        m_raw(static_cast<int64_t>((value * ONE) + (value >= 0 ? 0.5 : -0.5)))
+    {
+    }
+
+    [[nodiscard]] static constexpr Fixed fromRaw(int64_t raw)
+    {
+        Fixed out;
+        out.m_raw = raw;
+        return out;
+    }
+
+    [[nodiscard]] constexpr int64_t raw() const
+    {
+        return m_raw;
+    }
+
+    [[nodiscard]] constexpr float toFloat() const
+    {
+        return static_cast<float>(m_raw) / ONE;
+    }
+
+    constexpr explicit operator float() const
+    {
+        return toFloat();
+    }
+
+    /**
+     * Rounds towards negative infinity
+     */
+    constexpr explicit operator int() const
+    {
+        return static_cast<int>(m_raw >> FRACTION_BITS);
+    }
+
+    constexpr auto operator<=>(const Fixed&) const = default;
+
+    constexpr Fixed operator-() const
+    {
+        return fromRaw(wrap(0 - static_cast<uint64_t>(m_raw)));
+    }
+
+    // hidden friends so `2 * value` works as well as `value * 2`
+
+    friend constexpr Fixed operator+(Fixed a, Fixed b)
+    {
+        return fromRaw(wrap(static_cast<uint64_t>(a.m_raw) + static_cast<uint64_t>(b.m_raw)));
+    }
+
+    friend constexpr Fixed operator-(Fixed a, Fixed b)
+    {
+        return fromRaw(wrap(static_cast<uint64_t>(a.m_raw) - static_cast<uint64_t>(b.m_raw)));
+    }
+
+    friend constexpr Fixed operator*(Fixed a, Fixed b)
+    {
+        // right shift of negative numbers is arithmetic since C++20
+        return fromRaw(wrap(static_cast<uint64_t>(a.m_raw) * static_cast<uint64_t>(b.m_raw)) >> FRACTION_BITS);
+    }
+
+    friend constexpr Fixed operator/(Fixed a, Fixed b)
+    {
+        assert(b.m_raw != 0);
+        return fromRaw(wrap(static_cast<uint64_t>(a.m_raw) << FRACTION_BITS) / b.m_raw);
+    }
+
+    constexpr Fixed& operator+=(Fixed other)
+    {
+        return *this = *this + other;
+    }
+
+    constexpr Fixed& operator-=(Fixed other)
+    {
+        return *this = *this - other;
+    }
+
+    constexpr Fixed& operator*=(Fixed other)
+    {
+        return *this = *this * other;
+    }
+
+    constexpr Fixed& operator/=(Fixed other)
+    {
+        return *this = *this / other;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, Fixed value)
+    {
+        os << value.toFloat();
+        return os;
+    }
+
+private:
+    int64_t m_raw = 0;
+
+    /**
+     * Conversion from unsigned to signed is modular since C++20, so this never overflows
+     */
+    static constexpr int64_t wrap(uint64_t value)
+    {
+        return static_cast<int64_t>(value);
+    }
+};
+
+namespace FixedConstants
+{
+// rounded from the real values so they're the same everywhere
+inline constexpr Fixed PI = Fixed::fromRaw(205887);
+inline constexpr Fixed HALF_PI = Fixed::fromRaw(102944);
+inline constexpr Fixed TWO_PI = Fixed::fromRaw(411775);
+};
+
+[[nodiscard]] constexpr Fixed abs(Fixed value)
+{
+    return value < 0 ? -value : value;
+}
+
+/**
+ * Integer square root, rounded down
+ */
+[[nodiscard]] constexpr Fixed sqrt(Fixed value)
+{
+    assert(value >= 0);
+    if (value <= 0) {
+        return 0;
+    }
+
+    // sqrt(raw / ONE) * ONE == sqrt(raw * ONE)
+    uint64_t num = static_cast<uint64_t>(value.raw()) << Fixed::FRACTION_BITS;
+    uint64_t result = 0;
+    uint64_t bit = uint64_t{1} << 62;
+
+    while (bit > num) {
+        bit >>= 2;
+    }
+
+    while (bit != 0) {
+        if (num >= result + bit) {
+            num -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return Fixed::fromRaw(static_cast<int64_t>(result));
+}
+
+/**
+ * Deterministic sine, accurate to about 1 / 65536
+ */
+[[nodiscard]] constexpr Fixed sin(Fixed angle)
+{
+    using namespace FixedConstants;
+
+    // wrap to [-PI, PI]
+    int64_t raw = angle.raw() % TWO_PI.raw();
+    if (raw > PI.raw()) {
+        raw -= TWO_PI.raw();
+    } else if (raw < -PI.raw()) {
+        raw += TWO_PI.raw();
+    }
+
+    // sin(PI - x) == sin(x) so fold to [-PI / 2, PI / 2] where the series converges quickly
+    if (raw > HALF_PI.raw()) {
+        raw = PI.raw() - raw;
+    } else if (raw < -HALF_PI.raw()) {
+        raw = -PI.raw() - raw;
+    }
+
+    // taylor series up to x^9 with 30 fractional bits for the intermediate values
+    constexpr int SHIFT = 30;
+    constexpr int64_t ONE_30 = int64_t{1} << SHIFT;
+
+    int64_t x = raw << (SHIFT - Fixed::FRACTION_BITS);
+    int64_t x2 = (x * x) >> SHIFT;
+
+    // x * (1 - x^2 / 6 * (1 - x^2 / 20 * (1 - x^2 / 42 * (1 - x^2 / 72))))
+    int64_t term = ONE_30 - (x2 / 72);
+    term = ONE_30 - (((x2 * term) >> SHIFT) / 42);
+    term = ONE_30 - (((x2 * term) >> SHIFT) / 20);
+    term = ONE_30 - (((x2 * term) >> SHIFT) / 6);
+
+    int64_t result = (x * term) >> SHIFT;
+
+    // round back to 16 fractional bits
+    constexpr int DROP = SHIFT - Fixed::FRACTION_BITS;
+    return Fixed::fromRaw((result + (int64_t{1} << (DROP - 1))) >> DROP);
+}
+
+[[nodiscard]] constexpr Fixed cos(Fixed angle)
+{
+    return sin(angle + FixedConstants::HALF_PI);
+}
+
+template<>
+struct std::numeric_limits<Fixed>
+{
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = false;
+    static constexpr bool is_exact = true;
+
+    /**
+     * Smallest positive value
+     */
+    static constexpr Fixed min() noexcept
+    {
+        return Fixed::fromRaw(1);
+    }
+
+    static constexpr Fixed max() noexcept
+    {
+        return Fixed::fromRaw(std::numeric_limits<int64_t>::max());
+    }
+
+    static constexpr Fixed lowest() noexcept
+    {
+        return -max();
+    }
+
+    static constexpr Fixed epsilon() noexcept
+    {
+        return Fixed::fromRaw(1);
+    }
+};
+
+using Vec2Fx = Vec2<Fixed>;
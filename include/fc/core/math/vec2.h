@@ -72,12 +72,30 @@ public:
     }
 
     Vec2& rotate(float rad)
+        requires(std::is_arithmetic_v<VecT>)
     {
         const VecT cosr = std::cos(rad);
         const VecT sinr = std::sin(rad);
 
-        x = x * cosr - y * sinr;
-        y = x * sinr + y * cosr;
+        const VecT oldX = x;
+        x = oldX * cosr - y * sinr;
+        y = oldX * sinr + y * cosr;
+
+        return *this;
+    }
+
+    /**
+     * For number types like Fixed that have their own sin and cos
+     */
+    Vec2& rotate(VecT rad)
+        requires(!std::is_arithmetic_v<VecT>)
+    {
+        const VecT cosr = cos(rad);
+        const VecT sinr = sin(rad);
+
+        const VecT oldX = x;
+        x = oldX * cosr - y * sinr;
+        y = oldX * sinr + y * cosr;
 
         return *this;
     }
@@ -101,7 +119,7 @@ public:
     {
         const VecT len = length();
 
-        if (len > VEC2_EPSILON) {
+        if (len > VecT(VEC2_EPSILON)) {
             x /= len;
             y /= len;
         }
@@ -111,7 +129,7 @@ public:
 
     Vec2& normalize(VecT length)
     {
-        if (length > VEC2_EPSILON) {
+        if (length > VecT(VEC2_EPSILON)) {
             x /= length;
             y /= length;
         }
@@ -123,7 +141,7 @@ public:
     {
         const VecT len = length();
 
-        if (len > VEC2_EPSILON) {
+        if (len > VecT(VEC2_EPSILON)) {
             x /= len;
             y /= len;
         } else {
@@ -141,7 +159,8 @@ public:
 
     [[nodiscard]] VecT length() const
     {
-        return std::sqrt(lengthSqr());
+        using std::sqrt;
+        return sqrt(lengthSqr());
     }
 
     [[nodiscard]] VecT distanceTo(const Vec2& a) const
@@ -154,6 +173,14 @@ public:
         return x * a.x + y * a.y;
     }
 
+    /**
+     * 2D cross product, the z component of the 3D cross product
+     */
+    [[nodiscard]] VecT cross(const Vec2& a) const
+    {
+        return x * a.y - y * a.x;
+    }
+
     [[nodiscard]] static Vec2 min(const Vec2& a, const Vec2& b)
     {
         return {std::min(a.x, b.x), std::min(a.y, b.y)};
@@ -170,9 +197,10 @@ public:
     }
 
     [[nodiscard]] bool equals(const Vec2& a, VecT epsilon) const
-        requires(std::is_floating_point_v<VecT>)
+        requires(!std::is_integral_v<VecT>)
     {
-        return std::abs(x - a.x) <= epsilon && std::abs(y - a.y) <= epsilon;
+        using std::abs;
+        return abs(x - a.x) <= epsilon && abs(y - a.y) <= epsilon;
     }
 
     bool operator==(const Vec2& a) const
@@ -277,6 +305,12 @@ public:
         return std::format("X:    {}, Y:    {}", x, y);
     }
 
+    [[nodiscard]] std::string toString() const
+        requires(!std::is_arithmetic_v<VecT>)
+    {
+        return std::format("X: {0:.4f}, Y: {1:.4f}", static_cast<float>(x), static_cast<float>(y));
+    }
+
     friend std::ostream& operator<<(std::ostream& os, const Vec2& vec)
     {
         os << vec.toString();
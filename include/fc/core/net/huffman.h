@@ -0,0 +1,110 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#pragma once
+
+#include "fc/core/bitStream.h"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * Static Huffman model of packet bytes, trained once from recorded traffic and shared by the server and clients.
+ *
+ * Small packets are too short for adaptive compressors (deflate) to learn anything,
+ * a model known up front compresses them from the first byte.
+ * Codes are at most MAX_CODE_BITS long so decoding is a single table lookup per byte.
+ *
+ * @example
+ * ```
+ *   // offline, from recorded packets
+ *   HuffmanModel::ByteCounts counts{};
+ *   for (const auto& packet : recording) {
+ *       HuffmanModel::count(counts, packet);
+ *   }
+ *   HuffmanModel model(counts);
+ *   save(model.codeLengths());
+ *
+ *   // server
+ *   model.compress(out, packet.takeBytes());
+ *
+ *   // client
+ *   HuffmanModel model = HuffmanModel::fromCodeLengths(load());
+ *   model.decompress(in, packet);
+ * ```
+ */
+class HuffmanModel
+{
+public:
+    static constexpr uint8_t MAX_CODE_BITS = 12;
+
+    using ByteCounts = std::array<uint64_t, 256>;
+    using CodeLengths = std::array<uint8_t, 256>;
+
+    /**
+     * Adds the bytes of a recorded packet to `counts`
+     */
+    static void count(ByteCounts& counts, std::span<const uint8_t> packet);
+
+    /**
+     * Every byte gets a code even if it was never seen, so any packet can be compressed
+     */
+    explicit HuffmanModel(const ByteCounts& counts);
+
+    /**
+     * Rebuilds a model from the code lengths of a trained one
+     *
+     * @throws std::invalid_argument if the lengths aren't the ones of a complete code of at most MAX_CODE_BITS
+     */
+    [[nodiscard]] static HuffmanModel fromCodeLengths(const CodeLengths& lengths);
+
+    [[nodiscard]] const CodeLengths& codeLengths() const
+    {
+        return m_lengths;
+    }
+
+    /**
+     * Size of `bytes` once encoded, without the header compress adds
+     */
+    [[nodiscard]] size_t encodedBits(std::span<const uint8_t> bytes) const;
+
+    /**
+     * Writes a flag, the byte count then the encoded bytes,
+     * or the raw bytes if encoding them would be bigger (e.g already compressed data)
+     */
+    void compress(BitStream& stream, std::span<const uint8_t> bytes) const;
+
+    /**
+     * @param bytes Replaced by the decompressed bytes
+     *
+     * @throws std::out_of_range if the stream ends early
+     */
+    void decompress(BitStream& stream, std::vector<uint8_t>& bytes) const;
+
+private:
+    HuffmanModel() = default;
+
+    /**
+     * Bit reversed canonical codes, BitStream writes least significant bits first
+     */
+    void buildCodes();
+
+    struct TableEntry
+    {
+        uint8_t byte;
+        uint8_t length;
+    };
+
+    CodeLengths m_lengths{};
+    std::array<uint16_t, 256> m_codes{};
+
+    /**
+     * Indexed by the next MAX_CODE_BITS bits of the stream
+     */
+    std::vector<TableEntry> m_table;
+};
@@ -0,0 +1,118 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#pragma once
+
+#include "fc/core/collision/grid.h"
+#include "fc/core/math/vec2.h"
+#include "fc/core/net/snapshot.h"
+#include "fc/core/threadPool.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Area of interest, which entities each client needs to hear about.
+ * A client sees the entities in the grid cells overlapping its view, so visibility is cell granular.
+ *
+ * Every update diffs each client's visible entities against the last update:
+ * entered ones are new to the client, left ones should be removed and kept ones only need their changes.
+ * Filtering the world snapshot per client and giving each client its own SnapshotEncoder
+ * turns entered into full entities and left into removals on the wire.
+ *
+ * @example
+ * ```
+ *   // every tick, after the grid is updated
+ *   interest.update(grid, &pool);
+ *   for (auto& client : clients) {
+ *       interest.filter(client.id, worldSnapshot, client.encoder.next(tick));
+ *       client.encoder.write(stream, client.ackedTick);
+ *   }
+ * ```
+ */
+class InterestManager
+{
+public:
+    using ClientID = uint32_t;
+    using EntityID = Snapshot::EntityID;
+    using SpatialGrid = Grid<uint32_t, EntityID>;
+
+    /**
+     * @param maxClientID The biggest client ID, IDs start at 1
+     */
+    explicit InterestManager(ClientID maxClientID);
+
+    /**
+     * Sets or moves the view of a client, a new client sees everything in view as entered on the next update
+     */
+    void setView(ClientID client, Vec2F min, Vec2F max);
+
+    void removeClient(ClientID client);
+
+    [[nodiscard]] bool hasClient(ClientID client) const
+    {
+        return client < m_clients.size() && m_clients[client].active;
+    }
+
+    /**
+     * Recomputes what every client sees, the clients are split across the pool's threads if there's one.
+     * The grid mustn't change during the update
+     */
+    void update(const SpatialGrid& grid, ThreadPool* pool = nullptr);
+
+    /**
+     * Sorted by ID, like each of the sets below
+     */
+    [[nodiscard]] const std::vector<EntityID>& visible(ClientID client) const
+    {
+        return m_clients[client].visible;
+    }
+
+    [[nodiscard]] const std::vector<EntityID>& entered(ClientID client) const
+    {
+        return m_clients[client].entered;
+    }
+
+    [[nodiscard]] const std::vector<EntityID>& left(ClientID client) const
+    {
+        return m_clients[client].left;
+    }
+
+    /**
+     * Visible in the last update and this one
+     */
+    [[nodiscard]] const std::vector<EntityID>& kept(ClientID client) const
+    {
+        return m_clients[client].kept;
+    }
+
+    /**
+     * Clears `out` to the tick of `world` and adds the entities of `world` the client sees
+     */
+    void filter(ClientID client, const Snapshot& world, Snapshot& out) const;
+
+private:
+    struct Client
+    {
+        bool active = false;
+        Vec2F min;
+        Vec2F max;
+
+        std::vector<EntityID> visible;
+        std::vector<EntityID> entered;
+        std::vector<EntityID> left;
+        std::vector<EntityID> kept;
+
+        /**
+         * The last update's visible entities, swapped with `visible` so neither allocates once warmed up
+         */
+        std::vector<EntityID> previous;
+    };
+
+    std::vector<Client> m_clients;
+
+    static void updateClient(Client& client, const SpatialGrid& grid);
+};
@@ -0,0 +1,203 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#pragma once
+
+#include "fc/core/bitStream.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Picks which entity updates go in a client's packet when they don't all fit its bandwidth budget.
+ *
+ * Every tick each entity the client is interested in adds its priority (relevance, closeness, etc),
+ * so the longer an entity waits the more likely it's sent and even unimportant ones get their turn.
+ * Writing fills the budget with the highest accumulated priorities first and resets the ones that were sent.
+ * Use one per client.
+ *
+ * Wire format, repeated until a 0 bit: a 1 bit, the entity ID in `idBits()` bits then the entity as written by the callback.
+ *
+ * @example
+ * ```
+ *   // every tick
+ *   for (EntityID id : interest.visible(client)) {
+ *       float distance = entities[id].position.distanceTo(player.position);
+ *       accumulator.accumulate(id, PriorityAccumulator::byDistance(entities[id].relevance, distance, 500));
+ *   }
+ *   for (EntityID id : interest.left(client)) {
+ *       accumulator.remove(id);
+ *   }
+ *
+ *   // 1200 bytes per packet
+ *   accumulator.write(stream, 1200 * 8, [&](BitStream& stream, EntityID id) {
+ *       EntitySchema::write(stream, entities[id]);
+ *   });
+ * ```
+ */
+class PriorityAccumulator
+{
+public:
+    using EntityID = uint32_t;
+
+    explicit PriorityAccumulator(EntityID maxEntityID);
+
+    /**
+     * `relevance` at distance 0, half of it at `halfDistance`, a quarter at 3 times `halfDistance`, etc
+     */
+    [[nodiscard]] static float byDistance(float relevance, float distance, float halfDistance)
+    {
+        return relevance * halfDistance / (halfDistance + distance);
+    }
+
+    /**
+     * Adds to the entity's priority, priorities of 0 or less are ignored
+     */
+    void accumulate(EntityID id, float priority);
+
+    /**
+     * Drops what the entity accumulated, e.g when it leaves the client's interest
+     */
+    void remove(EntityID id);
+
+    [[nodiscard]] float priority(EntityID id) const
+    {
+        return m_priorities.at(id);
+    }
+
+    /**
+     * Bits of each ID on the wire
+     */
+    [[nodiscard]] uint8_t idBits() const
+    {
+        return m_idBits;
+    }
+
+    /**
+     * Entities waiting to be sent
+     */
+    [[nodiscard]] size_t pendingCount() const
+    {
+        return m_queue.size();
+    }
+
+    /**
+     * Writes entities by highest priority until `budgetBits` are used, one that doesn't fit is rolled back
+     * and smaller ones after it can still take the space left, until it's smaller than any entity tried.
+     *
+     * @param writeEntity Called as `writeEntity(stream, id)` for each entity
+     * @throws std::invalid_argument if `budgetBits` is 0, there's no room for the end marker
+     * @throws std::out_of_range if the stream isn't growable and can't hold `budgetBits` more bits.
+     *         An entity is written before it's known not to fit, so a fixed stream also needs room for one past the budget
+     * @return How many entities were written
+     */
+    template<typename WriteFn>
+    size_t write(BitStream& stream, size_t budgetBits, WriteFn&& writeEntity);
+
+    /**
+     * Reads what `write` wrote
+     *
+     * @param readEntity Called as `readEntity(stream, id)` for each entity, it must read what `writeEntity` wrote
+     * @return How many entities were read
+     */
+    template<typename ReadFn>
+    static size_t read(BitStream& stream, uint8_t idBits, ReadFn&& readEntity);
+
+private:
+    std::vector<float> m_priorities;
+
+    /**
+     * Entities with a priority, `m_queued` tells which ones so they're only in it once
+     */
+    std::vector<EntityID> m_queue;
+    std::vector<uint8_t> m_queued;
+
+    uint8_t m_idBits;
+
+    /**
+     * Sorts by highest priority first
+     */
+    void sortQueue();
+
+    /**
+     * Drops the sent and removed entities, they're the ones with a priority of 0
+     */
+    void markSent();
+};
+
+template<typename WriteFn>
+size_t PriorityAccumulator::write(BitStream& stream, size_t budgetBits, WriteFn&& writeEntity)
+{
+    if (budgetBits == 0) {
+        throw std::invalid_argument("PriorityAccumulator: the budget needs at least a bit for the end marker");
+    }
+
+    size_t start = stream.bitIndex();
+    if (!stream.isGrowable() && budgetBits > stream.bitSize() - start) {
+        throw std::out_of_range(
+            std::format(
+                "PriorityAccumulator: budget of {} bits doesn't fit in the {} bits left",
+                budgetBits,
+                stream.bitSize() - start
+            )
+        );
+    }
+
+    // the end marker always has a bit saved for it
+    size_t end = start + budgetBits - 1;
+
+    sortQueue();
+
+    // once what's left is smaller than every entity tried so far the rest likely won't fit either,
+    // trying each of them would cost more than the few bits it could save
+    size_t smallest = 1 + m_idBits;
+    bool triedAny = false;
+
+    size_t written = 0;
+    for (EntityID id : m_queue) {
+        if (end - stream.bitIndex() < smallest) {
+            break;
+        }
+
+        size_t before = stream.bitIndex();
+        stream.writeBool(true);
+        stream.writeBits(id, m_idBits);
+        writeEntity(stream, id);
+        size_t size = stream.bitIndex() - before;
+        smallest = triedAny ? std::min(smallest, size) : size;
+        triedAny = true;
+
+        // writes overwrite the bits under them, moving back is enough to undo it
+        if (stream.bitIndex() > end) {
+            stream.setBitIndex(before);
+            continue;
+        }
+
+        m_priorities[id] = 0;
+        written++;
+    }
+
+    stream.writeBool(false);
+    markSent();
+    return written;
+}
+
+template<typename ReadFn>
+size_t PriorityAccumulator::read(BitStream& stream, uint8_t idBits, ReadFn&& readEntity)
+{
+    size_t count = 0;
+    while (stream.readBool()) {
+        EntityID id = stream.readBits<EntityID>(idBits);
+        readEntity(stream, id);
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,181 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#pragma once
+
+#include "fc/core/bitStream.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+//
+// Fields of a Schema, each one reads / writes a member of the message with a fixed number of bits
+//
+
+template<typename T, auto Member>
+using SchemaMemberType = std::remove_cvref_t<decltype(std::declval<T&>().*Member)>;
+
+/**
+ * Integer member, signed values are sign extended when read
+ */
+template<auto Member, uint8_t Bits>
+struct IntField
+{
+    static constexpr size_t BITS = Bits;
+
+    template<typename T>
+    static void write(BitStream::UncheckedWriter& writer, const T& message)
+    {
+        static_assert(std::is_integral_v<SchemaMemberType<T, Member>>);
+        static_assert(Bits > 0 && Bits <= sizeof(SchemaMemberType<T, Member>) * 8);
+
+        writer.writeBits(message.*Member, Bits);
+    }
+
+    template<typename T>
+    static void read(BitStream::UncheckedReader& reader, T& message)
+    {
+        message.*Member = reader.template readBits<SchemaMemberType<T, Member>>(Bits);
+    }
+};
+
+template<auto Member>
+struct BoolField
+{
+    static constexpr size_t BITS = 1;
+
+    template<typename T>
+    static void write(BitStream::UncheckedWriter& writer, const T& message)
+    {
+        writer.writeBool(message.*Member);
+    }
+
+    template<typename T>
+    static void read(BitStream::UncheckedReader& reader, T& message)
+    {
+        message.*Member = reader.readBool();
+    }
+};
+
+/**
+ * Float member quantized to `Bits` bits in [Min, Max], values outside of it are clamped.
+ * The round trip error is at most half a step: `(Max - Min) / (2^Bits - 1) / 2`
+ */
+template<auto Member, float Min, float Max, uint8_t Bits>
+struct FloatField
+{
+    static_assert(Min < Max);
+    static_assert(Bits > 0 && Bits <= 32);
+
+    static constexpr size_t BITS = Bits;
+    static constexpr double STEPS = static_cast<double>((uint64_t{1} << Bits) - 1);
+
+    template<typename T>
+    static void write(BitStream::UncheckedWriter& writer, const T& message)
+    {
+        double t = std::clamp((static_cast<double>(message.*Member) - Min) / (static_cast<double>(Max) - Min), 0.0, 1.0);
+        writer.writeBits(static_cast<uint32_t>((t * STEPS) + 0.5), Bits);
+    }
+
+    template<typename T>
+    static void read(BitStream::UncheckedReader& reader, T& message)
+    {
+        double t = reader.template readBits<uint32_t>(Bits) / STEPS;
+        message.*Member = static_cast<float>(Min + (t * (static_cast<double>(Max) - Min)));
+    }
+};
+
+/**
+ * Message layout declared once, the encoder and decoder are both generated from it
+ * and the size of a message is known at compile time.
+ *
+ * A message is written with a single size check then every field goes through the unchecked writer,
+ * with the bit widths as constants the field writes are inlined into a few shifts per word.
+ *
+ * @example
+ * ```
+ *   struct Move
+ *   {
+ *       uint16_t id;
+ *       float x;
+ *       float y;
+ *       bool jumping;
+ *   };
+ *
+ *   using MoveSchema = Schema<
+ *       Move,
+ *       IntField<&Move::id, 12>,
+ *       FloatField<&Move::x, 0.0f, 1024.0f, 16>,
+ *       FloatField<&Move::y, 0.0f, 1024.0f, 16>,
+ *       BoolField<&Move::jumping>>;
+ *
+ *   static_assert(MoveSchema::BITS == 45);
+ *
+ *   MoveSchema::write(stream, move);
+ *   Move read = MoveSchema::read(stream);
+ * ```
+ */
+template<typename T, typename... Fields>
+struct Schema
+{
+    static constexpr size_t BITS = (Fields::BITS + ... + 0);
+
+    /**
+     * @throws std::out_of_range if a fixed stream doesn't have BITS bits left
+     */
+    static void write(BitStream& stream, const T& message)
+    {
+        BitStream::UncheckedWriter writer(stream, BITS);
+        (Fields::write(writer, message), ...);
+    }
+
+    /**
+     * All the messages with a single size check
+     *
+     * @throws std::out_of_range if a fixed stream doesn't have BITS bits left for each message
+     */
+    static void write(BitStream& stream, std::span<const T> messages)
+    {
+        BitStream::UncheckedWriter writer(stream, BITS * messages.size());
+        for (const T& message : messages) {
+            (Fields::write(writer, message), ...);
+        }
+    }
+
+    /**
+     * Only the members in the schema are read, the others are left as is
+     *
+     * @throws std::out_of_range if the stream doesn't have BITS bits left
+     */
+    static void read(BitStream& stream, T& message)
+    {
+        BitStream::UncheckedReader reader(stream, BITS);
+        (Fields::read(reader, message), ...);
+    }
+
+    /**
+     * @throws std::out_of_range if the stream doesn't have BITS bits left for each message
+     */
+    static void read(BitStream& stream, std::span<T> messages)
+    {
+        BitStream::UncheckedReader reader(stream, BITS * messages.size());
+        for (T& message : messages) {
+            (Fields::read(reader, message), ...);
+        }
+    }
+
+    [[nodiscard]] static T read(BitStream& stream)
+        requires(std::is_default_constructible_v<T>)
+    {
+        T message{};
+        read(stream, message);
+        return message;
+    }
+};
@@ -0,0 +1,230 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#pragma once
+
+#include "fc/core/bitStream.h"
+
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+/**
+ * State of every entity at one tick, each entity is a fixed number of integer fields
+ * (quantized positions, health, animation frame, etc).
+ * Entities are kept sorted by ID so two snapshots can be compared in a single pass.
+ */
+class Snapshot
+{
+public:
+    using EntityID = uint32_t;
+
+    explicit Snapshot(size_t fieldCount = 0) : m_fieldCount(fieldCount)
+    {
+    }
+
+    /**
+     * Removes every entity, keeping the memory for the next tick
+     */
+    void clear(uint32_t tick)
+    {
+        m_tick = tick;
+        m_ids.clear();
+        m_fields.clear();
+    }
+
+    /**
+     * @note IDs have to be added in increasing order
+     */
+    void add(EntityID id, std::span<const uint32_t> fields)
+    {
+        assert(fields.size() == m_fieldCount);
+        assert(m_ids.empty() || id > m_ids.back());
+
+        m_ids.push_back(id);
+        m_fields.insert(m_fields.end(), fields.begin(), fields.end());
+    }
+
+    [[nodiscard]] uint32_t tick() const
+    {
+        return m_tick;
+    }
+
+    [[nodiscard]] size_t fieldCount() const
+    {
+        return m_fieldCount;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_ids.size();
+    }
+
+    [[nodiscard]] EntityID id(size_t index) const
+    {
+        return m_ids[index];
+    }
+
+    [[nodiscard]] std::span<const uint32_t> fields(size_t index) const
+    {
+        return {m_fields.data() + (index * m_fieldCount), m_fieldCount};
+    }
+
+    /**
+     * @return The fields of the entity or an empty span if it isn't in the snapshot
+     */
+    [[nodiscard]] std::span<const uint32_t> find(EntityID id) const;
+
+    void swap(Snapshot& other) noexcept
+    {
+        std::swap(m_tick, other.m_tick);
+        std::swap(m_fieldCount, other.m_fieldCount);
+        m_ids.swap(other.m_ids);
+        m_fields.swap(other.m_fields);
+    }
+
+private:
+    uint32_t m_tick = 0;
+    size_t m_fieldCount;
+    std::vector<EntityID> m_ids;
+    std::vector<uint32_t> m_fields;
+};
+
+/**
+ * Last snapshots by tick, so deltas can be made against whichever one a client acknowledged
+ */
+class SnapshotHistory
+{
+public:
+    SnapshotHistory(size_t fieldCount, size_t capacity);
+
+    /**
+     * Reuses the slot of the oldest snapshot for `tick`, its previous entities are cleared
+     */
+    [[nodiscard]] Snapshot& next(uint32_t tick);
+
+    /**
+     * @return The snapshot of `tick` or nullptr if it's too old or was never added
+     */
+    [[nodiscard]] const Snapshot* find(uint32_t tick) const;
+
+    /**
+     * Moves `snapshot` in the slot of its tick, the slot's previous snapshot is left in `snapshot`
+     *
+     * @return The snapshot in the history
+     */
+    const Snapshot& swapIn(Snapshot& snapshot);
+
+private:
+    std::vector<Snapshot> m_snapshots;
+    std::vector<bool> m_used;
+};
+
+/**
+ * Writes snapshots as deltas against an older snapshot the client acknowledged.
+ *
+ * Only entities that changed are written, with a mask of their changed fields then only those fields.
+ * Entities that aren't in the baseline are written against all zero fields, removed entities are written as IDs.
+ * Unchanged entities cost nothing so mostly static worlds send mostly empty packets.
+ *
+ * Each client acknowledges the ticks it received and the server keeps its last acknowledged tick,
+ * if that tick fell out of the history (or there's none yet) the full snapshot is written.
+ *
+ * @example
+ * ```
+ *   SnapshotEncoder encoder({12, 12, 7}, 32);
+ *
+ *   // every tick
+ *   Snapshot& snapshot = encoder.next(tick);
+ *   for (const auto& entity : entities) {
+ *       snapshot.add(entity.id, std::array{entity.x, entity.y, entity.health});
+ *   }
+ *   for (auto& client : clients) {
+ *       BitStream stream(pool);
+ *       encoder.write(stream, client.ackedTick);
+ *       client.send(stream.takeBytes());
+ *   }
+ * ```
+ */
+class SnapshotEncoder
+{
+public:
+    /**
+     * Tick to pass to `write` when the client didn't acknowledge anything yet
+     */
+    static constexpr uint32_t NO_BASELINE = UINT32_MAX;
+    static constexpr size_t MAX_FIELDS = 32;
+
+    /**
+     * @param fieldBits Bits of each field, at most 32 each
+     * @param historySize How many ticks back a client's acknowledged tick can be used as a baseline
+     */
+    SnapshotEncoder(std::vector<uint8_t> fieldBits, size_t historySize);
+
+    /**
+     * Snapshot of the new tick to fill, the following writes are of this snapshot
+     */
+    [[nodiscard]] Snapshot& next(uint32_t tick);
+
+    /**
+     * Writes the last snapshot as a delta against the snapshot of `ackedTick`
+     *
+     * @return If it could be written as a delta, false if the full snapshot was written
+     */
+    bool write(BitStream& stream, uint32_t ackedTick);
+
+    [[nodiscard]] const std::vector<uint8_t>& fieldBits() const
+    {
+        return m_fieldBits;
+    }
+
+private:
+    struct Change
+    {
+        Snapshot::EntityID id;
+        uint32_t index;
+        uint32_t mask;
+    };
+
+    std::vector<uint8_t> m_fieldBits;
+    SnapshotHistory m_history;
+    const Snapshot* m_current = nullptr;
+
+    // scratch lists, kept between writes so they don't allocate
+    std::vector<Change> m_changes;
+    std::vector<Snapshot::EntityID> m_removed;
+};
+
+/**
+ * Rebuilds the snapshots written by SnapshotEncoder, it keeps the ones it read as baselines for the next deltas.
+ * Acknowledge the tick of each snapshot read to the server so it uses it as a baseline.
+ */
+class SnapshotDecoder
+{
+public:
+    /**
+     * @param fieldBits Same as the encoder's
+     * @param historySize Same or more than the encoder's
+     */
+    SnapshotDecoder(std::vector<uint8_t> fieldBits, size_t historySize);
+
+    /**
+     * @throws std::runtime_error if the baseline isn't in the history anymore
+     * @throws std::out_of_range if the stream ends early
+     */
+    const Snapshot& read(BitStream& stream);
+
+private:
+    std::vector<uint8_t> m_fieldBits;
+    SnapshotHistory m_history;
+
+    // decoded apart from the history so the new snapshot can't overwrite its own baseline
+    Snapshot m_decoded;
+    std::vector<Snapshot::EntityID> m_removed;
+    std::vector<uint32_t> m_scratchFields;
+};
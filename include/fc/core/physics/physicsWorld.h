@@ -0,0 +1,348 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#pragma once
+
+#include "fc/core/collision/collision.h"
+#include "fc/core/collision/contactCache.h"
+#include "fc/core/collision/grid.h"
+#include "fc/core/collision/shape.h"
+#include "fc/core/idPool.h"
+#include "fc/core/math/vec2.h"
+#include "fc/core/threadPool.h"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Rigid body simulation on top of the collision shapes.
+ *
+ * Bodies are stored as arrays of each property (velocities, masses, etc) indexed by body ID,
+ * the Grid is used for the broadphase and contacts are resolved with a sequential impulse solver.
+ *
+ * Groups of touching bodies (islands) that stay still for a while are put to sleep,
+ * sleeping bodies are not integrated, re-inserted in the grid or tested against each other.
+ * They wake up when an awake moving body hits them or when their velocity is changed.
+ *
+ * Contacts are split into colors where no 2 contacts share an awake body,
+ * each color can then be solved in parallel without locks.
+ * Colors are always solved in the same order so the results don't depend on the thread count.
+ *
+ * @note Rect shapes are axis aligned so they never rotate.
+ */
+class PhysicsWorld
+{
+public:
+    using BodyID = uint32_t;
+
+    struct Config
+    {
+        /**
+         * Width and height of the world, bodies outside of it are clamped to the grid edges
+         */
+        uint32_t worldSize = 1024;
+        uint32_t cellSize = 32;
+        BodyID maxBodies = 1024;
+
+        Vec2F gravity;
+
+        uint8_t velocityIterations = 8;
+        /**
+         * Extra threads used to solve contacts, 0 solves everything on the calling thread
+         */
+        uint32_t solverThreads = 0;
+
+        /**
+         * How much of the penetration is fixed each step
+         */
+        float baumgarte = 0.2F;
+        /**
+         * Penetration allowed before it gets fixed, avoids jitter on resting contacts
+         */
+        float penetrationSlop = 0.01F;
+        /**
+         * Contacts hitting slower than this don't bounce
+         */
+        float restitutionThreshold = 1.F;
+
+        /**
+         * Bodies moving slower than this are considered resting
+         */
+        float sleepVelocity = 1.F;
+        float sleepAngularVelocity = 0.05F;
+        /**
+         * How long a whole island has to rest before going to sleep, in seconds
+         */
+        float timeToSleep = 0.5F;
+    };
+
+    struct BodyDef
+    {
+        /**
+         * 0 for static bodies that never move
+         */
+        float mass = 1.F;
+        float restitution = 0.F;
+        float friction = 0.4F;
+
+        Vec2F velocity;
+        float angularVelocity = 0.F;
+
+        /**
+         * Prevents the body from rotating from collisions
+         */
+        bool fixedRotation = false;
+    };
+
+    explicit PhysicsWorld(const Config& config);
+
+    PhysicsWorld(const PhysicsWorld&) = delete;
+    PhysicsWorld& operator=(const PhysicsWorld&) = delete;
+
+    /**
+     * @throws std::runtime_error if there's no IDs left
+     */
+    BodyID addBody(std::unique_ptr<Shape> shape, const BodyDef& def);
+
+    void removeBody(BodyID id);
+
+    void step(float dt);
+
+    [[nodiscard]] const Shape& shape(BodyID id) const
+    {
+        assert(isValid(id));
+        return *m_shapes[id];
+    }
+
+    /**
+     * @note call bodyMoved after moving the shape so the grid is updated
+     */
+    [[nodiscard]] Shape& shape(BodyID id)
+    {
+        assert(isValid(id));
+        return *m_shapes[id];
+    }
+
+    /**
+     * Re-insert a body in the grid and wake it up, call after changing its shape manually
+     */
+    void bodyMoved(BodyID id);
+
+    [[nodiscard]] Vec2F velocity(BodyID id) const
+    {
+        assert(isValid(id));
+        return m_velocities[id];
+    }
+
+    void setVelocity(BodyID id, Vec2F velocity);
+
+    [[nodiscard]] float angularVelocity(BodyID id) const
+    {
+        assert(isValid(id));
+        return m_angularVelocities[id];
+    }
+
+    void setAngularVelocity(BodyID id, float angularVelocity);
+
+    /**
+     * Total rotation applied to the body since it was added, in radians
+     */
+    [[nodiscard]] float angle(BodyID id) const
+    {
+        assert(isValid(id));
+        return m_angles[id];
+    }
+
+    void applyImpulse(BodyID id, Vec2F impulse);
+
+    [[nodiscard]] bool isValid(BodyID id) const
+    {
+        return id < m_flags.size() && (m_flags[id] & ALIVE) != 0;
+    }
+
+    [[nodiscard]] bool isStatic(BodyID id) const
+    {
+        assert(isValid(id));
+        return m_invMasses[id] == 0;
+    }
+
+    [[nodiscard]] bool isAwake(BodyID id) const
+    {
+        assert(isValid(id));
+        return (m_flags[id] & AWAKE) != 0;
+    }
+
+    void wake(BodyID id);
+
+    /**
+     * Number of bodies simulated on the last step
+     */
+    [[nodiscard]] size_t awakeCount() const
+    {
+        return m_awake.size();
+    }
+
+    /**
+     * Contacts found on the last step, with begin / stay / end events
+     */
+    [[nodiscard]] const ContactCache<BodyID>& contacts() const
+    {
+        return m_contactCache;
+    }
+
+    [[nodiscard]] const Config& config() const
+    {
+        return m_config;
+    }
+
+private:
+    enum Flags : uint8_t {
+        ALIVE = 1 << 0,
+        AWAKE = 1 << 1,
+    };
+
+    struct ContactPoint
+    {
+        /**
+         * Contact point relative to the center of each body
+         */
+        Vec2F relA;
+        Vec2F relB;
+
+        float normalMass;
+        float tangentMass;
+        /**
+         * Target separating velocity, from restitution and penetration correction
+         */
+        float bias;
+
+        float normalImpulse;
+        float tangentImpulse;
+    };
+
+    struct Contact
+    {
+        BodyID a;
+        BodyID b;
+
+        Vec2F normal;
+        float friction;
+        float restitution;
+
+        uint8_t pointCount;
+        std::array<ContactPoint, 2> points;
+    };
+
+    static constexpr uint32_t NOT_AWAKE = UINT32_MAX;
+
+    /**
+     * One bit per color in m_colorMasks,
+     * contacts that don't fit in any color go in an extra color solved on a single thread
+     */
+    static constexpr uint32_t MAX_COLORS = 64;
+    static constexpr uint32_t OVERFLOW_COLOR = MAX_COLORS;
+    /**
+     * Contacts per task when solving a color in parallel
+     */
+    static constexpr size_t SOLVER_GRAIN_SIZE = 64;
+
+    Config m_config;
+
+    IdPool<BodyID> m_idPool;
+    Grid<uint32_t, BodyID> m_grid;
+
+    //
+    // Body data, indexed by body ID
+    //
+
+    std::vector<std::unique_ptr<Shape>> m_shapes;
+    std::vector<Vec2F> m_velocities;
+    std::vector<float> m_angularVelocities;
+    std::vector<float> m_angles;
+    std::vector<float> m_invMasses;
+    std::vector<float> m_invInertias;
+    std::vector<float> m_restitutions;
+    std::vector<float> m_frictions;
+    std::vector<float> m_sleepTimes;
+    std::vector<uint8_t> m_flags;
+
+    /**
+     * Index of each body in m_awake or NOT_AWAKE
+     */
+    std::vector<uint32_t> m_awakeIndices;
+    /**
+     * Parent of each body when building islands, see findIsland
+     */
+    std::vector<BodyID> m_islandParents;
+    std::vector<float> m_islandSleepTimes;
+    /**
+     * Sleeping islands are linked in a ring so waking any body wakes the whole island
+     */
+    std::vector<BodyID> m_sleepLinks;
+
+    /**
+     * Dense list of awake dynamic bodies, the only ones iterated each step
+     */
+    std::vector<BodyID> m_awake;
+
+    /**
+     * Sorted by color after colorContacts
+     */
+    std::vector<Contact> m_contacts;
+    std::vector<Contact> m_sortedContacts;
+    std::vector<uint32_t> m_contactColors;
+    /**
+     * Colors used by the contacts of each awake body
+     */
+    std::vector<uint64_t> m_colorMasks;
+    /**
+     * Contacts of color `i` are in [m_colorOffsets[i], m_colorOffsets[i + 1])
+     */
+    std::array<uint32_t, MAX_COLORS + 2> m_colorOffsets{};
+    std::vector<BodyID> m_toWake;
+
+    ContactCache<BodyID> m_contactCache;
+
+    ThreadPool m_threadPool;
+
+    /**
+     * Impulses from the last step to warm start the solver
+     */
+    std::unordered_map<uint64_t, std::array<float, 4>> m_lastImpulses;
+
+    /**
+     * Treat sleeping bodies as static when solving
+     */
+    [[nodiscard]] float solverInvMass(BodyID id) const
+    {
+        return isAwake(id) ? m_invMasses[id] : 0.F;
+    }
+
+    [[nodiscard]] float solverInvInertia(BodyID id) const
+    {
+        return isAwake(id) ? m_invInertias[id] : 0.F;
+    }
+
+    void setAwake(BodyID id, bool awake);
+
+    void findContacts();
+    void colorContacts();
+    void prepareContacts(float dt);
+    void solveContacts();
+    void solveContact(Contact& contact);
+    void storeImpulses();
+    void applyContactImpulse(const Contact& contact, const ContactPoint& point, Vec2F impulse);
+    void integratePositions(float dt);
+    void updateSleep(float dt);
+
+    BodyID findIsland(BodyID id);
+
+    static float computeInvInertia(const Shape& shape, float mass);
+};
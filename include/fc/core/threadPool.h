@@ -0,0 +1,110 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Fixed set of worker threads for splitting loops across cores.
+ *
+ * The calling thread always takes part in the work,
+ * so a pool with 0 workers runs everything inline and never creates a thread.
+ */
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t workerCount);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    ~ThreadPool();
+
+    [[nodiscard]] size_t workerCount() const
+    {
+        return m_workers.size();
+    }
+
+    /**
+     * Calls `fn(begin, end)` for chunks of `grainSize` indices covering [0, count)
+     * and blocks until every chunk is done.
+     *
+     * Chunks can run in any order and on any thread.
+     * Without workers, or if there's only 1 chunk, the whole range is done in a single call.
+     *
+     * @example
+     * ```
+     *   pool.parallelFor(values.size(), 64, [&](size_t begin, size_t end) {
+     *       for (size_t i = begin; i < end; i++) {
+     *           values[i] *= 2;
+     *       }
+     *   });
+     * ```
+     */
+    template<typename Fn>
+    void parallelFor(size_t count, size_t grainSize, Fn&& fn)
+    {
+        if (grainSize == 0) {
+            grainSize = 1;
+        }
+
+        // not worth waking the workers
+        if (m_workers.empty() || count <= grainSize) {
+            if (count > 0) {
+                fn(size_t{0}, count);
+            }
+            return;
+        }
+
+        run(count, grainSize, [](void* context, size_t begin, size_t end) {
+            (*static_cast<std::remove_reference_t<Fn>*>(context))(begin, end);
+        }, (void*)&fn);
+    }
+
+private:
+    using JobFn = void (*)(void* context, size_t begin, size_t end);
+
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_jobReady;
+    std::condition_variable m_jobDone;
+
+    /**
+     * Incremented for each job so workers know when there's new work
+     */
+    uint64_t m_generation = 0;
+    bool m_stopping = false;
+    /**
+     * Workers still running the current job
+     */
+    size_t m_busyWorkers = 0;
+
+    JobFn m_jobFn = nullptr;
+    void* m_jobContext = nullptr;
+    size_t m_jobCount = 0;
+    size_t m_jobGrain = 0;
+    std::atomic<size_t> m_nextIndex = 0;
+
+    void run(size_t count, size_t grainSize, JobFn fn, void* context);
+
+    /**
+     * Take chunks of the current job until there's none left
+     */
+    void runChunks();
+
+    void workerLoop();
+};
@@ -0,0 +1,84 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+
+/**
+ * When the ticks of a fixed rate simulation are due, given the real time.
+ *
+ * Ticks that are late run back to back to catch up, so the rate holds on average even when wake ups are late.
+ * Falling further behind than `maxCatchUpTicks` (e.g after the machine was suspended) skips ahead instead.
+ *
+ * @example
+ * ```
+ *   TickSchedule schedule(30);
+ *   schedule.start(Ticker::getTime());
+ *
+ *   // whenever the loop wakes up
+ *   double now = Ticker::getTime();
+ *   while (schedule.next(now)) {
+ *       tick(schedule.period());
+ *   }
+ * ```
+ */
+class TickSchedule
+{
+public:
+    explicit TickSchedule(uint32_t rate, uint32_t maxCatchUpTicks = 8) :
+        m_period(rate != 0 ? 1.0 / rate : 0),
+        m_maxCatchUpTicks(maxCatchUpTicks)
+    {
+        if (rate == 0) {
+            throw std::invalid_argument("TickSchedule: rate must be above 0");
+        }
+    }
+
+    /**
+     * The first tick is due right away
+     */
+    void start(double now)
+    {
+        m_nextTime = now;
+    }
+
+    /**
+     * Whether a tick is due at `now`, if so it's counted as run. Call it in a loop until it's false
+     */
+    bool next(double now)
+    {
+        if (now - m_nextTime > m_period * m_maxCatchUpTicks) {
+            m_nextTime = now;
+        }
+
+        if (now < m_nextTime) {
+            return false;
+        }
+
+        m_nextTime += m_period;
+        return true;
+    }
+
+    [[nodiscard]] double period() const
+    {
+        return m_period;
+    }
+
+    /**
+     * When the next tick is due
+     */
+    [[nodiscard]] double nextTime() const
+    {
+        return m_nextTime;
+    }
+
+private:
+    double m_period;
+    uint32_t m_maxCatchUpTicks;
+    double m_nextTime = 0;
+};
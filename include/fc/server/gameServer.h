@@ -0,0 +1,205 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#pragma once
+
+#include "fc/core/bitStream.h"
+#include "fc/core/bufferPool.h"
+#include "fc/core/idPool.h"
+#include "fc/core/tickSchedule.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+
+/**
+ * Headless authoritative game server, WebSocket clients send and receive binary messages
+ * and the simulation runs at a fixed tick rate on the same event loop.
+ *
+ * Subclass it and override the callbacks, they all run on the thread that called `run`.
+ * A message that throws while being read (e.g a truncated BitStream) disconnects its client.
+ *
+ * @example
+ * ```
+ *   class MyServer : public GameServer
+ *   {
+ *       void onTick(uint32_t tick, float dt) override
+ *       {
+ *           simulate(dt);
+ *           for (auto client : m_clients) {
+ *               BitStream stream(bufferPool());
+ *               writeSnapshot(stream, client);
+ *               send(client, stream);
+ *           }
+ *       }
+ *   };
+ *
+ *   MyServer server({.port = 9001, .tickRate = 30});
+ *   server.run();
+ * ```
+ */
+class GameServer
+{
+public:
+    using ClientID = uint32_t;
+
+    struct Config
+    {
+        uint16_t port = 9001;
+        uint32_t tickRate = 30;
+        ClientID maxClients = 256;
+        /**
+         * Bytes queued for a client over which messages to it are dropped instead of queued,
+         * a client that can't keep up gets the next snapshot instead of a growing backlog
+         */
+        uint32_t maxBackpressure = 256 * 1024;
+        uint32_t maxMessageSize = 16 * 1024;
+        /**
+         * Seconds without receiving anything before a client is disconnected
+         */
+        uint16_t idleTimeout = 30;
+    };
+
+    struct Stats
+    {
+        uint64_t ticks = 0;
+        /**
+         * Time spent in onTick
+         */
+        double tickSeconds = 0;
+        uint64_t bytesSent = 0;
+        uint64_t messagesSent = 0;
+        uint64_t messagesDropped = 0;
+    };
+
+    explicit GameServer(const Config& config);
+    virtual ~GameServer();
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    /**
+     * Listens on the port then runs the event loop until `stop`
+     *
+     * @return false if it couldn't listen
+     */
+    bool run();
+
+    /**
+     * Stops listening and ticking and disconnects every client, `run` returns once they're closed.
+     * Only call it from the server's thread, e.g from a callback
+     */
+    void stop();
+
+    /**
+     * @return false if the message was dropped because the client is too far behind
+     */
+    bool send(ClientID client, std::span<const uint8_t> bytes);
+
+    /**
+     * Sends the bytes written to the stream so far
+     */
+    bool send(ClientID client, const BitStream& stream);
+
+    void disconnect(ClientID client);
+
+    [[nodiscard]] bool isConnected(ClientID client) const;
+
+    [[nodiscard]] const Config& config() const
+    {
+        return m_config;
+    }
+
+    [[nodiscard]] uint32_t currentTick() const
+    {
+        return m_tick;
+    }
+
+    [[nodiscard]] const Stats& stats() const
+    {
+        return m_stats;
+    }
+
+    /**
+     * Clients connected right now, unlike the rest it's safe to read from any thread
+     */
+    [[nodiscard]] uint32_t clientCount() const
+    {
+        return m_clientCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Sockets accepted or adopted that didn't upgrade to a WebSocket or close yet, safe to read from any thread
+     */
+    [[nodiscard]] uint32_t connectingCount() const
+    {
+        return m_connectingCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Buffers for building packets without allocating every tick
+     */
+    [[nodiscard]] BufferPool& bufferPool()
+    {
+        return m_pool;
+    }
+
+protected:
+    virtual void onConnect(ClientID client);
+
+    virtual void onMessage(ClientID client, BitStream& message);
+
+    virtual void onDisconnect(ClientID client);
+
+    /**
+     * Fixed tick, `dt` is always `1 / tickRate`
+     */
+    virtual void onTick(uint32_t tick, float dt);
+
+private:
+    friend class ServerCluster;
+
+    /**
+     * uWebSockets types stay out of this header
+     */
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+
+    Config m_config;
+    BufferPool m_pool;
+    IdPool<ClientID> m_idPool;
+
+    uint32_t m_tick = 0;
+    TickSchedule m_schedule;
+    Stats m_stats;
+    std::atomic<uint32_t> m_clientCount = 0;
+    std::atomic<uint32_t> m_connectingCount = 0;
+
+    /**
+     * Runs the ticks that are due, called by the loop's timer
+     */
+    void runTicks();
+
+    /**
+     * @param listen false for a ServerCluster worker, its sockets are accepted by the cluster and adopted
+     * @param onReady Called on the server's thread once the loop is made, before it runs
+     */
+    bool runLoop(bool listen, const std::function<void()>& onReady);
+
+    /**
+     * Takes over a socket accepted on another thread, only call it from the server's thread
+     *
+     * @param socket The native socket descriptor
+     */
+    void adoptSocket(intptr_t socket);
+
+    /**
+     * Runs `fn` on the server's thread, safe to call from any thread while the loop is running
+     */
+    void defer(std::function<void()> fn);
+};
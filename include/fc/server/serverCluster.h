@@ -0,0 +1,100 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#pragma once
+
+#include "fc/server/gameServer.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * Runs a GameServer per worker thread, each with its own event loop and its own rooms.
+ * One acceptor loop listens on the port and hands every new connection to the least loaded worker,
+ * after that the worker owns the socket so workers never share state or locks.
+ *
+ * Rooms belong to the server of a worker, so matches are spread across cores
+ * and a busy match only slows down the rooms sharing its worker.
+ *
+ * @example
+ * ```
+ *   ServerCluster cluster(9001, std::thread::hardware_concurrency(), [](size_t worker) {
+ *       return std::make_unique<MyServer>(worker);
+ *   });
+ *   cluster.run();
+ * ```
+ */
+class ServerCluster
+{
+public:
+    /**
+     * Makes the server of a worker, called on that worker's thread
+     */
+    using Factory = std::function<std::unique_ptr<GameServer>(size_t worker)>;
+
+    ServerCluster(uint16_t port, size_t workerCount, Factory factory);
+    ~ServerCluster();
+
+    ServerCluster(const ServerCluster&) = delete;
+    ServerCluster& operator=(const ServerCluster&) = delete;
+
+    /**
+     * Starts the workers then accepts connections on the calling thread until `stop`
+     *
+     * @return false if it couldn't listen
+     */
+    bool run();
+
+    /**
+     * Stops accepting then stops every worker, `run` returns once they're done. Safe to call from any thread
+     */
+    void stop();
+
+    [[nodiscard]] size_t workerCount() const
+    {
+        return m_workers.size();
+    }
+
+    /**
+     * Clients connected to the worker, plus the sockets handed to it that didn't upgrade to a WebSocket yet
+     */
+    [[nodiscard]] uint32_t load(size_t worker) const;
+
+private:
+    struct Worker
+    {
+        std::unique_ptr<GameServer> server;
+        std::thread thread;
+        /**
+         * Sockets deferred to the worker that it didn't adopt yet, so a burst of connections is spread too
+         */
+        std::atomic<uint32_t> pending = 0;
+    };
+
+    /**
+     * uWebSockets types stay out of this header
+     */
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+
+    uint16_t m_port;
+    Factory m_factory;
+    std::vector<Worker> m_workers;
+
+    std::atomic<bool> m_stopping = false;
+
+    /**
+     * Picks the least loaded worker and moves the socket to its thread
+     */
+    void dispatch(intptr_t socket);
+
+    void stopWorkers();
+};
@@ -6,7 +6,229 @@
 
 #include "fc/core/bitStream.h"
 
+#include <bit>
 #include <cmath>
+#include <cstring>
+#include <numbers>
+#include <utility>
+
+BitStream::BitStream(BufferPool& pool, size_t initialSize) :
+    m_buff(nullptr, 0),
+    m_pool(&pool)
+{
+    if (initialSize > 0) {
+        grow(initialSize);
+    }
+}
+
+BitStream::BitStream(const BitStream& other) :
+    m_buff(other.m_buff),
+    m_bitIndex(other.m_bitIndex),
+    m_pool(other.m_pool),
+    m_owned(other.m_owned)
+{
+    if (m_pool != nullptr) {
+        m_buff = Uint8Buffer(m_owned.data(), m_owned.size());
+    }
+}
+
+BitStream::BitStream(BitStream&& other) noexcept :
+    m_buff(other.m_buff),
+    m_bitIndex(other.m_bitIndex),
+    m_pool(other.m_pool),
+    m_owned(std::move(other.m_owned))
+{
+    if (m_pool != nullptr) {
+        m_buff = Uint8Buffer(m_owned.data(), m_owned.size());
+        other.m_buff = Uint8Buffer(nullptr, 0);
+        other.m_bitIndex = 0;
+    }
+}
+
+BitStream& BitStream::operator=(BitStream other)
+{
+    swap(*this, other);
+    return *this;
+}
+
+BitStream::~BitStream()
+{
+    if (m_pool != nullptr) {
+        m_pool->release(std::move(m_owned));
+    }
+}
+
+void BitStream::swap(BitStream& lhs, BitStream& rhs) noexcept
+{
+    using std::swap;
+
+    swap(lhs.m_buff, rhs.m_buff);
+    swap(lhs.m_bitIndex, rhs.m_bitIndex);
+    swap(lhs.m_pool, rhs.m_pool);
+    swap(lhs.m_owned, rhs.m_owned);
+}
+
+std::vector<uint8_t> BitStream::takeBytes()
+{
+    if (m_pool == nullptr) {
+        throw std::logic_error("takeBytes: only growable streams own their bytes");
+    }
+
+    std::vector<uint8_t> bytes = std::move(m_owned);
+    bytes.resize(byteIndex());
+
+    m_owned = {};
+    m_buff = Uint8Buffer(nullptr, 0);
+    m_bitIndex = 0;
+
+    return bytes;
+}
+
+void BitStream::writeVarUint(uint64_t value)
+{
+    while (value >= 0x80) {
+        writeBits<uint8_t>((value & 0x7F) | 0x80, 8);
+        value >>= 7;
+    }
+    writeBits<uint8_t>(value, 8);
+}
+
+void BitStream::writeVarInt(int64_t value)
+{
+    writeVarUint(zigzagEncode(value));
+}
+
+uint64_t BitStream::readVarUint()
+{
+    uint64_t value = 0;
+
+    // 10 groups of 7 bits cover 64 bits
+    for (uint8_t shift = 0; shift < 70; shift += 7) {
+        uint8_t group = readBits<uint8_t>(8);
+
+        // only the lowest bit of the 10th group is left for the 64th bit
+        if (shift == 63 && (group & 0x7E) != 0) {
+            throw std::out_of_range("readVarUint: value doesn't fit in 64 bits");
+        }
+        value |= (uint64_t)(group & 0x7F) << shift;
+
+        if ((group & 0x80) == 0) {
+            return value;
+        }
+    }
+
+    throw std::out_of_range("readVarUint: value doesn't fit in 64 bits");
+}
+
+int64_t BitStream::readVarInt()
+{
+    return zigzagDecode(readVarUint());
+}
+
+void BitStream::writeExpGolomb(uint64_t value, uint8_t k)
+{
+    assert(k < 64);
+    assert(value <= UINT64_MAX - (uint64_t{1} << k));
+
+    // zeros for the extra bit width of `value + 2^k`, its leading 1 then the rest of its bits.
+    // Fields are least significant bit first so the leading 1 is written on its own to end the zeros
+    uint64_t shifted = value + (uint64_t{1} << k);
+    auto width = (uint8_t)std::bit_width(shifted);
+    uint8_t zeros = width - 1 - k;
+
+    writeBits<uint64_t>(0, zeros);
+    writeBits<uint8_t>(1, 1);
+    writeBits<uint64_t>(shifted & lowBitsMask(width - 1), width - 1);
+}
+
+void BitStream::writeExpGolombInt(int64_t value, uint8_t k)
+{
+    writeExpGolomb(zigzagEncode(value), k);
+}
+
+uint64_t BitStream::readExpGolomb(uint8_t k)
+{
+    assert(k < 64);
+
+    // count the zeros up to the first 1
+    size_t start = m_bitIndex;
+    auto available = (uint8_t)std::min<size_t>(64, bitSize() - m_bitIndex);
+    uint64_t peek = readBits<uint64_t>(available);
+    m_bitIndex = start;
+
+    auto zeros = (uint8_t)std::countr_zero(peek);
+    if (zeros >= available) {
+        throwReadPastEnd(zeros + 1);
+    }
+    if (zeros + k > 63) {
+        throw std::out_of_range("readExpGolomb: value doesn't fit in 64 bits");
+    }
+
+    m_bitIndex += zeros + 1;
+    uint8_t width = zeros + k;
+    uint64_t shifted = (uint64_t{1} << width) | readBits<uint64_t>(width);
+
+    return shifted - (uint64_t{1} << k);
+}
+
+int64_t BitStream::readExpGolombInt(uint8_t k)
+{
+    return zigzagDecode(readExpGolomb(k));
+}
+
+void BitStream::reserveBits(size_t bitCount)
+{
+    size_t newIndex = m_bitIndex + bitCount;
+    if (newIndex <= bitSize()) {
+        return;
+    }
+
+    if (m_pool == nullptr) {
+        throwWritePastEnd(bitCount);
+    }
+    grow((newIndex + 7) / 8);
+}
+
+void BitStream::throwReadPastEnd(size_t bitCount) const
+{
+    throw std::out_of_range(
+        std::format(
+            "readBits: trying to read past the end of the buffer, buff size: {}, buff index: {}, bits to read: {}",
+            bitSize(),
+            m_bitIndex,
+            bitCount
+        )
+    );
+}
+
+void BitStream::throwWritePastEnd(size_t bitCount) const
+{
+    throw std::out_of_range(
+        std::format(
+            "writeBits: trying to write past the end of the buffer, buff size: {}, buff index: {}, bits to write: {}",
+            bitSize(),
+            m_bitIndex,
+            bitCount
+        )
+    );
+}
+
+void BitStream::grow(size_t minSize)
+{
+    assert(m_pool != nullptr);
+
+    // at least double so a stream written bit by bit doesn't grow on every byte
+    std::vector<uint8_t> bigger = m_pool->acquire(std::max(minSize, m_owned.size() * 2));
+    if (!m_owned.empty()) {
+        std::memcpy(bigger.data(), m_owned.data(), m_owned.size());
+    }
+    // pooled buffers have old data in them, unwritten bits should stay 0 like in a fresh buffer
+    std::memset(bigger.data() + m_owned.size(), 0, bigger.size() - m_owned.size());
+
+    m_pool->release(std::move(m_owned));
+    m_owned = std::move(bigger);
+    m_buff = Uint8Buffer(m_owned.data(), m_owned.size());
+}
 
 void BitStream::writeFloat(float value, float min, float max, uint8_t bitCount)
 {
@@ -18,9 +240,10 @@ void BitStream::writeFloat(float value, float min, float max, uint8_t bitCount)
         );
     }
 
-    uint32_t range = (1 << bitCount) - 1;
-    float t = (value - min) / (max - min);
-    uint32_t valueToWrite = std::round(t * range + 0.5);
+    // rounded to the nearest step, max is the last step
+    double range = (double)lowBitsMask(bitCount);
+    double t = ((double)value - min) / ((double)max - min);
+    auto valueToWrite = (uint32_t)std::round(t * range);
     writeBits<uint32_t>(valueToWrite, bitCount);
 }
 
@@ -28,12 +251,74 @@ float BitStream::readFloat(float min, float max, uint8_t bitCount)
 {
     assert(bitCount <= 32);
 
-    uint32_t range = (1 << bitCount) - 1;
+    double range = (double)lowBitsMask(bitCount);
 
-    float read = readBits<uint32_t>(bitCount);
-    float t = read / range;
+    double read = readBits<uint32_t>(bitCount);
+    double t = read / range;
 
-    return min + t * (max - min);
+    return (float)(min + t * ((double)max - min));
+}
+
+void BitStream::writeVec2(Vec2F value, Vec2F min, Vec2F max, uint8_t bitCount)
+{
+    if (value.x < min.x || value.x > max.x || value.y < min.y || value.y > max.y) {
+        throw std::out_of_range(
+            std::format(
+                "writeVec2: value out of range: {}, range: [{}] - [{}]",
+                value.toString(),
+                min.toString(),
+                max.toString()
+            )
+        );
+    }
+
+    writeFloat(value.x, min.x, max.x, bitCount);
+    writeFloat(value.y, min.y, max.y, bitCount);
+}
+
+Vec2F BitStream::readVec2(Vec2F min, Vec2F max, uint8_t bitCount)
+{
+    float x = readFloat(min.x, max.x, bitCount);
+    float y = readFloat(min.y, max.y, bitCount);
+    return {x, y};
+}
+
+void BitStream::writeAngle(float radians, uint8_t bitCount)
+{
+    assert(bitCount > 0 && bitCount <= 32);
+
+    // steps of a full turn, the last one wraps back to 0
+    double steps = (double)(uint64_t{1} << bitCount);
+    double turns = (double)radians / (2 * std::numbers::pi);
+    turns -= std::floor(turns);
+
+    auto step = (uint64_t)std::round(turns * steps);
+    writeBits<uint32_t>((uint32_t)(step & lowBitsMask(bitCount)), bitCount);
+}
+
+float BitStream::readAngle(uint8_t bitCount)
+{
+    assert(bitCount > 0 && bitCount <= 32);
+
+    double steps = (double)(uint64_t{1} << bitCount);
+    double turns = readBits<uint32_t>(bitCount) / steps;
+    // the upper half of the turn is negative
+    if (turns >= 0.5) {
+        turns -= 1;
+    }
+
+    return (float)(turns * 2 * std::numbers::pi);
+}
+
+void BitStream::writeUnitVec2(Vec2F normal, uint8_t bitCount)
+{
+    writeAngle(std::atan2(normal.y, normal.x), bitCount);
+}
+
+Vec2F BitStream::readUnitVec2(uint8_t bitCount)
+{
+    float angle = readAngle(bitCount);
+    return {std::cos(angle), std::sin(angle)};
 }
 
 void BitStream::writeString(const std::string_view& view, size_t maxSize)
@@ -44,25 +329,25 @@ void BitStream::writeString(const std::string_view& view, size_t maxSize)
         ? view.size()
         : std::min(view.size(), maxSize);
 
-    size_t i = 0;
-    for (; i < sizeToWrite; i++) {
-        writeUint8(view[i]);
-
-        if (view[i] == 0) {
-            return;
-        }
-    }
+    // stop at a null terminator in the view, it's written as the terminator
+    size_t length = std::min(view.find('\0'), sizeToWrite);
+    writeBytes(reinterpret_cast<const uint8_t*>(view.data()), length);
 
     // add null terminator if:
-    // we have a max size and we wrote less than it
+    // the view had one
+    // or we have a max size and we wrote less than it
     // or if we don't have a max size
-    if (i != maxSize || noMaxSize) {
+    if (length < sizeToWrite || length != maxSize || noMaxSize) {
         writeUint8(0);
     }
 }
 
 std::string BitStream::readString(size_t maxSize)
 {
+    if ((m_bitIndex & 7) == 0) {
+        return std::string(readStringView(maxSize));
+    }
+
     std::string str;
 
     size_t i = 0;
@@ -85,3 +370,84 @@ std::string BitStream::readString(size_t maxSize)
 
     return str;
 }
+
+std::string_view BitStream::readStringView(size_t maxSize)
+{
+    if ((m_bitIndex & 7) != 0) {
+        throw std::logic_error("readStringView: the bit index isn't byte aligned");
+    }
+
+    size_t byteOffset = m_bitIndex / 8;
+    size_t remaining = m_buff.size() - byteOffset;
+    size_t searchSize = maxSize == 0 ? remaining : std::min(maxSize, remaining);
+
+    const char* begin = reinterpret_cast<const char*>(m_buff.data() + byteOffset);
+    const void* terminator = std::memchr(begin, 0, searchSize);
+
+    if (terminator != nullptr) {
+        size_t length = static_cast<const char*>(terminator) - begin;
+        m_bitIndex += (length + 1) * 8;
+        return {begin, length};
+    }
+
+    // no terminator needed when the string is exactly maxSize long
+    if (maxSize != 0 && maxSize <= remaining) {
+        m_bitIndex += maxSize * 8;
+        return {begin, maxSize};
+    }
+
+    throwReadPastEnd((searchSize + 1) * 8);
+}
+
+void BitStream::writeBytes(const uint8_t* data, size_t size)
+{
+    reserveBits(size * 8);
+
+    if ((m_bitIndex & 7) == 0) {
+        if (size > 0) {
+            std::memcpy(m_buff.data() + m_bitIndex / 8, data, size);
+        }
+        m_bitIndex += size * 8;
+        return;
+    }
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word = 0;
+        std::memcpy(&word, data + i, 8);
+        if constexpr (std::endian::native == std::endian::big) {
+            word = std::byteswap(word);
+        }
+        writeBitsUnchecked(word, 64);
+    }
+    for (; i < size; i++) {
+        writeBitsUnchecked(data[i], 8);
+    }
+}
+
+void BitStream::readBytes(uint8_t* data, size_t size)
+{
+    if (m_bitIndex + (size * 8) > bitSize()) {
+        throwReadPastEnd(size * 8);
+    }
+
+    if ((m_bitIndex & 7) == 0) {
+        if (size > 0) {
+            std::memcpy(data, m_buff.data() + m_bitIndex / 8, size);
+        }
+        m_bitIndex += size * 8;
+        return;
+    }
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word = readBitsUnchecked<uint64_t>(64);
+        if constexpr (std::endian::native == std::endian::big) {
+            word = std::byteswap(word);
+        }
+        std::memcpy(data + i, &word, 8);
+    }
+    for (; i < size; i++) {
+        data[i] = readBitsUnchecked<uint8_t>(8);
+    }
+}
@@ -11,23 +11,29 @@
 #include <cassert>
 #include <cmath>
 #include <limits>
+#include <span>
+#include <utility>
 #include <vector>
 
-template<typename T>
+// called unqualified so Fixed finds its own versions
+using std::abs;
+using std::sqrt;
+
+template<typename T, typename Points>
 static void projectVertices(
-    const T& points,
-    Vec2F normal,
-    Vec2F center,
+    const Points& points,
+    Vec2<T> normal,
+    Vec2<T> center,
 
-    float* outMin,
-    float* outMax
+    T* outMin,
+    T* outMax
 )
 {
-    float min = std::numeric_limits<float>::max();
-    float max = -min;
+    T min = std::numeric_limits<T>::max();
+    T max = -min;
 
-    for (Vec2F point : points) {
-        float proj = normal * (center - point);
+    for (Vec2<T> point : points) {
+        T proj = normal * (center - point);
 
         min = std::min(proj, min);
         max = std::max(proj, max);
@@ -37,26 +43,27 @@ static void projectVertices(
     *outMax = max;
 }
 
+template<typename T>
 static void projectCircle(
-    Vec2F center,
-    float radius,
-    Vec2F normal,
+    Vec2<T> center,
+    T radius,
+    Vec2<T> normal,
 
-    float* outMin,
-    float* outMax
+    T* outMin,
+    T* outMax
 )
 {
-    Vec2F scaled = normal * radius;
+    Vec2<T> scaled = normal * radius;
 
-    Vec2F p1 = center + scaled;
-    Vec2F p2 = center - scaled;
+    Vec2<T> p1 = center + scaled;
+    Vec2<T> p2 = center - scaled;
 
-    float min = p1 * normal;
-    float max = p2 * normal;
+    T min = p1 * normal;
+    T max = p2 * normal;
 
     if (min > max) {
         // swap the min and max values.
-        float t = min;
+        T t = min;
         min = max;
         max = t;
     }
@@ -65,43 +72,126 @@ static void projectCircle(
     *outMax = max;
 }
 
+template<typename T>
+static std::array<Vec2<T>, 4> rectToPoints(Vec2<T> rectMin, Vec2<T> rectMax)
+{
+    return {
+        rectMin,
+        Vec2<T>{rectMin.x, rectMax.y},
+        rectMax,
+        Vec2<T>{rectMax.x, rectMin.y}
+    };
+}
+
+template<typename T>
+static const std::array RECT_NORMALS = {
+    Vec2<T>{0, 1},
+    Vec2<T>{-1, 0},
+    Vec2<T>{0, -1},
+    Vec2<T>{1, 0}
+};
+
+/**
+ * Tests the axis stored in a SatCache before doing the full separating axis test
+ *
+ * @return true if the cached axis still separates the shapes
+ */
+template<typename T, typename PointsA, typename NormalsA, typename PointsB, typename NormalsB>
+static bool cachedAxisSeparates(
+    const PointsA& pointsA,
+    const NormalsA& normalsA,
+
+    const PointsB& pointsB,
+    const NormalsB& normalsB,
+
+    Collision::SatCache* cache
+)
+{
+    if (cache == nullptr || !cache->valid) {
+        return false;
+    }
+
+    Vec2<T> axis;
+    if (cache->shape == 0 && cache->index < normalsA.size()) {
+        axis = normalsA[cache->index];
+    } else if (cache->shape == 1 && cache->index < normalsB.size()) {
+        axis = normalsB[cache->index];
+    } else {
+        cache->valid = false;
+        return false;
+    }
+
+    T minA, maxA, minB, maxB;
+    projectVertices(pointsA, axis, {}, &minA, &maxA);
+    projectVertices(pointsB, axis, {}, &minB, &maxB);
+
+    if (minA >= maxB || minB >= maxA) {
+        return true;
+    }
+
+    cache->valid = false;
+    return false;
+}
+
+/**
+ * Cheap test with the bounding circles of 2 shapes to skip the separating axis test for far apart shapes
+ */
+template<typename T>
+static bool boundingCirclesSeparated(Vec2<T> centerA, T radiusA, Vec2<T> centerB, T radiusB)
+{
+    T radii = radiusA + radiusB;
+    return (centerB - centerA).lengthSqr() >= radii * radii;
+}
+
+/**
+ * Same as boundingCirclesSeparated against a rect, the rect itself is tighter than its bounding circle
+ */
+template<typename T>
+static bool boundingCircleRectSeparated(Vec2<T> center, T radius, Vec2<T> rectMin, Vec2<T> rectMax)
+{
+    Vec2<T> closest = Vec2<T>::max(rectMin, Vec2<T>::min(center, rectMax));
+    return (closest - center).lengthSqr() >= radius * radius;
+}
+
+template<typename T>
 bool Collision::CircleCircle(
-    Vec2F posA,
-    float radA,
+    Vec2<T> posA,
+    Collision::NoDeduce<T> radA,
 
-    Vec2F posB,
-    float radB,
+    Vec2<T> posB,
+    Collision::NoDeduce<T> radB,
 
-    Collision::Response* res
+    Collision::BasicResponse<Collision::NoDeduce<T>>* res
 )
 {
-    Vec2F sub = posB - posA;
+    Vec2<T> sub = posB - posA;
 
-    float distSqr = sub.lengthSqr();
-    float rad = radA + radB;
+    T distSqr = sub.lengthSqr();
+    T rad = radA + radB;
 
     if (distSqr > (rad * rad)) {
         return false;
     }
 
     if (res != nullptr) {
-        float dist = std::sqrt(distSqr);
-        res->normal = dist > std::numeric_limits<float>::min() // prevents division by 0
+        T dist = sqrt(distSqr);
+        res->normal = dist > std::numeric_limits<T>::min() // prevents division by 0
             ? sub / dist
-            : Vec2F(1, 0);
+            : Vec2<T>(1, 0);
         res->depth = rad - dist;
     }
     return true;
 }
 
+template<typename T>
 bool Collision::CircleRect(
-    Vec2F circlePos,
-    float circleRad,
+    Vec2<T> circlePos,
+    Collision::NoDeduce<T> circleRad,
 
-    Vec2F rectMin,
-    Vec2F rectMax,
+    Vec2<T> rectMin,
+    Vec2<T> rectMax,
 
-    Collision::Response* res
+    Collision::BasicResponse<Collision::NoDeduce<T>>* res
 )
 {
     if (
@@ -110,20 +200,20 @@ bool Collision::CircleRect(
     ) {
         // circle inside rect
         if (res != nullptr) {
-            Vec2F halfDimension = (rectMax - rectMin) * 0.5;
-            Vec2F rectToCircle = (rectMin + halfDimension) - circlePos;
-            float xDepth = std::abs(rectToCircle.x) - halfDimension.x - circleRad;
-            float yDepth = std::abs(rectToCircle.y) - halfDimension.y - circleRad;
+            Vec2<T> halfDimension = (rectMax - rectMin) * T(0.5F);
+            Vec2<T> rectToCircle = (rectMin + halfDimension) - circlePos;
+            T xDepth = abs(rectToCircle.x) - halfDimension.x - circleRad;
+            T yDepth = abs(rectToCircle.y) - halfDimension.y - circleRad;
 
             // make the normal relative to the deepest axis
             if (xDepth > yDepth) {
-                res->normal = Vec2F(
+                res->normal = Vec2<T>(
                     rectToCircle.x > 0 ? 1 : -1,
                     0
                 );
                 res->depth = -xDepth;
             } else {
-                res->normal = Vec2F(
+                res->normal = Vec2<T>(
                     0,
                     rectToCircle.y > 0 ? 1 : -1
                 );
@@ -134,16 +224,16 @@ bool Collision::CircleRect(
         return true;
     }
 
-    Vec2F dir = {
+    Vec2<T> dir = {
         std::clamp(circlePos.x, rectMin.x, rectMax.x) - circlePos.x,
         std::clamp(circlePos.y, rectMin.y, rectMax.y) - circlePos.y
     };
 
-    float dstSqr = dir.lengthSqr();
+    T dstSqr = dir.lengthSqr();
 
     if (dstSqr < circleRad * circleRad) {
         if (res != nullptr) {
-            float dst = std::sqrt(dstSqr);
+            T dst = sqrt(dstSqr);
 
             res->normal = dir.normalize(dst);
             res->depth = circleRad - dst;
@@ -155,14 +245,15 @@ bool Collision::CircleRect(
     return false;
 }
 
+template<typename T>
 bool Collision::RectRect(
-    Vec2F rectAMin,
-    Vec2F rectAMax,
+    Vec2<T> rectAMin,
+    Vec2<T> rectAMax,
 
-    Vec2F rectBMin,
-    Vec2F rectBMax,
+    Vec2<T> rectBMin,
+    Vec2<T> rectBMax,
 
-    Collision::Response* res
+    Collision::BasicResponse<Collision::NoDeduce<T>>* res
 )
 {
     // if the caller doesn't want the intersection data
@@ -171,29 +262,29 @@ bool Collision::RectRect(
         return rectBMin.x < rectBMax.x && rectBMin.y < rectBMax.y && rectAMin.x < rectAMax.x && rectAMin.y < rectAMax.y;
     }
 
-    Vec2F halfDimA = (rectAMax - rectAMin) * 0.5;
-    Vec2F halfDimB = (rectBMax - rectBMin) * 0.5;
+    Vec2<T> halfDimA = (rectAMax - rectAMin) * T(0.5F);
+    Vec2<T> halfDimB = (rectBMax - rectBMin) * T(0.5F);
 
-    Vec2F bToA = ((rectBMin + halfDimB) - (rectAMin + halfDimA));
+    Vec2<T> bToA = ((rectBMin + halfDimB) - (rectAMin + halfDimA));
 
-    float xDepth = halfDimA.x + halfDimB.x - std::abs(bToA.x);
+    T xDepth = halfDimA.x + halfDimB.x - abs(bToA.x);
 
     if (xDepth <= 0)
         return false;
 
-    float yDepth = halfDimA.y + halfDimB.y - std::abs(bToA.y);
+    T yDepth = halfDimA.y + halfDimB.y - abs(bToA.y);
 
     if (yDepth <= 0)
         return false;
 
     if (xDepth < yDepth) {
-        res->normal = Vec2F(
+        res->normal = Vec2<T>(
             bToA.x < 0 ? -1 : 1,
             0
         );
         res->depth = xDepth;
     } else {
-        res->normal = Vec2F(
+        res->normal = Vec2<T>(
             0,
             bToA.y < 0 ? -1 : 1
         );
@@ -203,50 +294,54 @@ bool Collision::RectRect(
     return true;
 }
 
+template<typename T>
 bool Collision::RectPolygon(
-    Vec2F rectMin,
-    Vec2F rectMax,
+    Vec2<T> rectMin,
+    Vec2<T> rectMax,
 
-    const std::vector<Vec2F>& polyPoints,
-    const std::vector<Vec2F>& polyNormals,
-    Vec2F polyCenter,
+    const std::vector<Vec2<T>>& polyPoints,
+    const std::vector<Vec2<T>>& polyNormals,
+    Vec2<T> polyCenter,
+    Collision::NoDeduce<T> polyRadius,
 
-    Collision::Response* res
+    Collision::BasicResponse<Collision::NoDeduce<T>>* res,
+    Collision::SatCache* cache
 )
 {
     assert(polyPoints.size() == polyNormals.size());
 
-    const std::array<Vec2F, 4> rectPoints = {
-        rectMin,
-        {rectMin.x, rectMax.y},
-        rectMax,
-        {rectMax.x, rectMin.y}
-    };
+    if (boundingCircleRectSeparated(polyCenter, polyRadius, rectMin, rectMax)) {
+        return false;
+    }
 
-    static const std::array rectNormals = {
-        Vec2F{0, 1},
-        Vec2F{-1, 0},
-        Vec2F{0, -1},
-        Vec2F{1, 0}
-    };
+    const std::array<Vec2<T>, 4> rectPoints = rectToPoints(rectMin, rectMax);
+
+    if (cachedAxisSeparates<T>(rectPoints, RECT_NORMALS<T>, polyPoints, polyNormals, cache)) {
+        return false;
+    }
 
-    Vec2F rectCenter = rectMin + ((rectMax - rectMin) / 2);
+    Vec2<T> rectCenter = rectMin + ((rectMax - rectMin) / 2);
 
     bool wantsRes = res != nullptr;
-    Vec2F resNormal;
-    float resDepth = std::numeric_limits<float>::max();
+    Vec2<T> resNormal;
+    T resDepth = std::numeric_limits<T>::max();
 
-    for (const auto& vertNormal : polyNormals) {
-        float minA, maxA, minB, maxB;
+    for (uint32_t i = 0; i < polyNormals.size(); i++) {
+        Vec2<T> vertNormal = polyNormals[i];
+
+        T minA, maxA, minB, maxB;
         projectVertices(polyPoints, vertNormal, {}, &minA, &maxA);
         projectVertices(rectPoints, vertNormal, {}, &minB, &maxB);
 
         if (minA >= maxB || minB >= maxA) {
+            if (cache != nullptr) {
+                *cache = {.shape = 1, .index = i, .valid = true};
+            }
             return false;
         }
 
         if (wantsRes) {
-            float axisDepth = std::min(maxB - minA, maxA - minB);
+            T axisDepth = std::min(maxB - minA, maxA - minB);
 
             if (axisDepth < resDepth) {
                 resDepth = axisDepth;
@@ -255,17 +350,22 @@ bool Collision::RectPolygon(
         }
     }
 
-    for (const auto& vertNormal : rectNormals) {
-        float minA, maxA, minB, maxB;
+    for (uint32_t i = 0; i < RECT_NORMALS<T>.size(); i++) {
+        Vec2<T> vertNormal = RECT_NORMALS<T>[i];
+
+        T minA, maxA, minB, maxB;
         projectVertices(polyPoints, vertNormal, {}, &minA, &maxA);
         projectVertices(rectPoints, vertNormal, {}, &minB, &maxB);
 
         if (minA >= maxB || minB >= maxA) {
+            if (cache != nullptr) {
+                *cache = {.shape = 0, .index = i, .valid = true};
+            }
             return false;
         }
 
         if (wantsRes) {
-            float axisDepth = std::min(maxB - minA, maxA - minB);
+            T axisDepth = std::min(maxB - minA, maxA - minB);
 
             if (axisDepth < resDepth) {
                 resDepth = axisDepth;
@@ -275,7 +375,7 @@ bool Collision::RectPolygon(
     }
 
     if (wantsRes) {
-        Vec2F direction = rectCenter - polyCenter;
+        Vec2<T> direction = rectCenter - polyCenter;
 
         if (direction * resNormal > 0) {
             resNormal.invert();
@@ -288,33 +388,39 @@ bool Collision::RectPolygon(
     return true;
 }
 
+template<typename T>
 bool Collision::CirclePolygon(
-    Vec2F circlePos,
-    float circleRad,
+    Vec2<T> circlePos,
+    Collision::NoDeduce<T> circleRad,
 
-    const std::vector<Vec2F>& polyPoints,
-    const std::vector<Vec2F>& polyNormals,
-    Vec2F polyCenter,
+    const std::vector<Vec2<T>>& polyPoints,
+    const std::vector<Vec2<T>>& polyNormals,
+    Vec2<T> polyCenter,
+    Collision::NoDeduce<T> polyRadius,
 
-    Collision::Response* res
+    Collision::BasicResponse<Collision::NoDeduce<T>>* res
 )
 {
     assert(polyPoints.size() == polyNormals.size());
 
-    Vec2F circToPoly = polyCenter - circlePos;
+    if (boundingCirclesSeparated(circlePos, circleRad, polyCenter, polyRadius)) {
+        return false;
+    }
 
-    Vec2F closestPoint;
-    float minDist = std::numeric_limits<float>::max();
+    Vec2<T> circToPoly = polyCenter - circlePos;
+
+    Vec2<T> closestPoint;
+    T minDist = std::numeric_limits<T>::max();
 
     bool wantsRes = res != nullptr;
-    Vec2F resNormal;
-    float resDepth = std::numeric_limits<float>::max();
+    Vec2<T> resNormal;
+    T resDepth = std::numeric_limits<T>::max();
 
     for (size_t i = 0; i < polyPoints.size(); i++) {
-        Vec2F normal = polyNormals[i];
-        Vec2F point = polyPoints[i];
+        Vec2<T> normal = polyNormals[i];
+        Vec2<T> point = polyPoints[i];
 
-        float minA, maxA, minB, maxB;
+        T minA, maxA, minB, maxB;
         projectVertices(polyPoints, normal, polyCenter, &minA, &maxA);
         projectCircle(circToPoly, circleRad, normal, &minB, &maxB);
 
@@ -323,14 +429,14 @@ bool Collision::CirclePolygon(
         }
 
         if (wantsRes) {
-            float depth = std::min(maxB - minA, maxA - minB);
+            T depth = std::min(maxB - minA, maxA - minB);
 
             if (depth < resDepth) {
                 resDepth = depth;
                 resNormal = normal;
             }
 
-            float dist = point.distanceTo(circlePos);
+            T dist = point.distanceTo(circlePos);
             if (dist < minDist) {
                 minDist = dist;
                 closestPoint = point;
@@ -338,9 +444,9 @@ bool Collision::CirclePolygon(
         }
     }
 
-    Vec2F normal = (closestPoint - circlePos).normalize();
+    Vec2<T> normal = (closestPoint - circlePos).normalize();
 
-    float minA, maxA, minB, maxB;
+    T minA, maxA, minB, maxB;
     projectVertices(polyPoints, normal, polyCenter, &minA, &maxA);
     projectCircle(circToPoly, circleRad, normal, &minB, &maxB);
 
@@ -349,14 +455,14 @@ bool Collision::CirclePolygon(
     }
 
     if (wantsRes) {
-        float depth = std::min(maxB - minA, maxA - minB);
+        T depth = std::min(maxB - minA, maxA - minB);
 
         if (depth < resDepth) {
             resDepth = depth;
             resNormal = normal;
         }
 
-        Vec2F direction = polyCenter - circlePos;
+        Vec2<T> direction = polyCenter - circlePos;
 
         if ((direction * resNormal) < 0) {
             resNormal.invert();
@@ -369,36 +475,53 @@ bool Collision::CirclePolygon(
     return true;
 }
 
+template<typename T>
 bool Collision::PolygonPolygon(
-    const std::vector<Vec2F>& pointsA,
-    const std::vector<Vec2F>& normalsA,
-    Vec2F centerA,
-
-    const std::vector<Vec2F>& pointsB,
-    const std::vector<Vec2F>& normalsB,
-    Vec2F centerB,
-
-    Collision::Response* res
+    const std::vector<Vec2<T>>& pointsA,
+    const std::vector<Vec2<T>>& normalsA,
+    Vec2<T> centerA,
+    Collision::NoDeduce<T> radiusA,
+
+    const std::vector<Vec2<T>>& pointsB,
+    const std::vector<Vec2<T>>& normalsB,
+    Vec2<T> centerB,
+    Collision::NoDeduce<T> radiusB,
+
+    Collision::BasicResponse<Collision::NoDeduce<T>>* res,
+    Collision::SatCache* cache
 )
 {
     assert(pointsA.size() == normalsA.size());
     assert(pointsB.size() == normalsB.size());
 
+    if (boundingCirclesSeparated(centerA, radiusA, centerB, radiusB)) {
+        return false;
+    }
+
+    if (cachedAxisSeparates<T>(pointsA, normalsA, pointsB, normalsB, cache)) {
+        return false;
+    }
+
     bool wantsRes = res != nullptr;
-    Vec2F resNormal;
-    float resDepth = std::numeric_limits<float>::max();
+    Vec2<T> resNormal;
+    T resDepth = std::numeric_limits<T>::max();
+
+    for (uint32_t i = 0; i < normalsA.size(); i++) {
+        Vec2<T> vertNormal = normalsA[i];
 
-    for (const auto& vertNormal : normalsA) {
-        float minA, maxA, minB, maxB;
+        T minA, maxA, minB, maxB;
         projectVertices(pointsA, vertNormal, {}, &minA, &maxA);
         projectVertices(pointsB, vertNormal, {}, &minB, &maxB);
 
         if (minA >= maxB || minB >= maxA) {
+            if (cache != nullptr) {
+                *cache = {.shape = 0, .index = i, .valid = true};
+            }
             return false;
         }
 
         if (wantsRes) {
-            float axisDepth = std::min(maxB - minA, maxA - minB);
+            T axisDepth = std::min(maxB - minA, maxA - minB);
 
             if (axisDepth < resDepth) {
                 resDepth = axisDepth;
@@ -407,17 +530,22 @@ bool Collision::PolygonPolygon(
         }
     }
 
-    for (const auto& vertNormal : normalsB) {
-        float minA, maxA, minB, maxB;
+    for (uint32_t i = 0; i < normalsB.size(); i++) {
+        Vec2<T> vertNormal = normalsB[i];
+
+        T minA, maxA, minB, maxB;
         projectVertices(pointsA, vertNormal, {}, &minA, &maxA);
         projectVertices(pointsB, vertNormal, {}, &minB, &maxB);
 
         if (minA >= maxB || minB >= maxA) {
+            if (cache != nullptr) {
+                *cache = {.shape = 1, .index = i, .valid = true};
+            }
             return false;
         }
 
         if (wantsRes) {
-            float axisDepth = std::min(maxB - minA, maxA - minB);
+            T axisDepth = std::min(maxB - minA, maxA - minB);
 
             if (axisDepth < resDepth) {
                 resDepth = axisDepth;
@@ -427,7 +555,7 @@ bool Collision::PolygonPolygon(
     }
 
     if (wantsRes) {
-        Vec2F direction = centerB - centerA;
+        Vec2<T> direction = centerB - centerA;
 
         if (direction * resNormal < 0) {
             resNormal.invert();
@@ -439,17 +567,20 @@ bool Collision::PolygonPolygon(
     return true;
 }
 
-bool Collision::PointCircle(Vec2F point, Vec2F circlePos, float circleRad)
+template<typename T>
+bool Collision::PointCircle(Vec2<T> point, Vec2<T> circlePos, Collision::NoDeduce<T> circleRad)
 {
     return point.distanceTo(circlePos) <= circleRad;
 }
 
-bool Collision::PointRect(Vec2F point, Vec2F rectMin, Vec2F rectMax)
+template<typename T>
+bool Collision::PointRect(Vec2<T> point, Vec2<T> rectMin, Vec2<T> rectMax)
 {
     return point.x > rectMin.x && point.y > rectMin.y && point.x < rectMax.x && point.y < rectMax.y;
 }
 
-bool Collision::PointPolygon(Vec2F point, const std::vector<Vec2F>& points)
+template<typename T>
+bool Collision::PointPolygon(Vec2<T> point, const std::vector<Vec2<T>>& points)
 {
     // https://wrfranklin.org/Research/Short_Notes/pnpoly.html
     size_t count = points.size();
@@ -466,3 +597,1021 @@ bool Collision::PointPolygon(Vec2F point, const std::vector<Vec2F>& points)
 
     return inside;
 }
+
+/**
+ * Fills a manifold for a circle colliding with another shape,
+ * circles can only have a single contact point
+ */
+template<typename T>
+static void circleManifold(
+    Vec2<T> circlePos,
+    T circleRad,
+
+    const Collision::BasicResponse<T>& overlap,
+
+    Collision::BasicManifold<T>* res
+)
+{
+    res->normal = overlap.normal;
+    res->pointCount = 1;
+    // halfway between the deepest point of the circle and the surface of the other shape
+    res->points[0] = circlePos + (overlap.normal * (circleRad - (overlap.depth / 2)));
+    res->depths[0] = overlap.depth;
+}
+
+template<typename T>
+struct ManifoldEdge
+{
+    Vec2<T> start;
+    Vec2<T> end;
+    /**
+     * Pointing out of the shape
+     */
+    Vec2<T> normal;
+};
+
+/**
+ * Finds the edge of a convex shape that faces the most towards `direction`
+ */
+template<typename T, typename Points>
+static ManifoldEdge<T> bestEdge(const Points& points, Vec2<T> center, Vec2<T> direction)
+{
+    ManifoldEdge<T> edge;
+    T bestDot = -std::numeric_limits<T>::max();
+
+    size_t count = points.size();
+    for (size_t i = 0, j = count - 1; i < count; j = i++) {
+        Vec2<T> start = points[j];
+        Vec2<T> end = points[i];
+
+        Vec2<T> normal = (end - start).perp().normalize();
+        if (normal * (start - center) < 0) {
+            normal.invert();
+        }
+
+        T dot = normal * direction;
+        if (dot > bestDot) {
+            bestDot = dot;
+            edge = {.start = start, .end = end, .normal = normal};
+        }
+    }
+
+    return edge;
+}
+
+/**
+ * Clips a segment, keeping the part in front of a plane
+ *
+ * @return how many points were written to `out`
+ */
+template<typename T>
+static uint8_t clipSegment(
+    Vec2<T> pointA,
+    Vec2<T> pointB,
+
+    Vec2<T> planeNormal,
+    T planeOffset,
+
+    std::array<Vec2<T>, 2>& out
+)
+{
+    uint8_t count = 0;
+
+    T distA = (planeNormal * pointA) - planeOffset;
+    T distB = (planeNormal * pointB) - planeOffset;
+
+    if (distA >= 0) {
+        out[count++] = pointA;
+    }
+    if (distB >= 0) {
+        out[count++] = pointB;
+    }
+
+    // points are on different sides of the plane, add the intersection
+    if ((distA < 0 && distB > 0) || (distA > 0 && distB < 0)) {
+        out[count++] = pointA + ((pointB - pointA) * (distA / (distA - distB)));
+    }
+
+    return count;
+}
+
+/**
+ * Finds up to 2 contact points between 2 colliding convex shapes
+ * by clipping the incident edge against the reference edge
+ */
+template<typename T, typename PointsA, typename PointsB>
+static void clipManifold(
+    const PointsA& pointsA,
+    Vec2<T> centerA,
+
+    const PointsB& pointsB,
+    Vec2<T> centerB,
+
+    const Collision::BasicResponse<T>& overlap,
+
+    Collision::BasicManifold<T>* res
+)
+{
+    Vec2<T> normal = overlap.normal;
+
+    ManifoldEdge<T> edgeA = bestEdge(pointsA, centerA, normal);
+    ManifoldEdge<T> edgeB = bestEdge(pointsB, centerB, -normal);
+
+    // the reference edge is the one most perpendicular to the collision normal
+    // the incident edge gets clipped against its sides
+    bool flip = (edgeB.normal * -normal) > (edgeA.normal * normal);
+    const ManifoldEdge<T>& ref = flip ? edgeB : edgeA;
+    const ManifoldEdge<T>& inc = flip ? edgeA : edgeB;
+
+    Vec2<T> refDir = (ref.end - ref.start).normalize();
+
+    res->normal = normal;
+    res->pointCount = 0;
+
+    std::array<Vec2<T>, 2> clipped;
+    std::array<Vec2<T>, 2> clippedTwice;
+    if (
+        clipSegment(inc.start, inc.end, refDir, refDir * ref.start, clipped) == 2
+        && clipSegment(clipped[0], clipped[1], -refDir, -(refDir * ref.end), clippedTwice) == 2
+    ) {
+        for (Vec2<T> point : clippedTwice) {
+            T separation = ref.normal * (point - ref.start);
+
+            // only keep points behind the reference edge
+            if (separation <= 0) {
+                res->points[res->pointCount] = point;
+                res->depths[res->pointCount] = -separation;
+                res->pointCount++;
+            }
+        }
+    }
+
+    // clipping can fail with degenerate edges
+    // fallback to the deepest vertex of B
+    if (res->pointCount == 0) {
+        Vec2<T> deepest;
+        T deepestDot = std::numeric_limits<T>::max();
+        for (Vec2<T> point : pointsB) {
+            T dot = point * normal;
+            if (dot < deepestDot) {
+                deepestDot = dot;
+                deepest = point;
+            }
+        }
+
+        res->pointCount = 1;
+        res->points[0] = deepest;
+        res->depths[0] = overlap.depth;
+    }
+}
+
+template<typename T>
+bool Collision::ManifoldCircleCircle(
+    Vec2<T> posA,
+    Collision::NoDeduce<T> radA,
+
+    Vec2<T> posB,
+    Collision::NoDeduce<T> radB,
+
+    Collision::BasicManifold<Collision::NoDeduce<T>>* res
+)
+{
+    Collision::BasicResponse<T> overlap;
+    if (!CircleCircle(posA, radA, posB, radB, &overlap)) {
+        return false;
+    }
+
+    if (res != nullptr) {
+        circleManifold(posA, radA, overlap, res);
+    }
+    return true;
+}
+
+template<typename T>
+bool Collision::ManifoldCircleRect(
+    Vec2<T> circlePos,
+    Collision::NoDeduce<T> circleRad,
+
+    Vec2<T> rectMin,
+    Vec2<T> rectMax,
+
+    Collision::BasicManifold<Collision::NoDeduce<T>>* res
+)
+{
+    Collision::BasicResponse<T> overlap;
+    if (!CircleRect(circlePos, circleRad, rectMin, rectMax, &overlap)) {
+        return false;
+    }
+
+    if (res != nullptr) {
+        circleManifold(circlePos, circleRad, overlap, res);
+    }
+    return true;
+}
+
+template<typename T>
+bool Collision::ManifoldCirclePolygon(
+    Vec2<T> circlePos,
+    Collision::NoDeduce<T> circleRad,
+
+    const std::vector<Vec2<T>>& polyPoints,
+    const std::vector<Vec2<T>>& polyNormals,
+    Vec2<T> polyCenter,
+    Collision::NoDeduce<T> polyRadius,
+
+    Collision::BasicManifold<Collision::NoDeduce<T>>* res
+)
+{
+    Collision::BasicResponse<T> overlap;
+    if (!CirclePolygon(circlePos, circleRad, polyPoints, polyNormals, polyCenter, polyRadius, &overlap)) {
+        return false;
+    }
+
+    if (res != nullptr) {
+        circleManifold(circlePos, circleRad, overlap, res);
+    }
+    return true;
+}
+
+template<typename T>
+bool Collision::ManifoldRectRect(
+    Vec2<T> rectAMin,
+    Vec2<T> rectAMax,
+
+    Vec2<T> rectBMin,
+    Vec2<T> rectBMax,
+
+    Collision::BasicManifold<Collision::NoDeduce<T>>* res
+)
+{
+    Collision::BasicResponse<T> overlap;
+    if (!RectRect(rectAMin, rectAMax, rectBMin, rectBMax, &overlap)) {
+        return false;
+    }
+
+    if (res != nullptr) {
+        clipManifold(
+            rectToPoints(rectAMin, rectAMax),
+            rectAMin + ((rectAMax - rectAMin) / 2),
+
+            rectToPoints(rectBMin, rectBMax),
+            rectBMin + ((rectBMax - rectBMin) / 2),
+
+            overlap,
+            res
+        );
+    }
+    return true;
+}
+
+template<typename T>
+bool Collision::ManifoldRectPolygon(
+    Vec2<T> rectMin,
+    Vec2<T> rectMax,
+
+    const std::vector<Vec2<T>>& polyPoints,
+    const std::vector<Vec2<T>>& polyNormals,
+    Vec2<T> polyCenter,
+    Collision::NoDeduce<T> polyRadius,
+
+    Collision::BasicManifold<Collision::NoDeduce<T>>* res
+)
+{
+    Collision::BasicResponse<T> overlap;
+    if (!RectPolygon(rectMin, rectMax, polyPoints, polyNormals, polyCenter, polyRadius, &overlap)) {
+        return false;
+    }
+
+    if (res != nullptr) {
+        clipManifold(
+            rectToPoints(rectMin, rectMax),
+            rectMin + ((rectMax - rectMin) / 2),
+
+            polyPoints,
+            polyCenter,
+
+            overlap,
+            res
+        );
+    }
+    return true;
+}
+
+template<typename T>
+bool Collision::ManifoldPolygonPolygon(
+    const std::vector<Vec2<T>>& pointsA,
+    const std::vector<Vec2<T>>& normalsA,
+    Vec2<T> centerA,
+    Collision::NoDeduce<T> radiusA,
+
+    const std::vector<Vec2<T>>& pointsB,
+    const std::vector<Vec2<T>>& normalsB,
+    Vec2<T> centerB,
+    Collision::NoDeduce<T> radiusB,
+
+    Collision::BasicManifold<Collision::NoDeduce<T>>* res
+)
+{
+    Collision::BasicResponse<T> overlap;
+    if (!PolygonPolygon(pointsA, normalsA, centerA, radiusA, pointsB, normalsB, centerB, radiusB, &overlap)) {
+        return false;
+    }
+
+    if (res != nullptr) {
+        clipManifold(pointsA, centerA, pointsB, centerB, overlap, res);
+    }
+    return true;
+}
+
+/**
+ * Earliest time (from 0 to 1) a point moving by `move` enters a circle.
+ *
+ * Solved for the distance travelled instead of the time so every product stays quadratic in world units,
+ * with time the discriminant is quartic and overflows Fixed at world scale.
+ */
+template<typename T>
+static bool sweepPointCircle(
+    Vec2<T> start,
+    Vec2<T> move,
+
+    Vec2<T> circlePos,
+    T circleRad,
+
+    T* outTime
+)
+{
+    T moveLengthSqr = move.lengthSqr();
+    if (moveLengthSqr <= std::numeric_limits<T>::min()) {
+        return false;
+    }
+    T moveLength = sqrt(moveLengthSqr);
+
+    // |toStart + dir * dist|^2 = rad^2 with dir the unit move
+    Vec2<T> toStart = start - circlePos;
+    T b = (toStart * move) / moveLength;
+    T c = toStart.lengthSqr() - (circleRad * circleRad);
+
+    T discriminant = (b * b) - c;
+    if (discriminant < 0) {
+        return false;
+    }
+
+    T time = (-b - sqrt(discriminant)) / moveLength;
+    if (time < 0 || time > 1) {
+        return false;
+    }
+
+    *outTime = time;
+    return true;
+}
+
+/**
+ * Sweeps a circle against a convex shape that is not moving.
+ *
+ * This is a ray cast of the circle center against the shape inflated by the circle radius,
+ * so each edge is pushed out by the radius and each vertex becomes a circle.
+ */
+template<typename T, typename Points>
+static bool sweepCircleConvex(
+    Vec2<T> circlePos,
+    T circleRad,
+    Vec2<T> move,
+
+    const Points& points,
+    Vec2<T> center,
+
+    Collision::BasicTimeOfImpact<T>* res
+)
+{
+    T resTime = std::numeric_limits<T>::max();
+    Vec2<T> resNormal;
+
+    size_t count = points.size();
+    for (size_t i = 0, j = count - 1; i < count; j = i++) {
+        Vec2<T> edgeStart = points[j];
+        Vec2<T> edgeEnd = points[i];
+
+        Vec2<T> edgeDir = edgeEnd - edgeStart;
+        T edgeLength = edgeDir.length();
+        edgeDir.normalize(edgeLength);
+
+        Vec2<T> outward = edgeDir.clone().perp();
+        if (outward * (edgeStart - center) < 0) {
+            outward.invert();
+        }
+
+        T speed = outward * move;
+
+        // only edges facing the movement can be hit
+        if (speed < 0) {
+            T dist = (outward * (circlePos - edgeStart)) - circleRad;
+            T time = -dist / speed;
+
+            if (time >= 0 && time <= 1 && time < resTime) {
+                Vec2<T> hitPos = circlePos + (move * time);
+                T along = edgeDir * (hitPos - edgeStart);
+
+                if (along >= 0 && along <= edgeLength) {
+                    resTime = time;
+                    resNormal = -outward;
+                }
+            }
+        }
+
+        T vertexTime;
+        if (sweepPointCircle(circlePos, move, edgeEnd, circleRad, &vertexTime) && vertexTime < resTime) {
+            resTime = vertexTime;
+            resNormal = (edgeEnd - (circlePos + (move * vertexTime))).normalizeSafe();
+        }
+    }
+
+    if (resTime > 1) {
+        return false;
+    }
+
+    if (res != nullptr) {
+        res->time = resTime;
+        res->normal = resNormal;
+    }
+
+    return true;
+}
+
+/**
+ * Swept separating axis test between 2 convex shapes.
+ *
+ * Shape A is treated as static and shape B moves by `move`.
+ * For each axis we find the time range where the projections overlap,
+ * the shapes collide if all ranges overlap inside the movement.
+ */
+template<typename T, typename PointsA, typename NormalsA, typename PointsB, typename NormalsB>
+static bool sweepConvex(
+    const PointsA& pointsA,
+    const NormalsA& normalsA,
+    Vec2<T> centerA,
+
+    const PointsB& pointsB,
+    const NormalsB& normalsB,
+    Vec2<T> centerB,
+
+    Vec2<T> move,
+
+    Collision::BasicTimeOfImpact<T>* res
+)
+{
+    T enterTime = -std::numeric_limits<T>::max();
+    T exitTime = std::numeric_limits<T>::max();
+    Vec2<T> enterNormal;
+
+    // axis with the smallest overlap at the start of the movement
+    // only used if the shapes are already colliding
+    T overlapDepth = std::numeric_limits<T>::max();
+    Vec2<T> overlapNormal;
+
+    auto sweepAxis = [&](Vec2<T> axis) {
+        T minA, maxA, minB, maxB;
+        projectVertices(pointsA, axis, {}, &minA, &maxA);
+        projectVertices(pointsB, axis, {}, &minB, &maxB);
+
+        // projectVertices negates the points so the movement has to be negated too
+        T speed = -(axis * move);
+
+        if (abs(speed) <= std::numeric_limits<T>::epsilon()) {
+            // not moving on this axis so it has to be overlapping already
+            if (minA >= maxB || minB >= maxA) {
+                return false;
+            }
+        } else {
+            T enter = (minA - maxB) / speed;
+            T exit = (maxA - minB) / speed;
+
+            if (enter > exit) {
+                std::swap(enter, exit);
+            }
+
+            if (enter > enterTime) {
+                enterTime = enter;
+                enterNormal = axis;
+            }
+            exitTime = std::min(exit, exitTime);
+
+            if (enterTime > exitTime || enterTime > 1 || exitTime < 0) {
+                return false;
+            }
+        }
+
+        T depth = std::min(maxB - minA, maxA - minB);
+        if (depth < overlapDepth) {
+            overlapDepth = depth;
+            overlapNormal = axis;
+        }
+
+        return true;
+    };
+
+    for (const auto& normal : normalsA) {
+        if (!sweepAxis(normal)) {
+            return false;
+        }
+    }
+
+    for (const auto& normal : normalsB) {
+        if (!sweepAxis(normal)) {
+            return false;
+        }
+    }
+
+    if (res != nullptr) {
+        bool alreadyColliding = enterTime <= 0;
+
+        T time = alreadyColliding ? T(0) : enterTime;
+        Vec2<T> normal = alreadyColliding ? overlapNormal : enterNormal;
+
+        Vec2<T> direction = (centerB + (move * time)) - centerA;
+        if (direction * normal < 0) {
+            normal.invert();
+        }
+
+        res->time = time;
+        res->normal = normal;
+    }
+
+    return true;
+}
+
+template<typename T>
+bool Collision::SweepCircleCircle(
+    Vec2<T> posA,
+    Collision::NoDeduce<T> radA,
+    Vec2<T> moveA,
+
+    Vec2<T> posB,
+    Collision::NoDeduce<T> radB,
+    Vec2<T> moveB,
+
+    Collision::BasicTimeOfImpact<Collision::NoDeduce<T>>* res
+)
+{
+    Collision::BasicResponse<T> overlap;
+    if (CircleCircle(posA, radA, posB, radB, &overlap)) {
+        if (res != nullptr) {
+            res->time = 0;
+            res->normal = overlap.normal;
+        }
+        return true;
+    }
+
+    // sweep A against B as if B wasn't moving
+    Vec2<T> move = moveA - moveB;
+
+    T time;
+    if (!sweepPointCircle(posA, move, posB, radA + radB, &time)) {
+        return false;
+    }
+
+    if (res != nullptr) {
+        res->time = time;
+        res->normal = (posB + (moveB * time) - (posA + (moveA * time))).normalizeSafe();
+    }
+
+    return true;
+}
+
+template<typename T>
+bool Collision::SweepCircleRect(
+    Vec2<T> circlePos,
+    Collision::NoDeduce<T> circleRad,
+    Vec2<T> circleMove,
+
+    Vec2<T> rectMin,
+    Vec2<T> rectMax,
+    Vec2<T> rectMove,
+
+    Collision::BasicTimeOfImpact<Collision::NoDeduce<T>>* res
+)
+{
+    Collision::BasicResponse<T> overlap;
+    if (CircleRect(circlePos, circleRad, rectMin, rectMax, &overlap)) {
+        if (res != nullptr) {
+            res->time = 0;
+            res->normal = overlap.normal;
+        }
+        return true;
+    }
+
+    Vec2<T> rectCenter = rectMin + ((rectMax - rectMin) / 2);
+
+    return sweepCircleConvex(
+        circlePos,
+        circleRad,
+        circleMove - rectMove,
+        rectToPoints(rectMin, rectMax),
+        rectCenter,
+        res
+    );
+}
+
+template<typename T>
+bool Collision::SweepCirclePolygon(
+    Vec2<T> circlePos,
+    Collision::NoDeduce<T> circleRad,
+    Vec2<T> circleMove,
+
+    const std::vector<Vec2<T>>& polyPoints,
+    const std::vector<Vec2<T>>& polyNormals,
+    Vec2<T> polyCenter,
+    Collision::NoDeduce<T> polyRadius,
+    Vec2<T> polyMove,
+
+    Collision::BasicTimeOfImpact<Collision::NoDeduce<T>>* res
+)
+{
+    if (!SweepCircleCircle(circlePos, circleRad, circleMove, polyCenter, polyRadius, polyMove, nullptr)) {
+        return false;
+    }
+
+    // CirclePolygon only tests the closest vertex axis when it has a response to fill
+    Collision::BasicResponse<T> overlap;
+    if (CirclePolygon(circlePos, circleRad, polyPoints, polyNormals, polyCenter, polyRadius, &overlap)) {
+        if (res != nullptr) {
+            res->time = 0;
+            res->normal = overlap.normal;
+        }
+        return true;
+    }
+
+    return sweepCircleConvex(
+        circlePos,
+        circleRad,
+        circleMove - polyMove,
+        polyPoints,
+        polyCenter,
+        res
+    );
+}
+
+template<typename T>
+bool Collision::SweepRectRect(
+    Vec2<T> rectAMin,
+    Vec2<T> rectAMax,
+    Vec2<T> rectAMove,
+
+    Vec2<T> rectBMin,
+    Vec2<T> rectBMax,
+    Vec2<T> rectBMove,
+
+    Collision::BasicTimeOfImpact<Collision::NoDeduce<T>>* res
+)
+{
+    return sweepConvex(
+        rectToPoints(rectAMin, rectAMax),
+        RECT_NORMALS<T>,
+        rectAMin + ((rectAMax - rectAMin) / 2),
+
+        rectToPoints(rectBMin, rectBMax),
+        std::array<Vec2<T>, 0>{},
+        rectBMin + ((rectBMax - rectBMin) / 2),
+
+        rectBMove - rectAMove,
+        res
+    );
+}
+
+template<typename T>
+bool Collision::SweepRectPolygon(
+    Vec2<T> rectMin,
+    Vec2<T> rectMax,
+    Vec2<T> rectMove,
+
+    const std::vector<Vec2<T>>& polyPoints,
+    const std::vector<Vec2<T>>& polyNormals,
+    Vec2<T> polyCenter,
+    Collision::NoDeduce<T> polyRadius,
+    Vec2<T> polyMove,
+
+    Collision::BasicTimeOfImpact<Collision::NoDeduce<T>>* res
+)
+{
+    assert(polyPoints.size() == polyNormals.size());
+
+    Vec2<T> rectCenter = rectMin + ((rectMax - rectMin) / 2);
+    T rectRadius = (rectMax - rectMin).length() / 2;
+
+    if (!SweepCircleCircle(rectCenter, rectRadius, rectMove, polyCenter, polyRadius, polyMove, nullptr)) {
+        return false;
+    }
+
+    return sweepConvex(
+        rectToPoints(rectMin, rectMax),
+        RECT_NORMALS<T>,
+        rectCenter,
+
+        polyPoints,
+        polyNormals,
+        polyCenter,
+
+        polyMove - rectMove,
+        res
+    );
+}
+
+template<typename T>
+bool Collision::SweepPolygonPolygon(
+    const std::vector<Vec2<T>>& pointsA,
+    const std::vector<Vec2<T>>& normalsA,
+    Vec2<T> centerA,
+    Collision::NoDeduce<T> radiusA,
+    Vec2<T> moveA,
+
+    const std::vector<Vec2<T>>& pointsB,
+    const std::vector<Vec2<T>>& normalsB,
+    Vec2<T> centerB,
+    Collision::NoDeduce<T> radiusB,
+    Vec2<T> moveB,
+
+    Collision::BasicTimeOfImpact<Collision::NoDeduce<T>>* res
+)
+{
+    assert(pointsA.size() == normalsA.size());
+    assert(pointsB.size() == normalsB.size());
+
+    if (!SweepCircleCircle(centerA, radiusA, moveA, centerB, radiusB, moveB, nullptr)) {
+        return false;
+    }
+
+    return sweepConvex(
+        pointsA,
+        normalsA,
+        centerA,
+
+        pointsB,
+        normalsB,
+        centerB,
+
+        moveB - moveA,
+        res
+    );
+}
+
+template<typename T>
+bool Collision::RayCircle(
+    Vec2<T> rayStart,
+    Vec2<T> rayDelta,
+
+    Vec2<T> circlePos,
+    Collision::NoDeduce<T> circleRad,
+
+    Collision::BasicRayHit<Collision::NoDeduce<T>>* res
+)
+{
+    T fraction;
+    if (!sweepPointCircle(rayStart, rayDelta, circlePos, circleRad, &fraction)) {
+        return false;
+    }
+
+    if (res != nullptr) {
+        res->fraction = fraction;
+        res->normal = (rayStart + (rayDelta * fraction) - circlePos).normalizeSafe();
+    }
+
+    return true;
+}
+
+template<typename T>
+bool Collision::RayRect(
+    Vec2<T> rayStart,
+    Vec2<T> rayDelta,
+
+    Vec2<T> rectMin,
+    Vec2<T> rectMax,
+
+    Collision::BasicRayHit<Collision::NoDeduce<T>>* res
+)
+{
+    // slab test on each axis, without the inverse trick of the batched version
+    // since huge values would overflow fixed point numbers
+    T enter = -std::numeric_limits<T>::max();
+    T exit = std::numeric_limits<T>::max();
+    uint8_t enterAxis = 0;
+
+    for (uint8_t axis = 0; axis < 2; axis++) {
+        if (rayDelta[axis] == 0) {
+            // parallel to the slab so it has to start inside it
+            if (rayStart[axis] < rectMin[axis] || rayStart[axis] > rectMax[axis]) {
+                return false;
+            }
+            continue;
+        }
+
+        T t1 = (rectMin[axis] - rayStart[axis]) / rayDelta[axis];
+        T t2 = (rectMax[axis] - rayStart[axis]) / rayDelta[axis];
+        if (t1 > t2) {
+            std::swap(t1, t2);
+        }
+
+        if (t1 > enter) {
+            enter = t1;
+            enterAxis = axis;
+        }
+        exit = std::min(exit, t2);
+    }
+
+    if (enter > exit || enter < 0 || enter > 1) {
+        return false;
+    }
+
+    if (res != nullptr) {
+        res->fraction = enter;
+        res->normal = {0, 0};
+        res->normal[enterAxis] = rayDelta[enterAxis] > 0 ? -1 : 1;
+    }
+
+    return true;
+}
+
+template<typename T>
+bool Collision::RayPolygon(
+    Vec2<T> rayStart,
+    Vec2<T> rayDelta,
+
+    const std::vector<Vec2<T>>& polyPoints,
+    const std::vector<Vec2<T>>& polyNormals,
+    Vec2<T> polyCenter,
+    Collision::NoDeduce<T> polyRadius,
+
+    Collision::BasicRayHit<Collision::NoDeduce<T>>* res
+)
+{
+    // closest point of the ray to the center is outside of the bounding circle
+    T rayLengthSqr = rayDelta.lengthSqr();
+    T closestFraction = rayLengthSqr > 0 ? std::clamp(((polyCenter - rayStart) * rayDelta) / rayLengthSqr, T(0), T(1)) : T(0);
+    if ((rayStart + (rayDelta * closestFraction) - polyCenter).lengthSqr() >= polyRadius * polyRadius) {
+        return false;
+    }
+
+    // clip the ray against the inside of each edge (Cyrus-Beck)
+    T enter = -std::numeric_limits<T>::max();
+    T exit = 1;
+    Vec2<T> enterNormal;
+
+    for (size_t i = 0; i < polyPoints.size(); i++) {
+        // polyNormals[i] belongs to the edge ending at polyPoints[i]
+        Vec2<T> normal = polyNormals[i];
+        if (normal * (polyPoints[i] - polyCenter) < 0) {
+            normal.invert();
+        }
+
+        // distance from the ray start to the edge, positive if the start is behind it
+        T dist = normal * (polyPoints[i] - rayStart);
+        T speed = normal * rayDelta;
+
+        if (abs(speed) <= std::numeric_limits<T>::epsilon()) {
+            // parallel to the edge and in front of it
+            if (dist < 0) {
+                return false;
+            }
+            continue;
+        }
+
+        T fraction = dist / speed;
+
+        if (speed < 0) {
+            if (fraction > enter) {
+                enter = fraction;
+                enterNormal = normal;
+            }
+        } else {
+            exit = std::min(exit, fraction);
+        }
+
+        if (enter > exit) {
+            return false;
+        }
+    }
+
+    if (enter < 0) {
+        return false;
+    }
+
+    if (res != nullptr) {
+        res->fraction = enter;
+        res->normal = enterNormal;
+    }
+
+    return true;
+}
+
+// The batched versions avoid branches in their loops so they can be vectorized
+
+/**
+ * Inverse of a ray component for the slab tests,
+ * rays parallel to an axis get a huge value instead of infinity so `0 * inv` stays 0
+ */
+static float slabInverse(float delta)
+{
+    if (delta == 0) {
+        return std::numeric_limits<float>::max();
+    }
+    return 1.F / delta;
+}
+
+void Collision::RayCircles(
+    Vec2F rayStart,
+    Vec2F rayDelta,
+
+    std::span<const float> circlePosX,
+    std::span<const float> circlePosY,
+    std::span<const float> circleRads,
+
+    std::span<float> outFractions
+)
+{
+    size_t count = outFractions.size();
+    assert(circlePosX.size() == count && circlePosY.size() == count && circleRads.size() == count);
+
+    float a = rayDelta.lengthSqr();
+    if (a <= std::numeric_limits<float>::min()) {
+        std::fill(outFractions.begin(), outFractions.end(), RAY_MISS);
+        return;
+    }
+    float invA = 1.F / a;
+
+    for (size_t i = 0; i < count; i++) {
+        float toStartX = rayStart.x - circlePosX[i];
+        float toStartY = rayStart.y - circlePosY[i];
+
+        float b = (toStartX * rayDelta.x) + (toStartY * rayDelta.y);
+        float c = (toStartX * toStartX) + (toStartY * toStartY) - (circleRads[i] * circleRads[i]);
+
+        float discriminant = (b * b) - (a * c);
+        float fraction = (-b - std::sqrt(std::max(discriminant, 0.F))) * invA;
+
+        // & instead of && so there's no branch
+        bool hit = (discriminant >= 0) & (fraction >= 0) & (fraction <= 1);
+        outFractions[i] = hit ? fraction : RAY_MISS;
+    }
+}
+
+void Collision::RayRects(
+    Vec2F rayStart,
+    Vec2F rayDelta,
+
+    std::span<const float> rectMinX,
+    std::span<const float> rectMinY,
+    std::span<const float> rectMaxX,
+    std::span<const float> rectMaxY,
+
+    std::span<float> outFractions
+)
+{
+    size_t count = outFractions.size();
+    assert(rectMinX.size() == count && rectMinY.size() == count);
+    assert(rectMaxX.size() == count && rectMaxY.size() == count);
+
+    float invX = slabInverse(rayDelta.x);
+    float invY = slabInverse(rayDelta.y);
+
+    for (size_t i = 0; i < count; i++) {
+        float tx1 = (rectMinX[i] - rayStart.x) * invX;
+        float tx2 = (rectMaxX[i] - rayStart.x) * invX;
+        float ty1 = (rectMinY[i] - rayStart.y) * invY;
+        float ty2 = (rectMaxY[i] - rayStart.y) * invY;
+
+        float enter = std::max(std::min(tx1, tx2), std::min(ty1, ty2));
+        float exit = std::min(std::max(tx1, tx2), std::max(ty1, ty2));
+
+        bool hit = (enter <= exit) & (enter >= 0) & (enter <= 1);
+        outFractions[i] = hit ? enter : RAY_MISS;
+    }
+}
+
+#define FC_INSTANTIATE_COLLISION(T) \
+    template bool Collision::CircleCircle<T>(Vec2<T>, T, Vec2<T>, T, Collision::BasicResponse<T>*); \
+    template bool Collision::CircleRect<T>(Vec2<T>, T, Vec2<T>, Vec2<T>, Collision::BasicResponse<T>*); \
+    template bool Collision::CirclePolygon<T>(Vec2<T>, T, const std::vector<Vec2<T>>&, const std::vector<Vec2<T>>&, Vec2<T>, T, Collision::BasicResponse<T>*); \
+    template bool Collision::RectRect<T>(Vec2<T>, Vec2<T>, Vec2<T>, Vec2<T>, Collision::BasicResponse<T>*); \
+    template bool Collision::RectPolygon<T>(Vec2<T>, Vec2<T>, const std::vector<Vec2<T>>&, const std::vector<Vec2<T>>&, Vec2<T>, T, Collision::BasicResponse<T>*, Collision::SatCache*); \
+    template bool Collision::PolygonPolygon<T>(const std::vector<Vec2<T>>&, const std::vector<Vec2<T>>&, Vec2<T>, T, const std::vector<Vec2<T>>&, const std::vector<Vec2<T>>&, Vec2<T>, T, Collision::BasicResponse<T>*, Collision::SatCache*); \
+    template bool Collision::PointCircle<T>(Vec2<T>, Vec2<T>, T); \
+    template bool Collision::PointRect<T>(Vec2<T>, Vec2<T>, Vec2<T>); \
+    template bool Collision::PointPolygon<T>(Vec2<T>, const std::vector<Vec2<T>>&); \
+    template bool Collision::ManifoldCircleCircle<T>(Vec2<T>, T, Vec2<T>, T, Collision::BasicManifold<T>*); \
+    template bool Collision::ManifoldCircleRect<T>(Vec2<T>, T, Vec2<T>, Vec2<T>, Collision::BasicManifold<T>*); \
+    template bool Collision::ManifoldCirclePolygon<T>(Vec2<T>, T, const std::vector<Vec2<T>>&, const std::vector<Vec2<T>>&, Vec2<T>, T, Collision::BasicManifold<T>*); \
+    template bool Collision::ManifoldRectRect<T>(Vec2<T>, Vec2<T>, Vec2<T>, Vec2<T>, Collision::BasicManifold<T>*); \
+    template bool Collision::ManifoldRectPolygon<T>(Vec2<T>, Vec2<T>, const std::vector<Vec2<T>>&, const std::vector<Vec2<T>>&, Vec2<T>, T, Collision::BasicManifold<T>*); \
+    template bool Collision::ManifoldPolygonPolygon<T>(const std::vector<Vec2<T>>&, const std::vector<Vec2<T>>&, Vec2<T>, T, const std::vector<Vec2<T>>&, const std::vector<Vec2<T>>&, Vec2<T>, T, Collision::BasicManifold<T>*); \
+    template bool Collision::SweepCircleCircle<T>(Vec2<T>, T, Vec2<T>, Vec2<T>, T, Vec2<T>, Collision::BasicTimeOfImpact<T>*); \
+    template bool Collision::SweepCircleRect<T>(Vec2<T>, T, Vec2<T>, Vec2<T>, Vec2<T>, Vec2<T>, Collision::BasicTimeOfImpact<T>*); \
+    template bool Collision::SweepCirclePolygon<T>(Vec2<T>, T, Vec2<T>, const std::vector<Vec2<T>>&, const std::vector<Vec2<T>>&, Vec2<T>, T, Vec2<T>, Collision::BasicTimeOfImpact<T>*); \
+    template bool Collision::SweepRectRect<T>(Vec2<T>, Vec2<T>, Vec2<T>, Vec2<T>, Vec2<T>, Vec2<T>, Collision::BasicTimeOfImpact<T>*); \
+    template bool Collision::SweepRectPolygon<T>(Vec2<T>, Vec2<T>, Vec2<T>, const std::vector<Vec2<T>>&, const std::vector<Vec2<T>>&, Vec2<T>, T, Vec2<T>, Collision::BasicTimeOfImpact<T>*); \
+    template bool Collision::SweepPolygonPolygon<T>(const std::vector<Vec2<T>>&, const std::vector<Vec2<T>>&, Vec2<T>, T, Vec2<T>, const std::vector<Vec2<T>>&, const std::vector<Vec2<T>>&, Vec2<T>, T, Vec2<T>, Collision::BasicTimeOfImpact<T>*); \
+    template bool Collision::RayCircle<T>(Vec2<T>, Vec2<T>, Vec2<T>, T, Collision::BasicRayHit<T>*); \
+    template bool Collision::RayRect<T>(Vec2<T>, Vec2<T>, Vec2<T>, Vec2<T>, Collision::BasicRayHit<T>*); \
+    template bool Collision::RayPolygon<T>(Vec2<T>, Vec2<T>, const std::vector<Vec2<T>>&, const std::vector<Vec2<T>>&, Vec2<T>, T, Collision::BasicRayHit<T>*);
+
+FC_INSTANTIATE_COLLISION(float)
+FC_INSTANTIATE_COLLISION(Fixed)
+
+#undef FC_INSTANTIATE_COLLISION
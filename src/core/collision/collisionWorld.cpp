@@ -0,0 +1,115 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/collision/collisionWorld.h"
+
+#include <algorithm>
+
+static bool aabbsOverlap(const CollisionWorld::AABB& a, const CollisionWorld::AABB& b)
+{
+    return a.first.x <= b.second.x && b.first.x <= a.second.x && a.first.y <= b.second.y && b.first.y <= a.second.y;
+}
+
+CollisionWorld::CollisionWorld(const Config& config) :
+    m_config(config),
+    m_idPool(config.maxShapes),
+    // IDs start at 1 so we need 1 extra slot
+    m_grid(config.worldSize, config.cellSize, config.maxShapes + 1)
+{
+    size_t count = config.maxShapes + 1;
+
+    m_shapes.resize(count);
+    m_aabbs.resize(count);
+    m_flags.resize(count);
+}
+
+CollisionWorld::ShapeID CollisionWorld::add(std::unique_ptr<Shape> shape)
+{
+    assert(shape != nullptr);
+
+    ShapeID id = m_idPool.getId();
+
+    m_shapes[id] = std::move(shape);
+    m_flags[id] = ALIVE;
+    insert(id);
+
+    return id;
+}
+
+void CollisionWorld::remove(ShapeID id)
+{
+    if (!isValid(id)) {
+        return;
+    }
+
+    if (isDirty(id)) {
+        m_dirty.erase(std::ranges::find(m_dirty, id));
+    }
+
+    m_grid.removeEntity(id);
+
+    m_shapes[id].reset();
+    m_flags[id] = 0;
+
+    m_idPool.giveId(id);
+}
+
+Shape& CollisionWorld::modify(ShapeID id)
+{
+    assert(isValid(id));
+
+    if (!isDirty(id)) {
+        m_flags[id] |= DIRTY;
+        m_dirty.push_back(id);
+    }
+
+    return *m_shapes[id];
+}
+
+void CollisionWorld::update()
+{
+    for (ShapeID id : m_dirty) {
+        m_flags[id] &= ~DIRTY;
+        insert(id);
+    }
+    m_dirty.clear();
+}
+
+const std::vector<CollisionWorld::ShapeID>& CollisionWorld::queryAABB(Vec2F min, Vec2F max)
+{
+    AABB bounds = {min, max};
+
+    // grid cells are coarse, filter with the exact AABBs
+    m_queryResult.clear();
+    for (ShapeID id : m_grid.queryAABB(min, max)) {
+        if (aabbsOverlap(m_aabbs[id], bounds)) {
+            m_queryResult.push_back(id);
+        }
+    }
+
+    return m_queryResult;
+}
+
+const std::vector<CollisionWorld::ShapeID>& CollisionWorld::queryShape(const Shape& shape)
+{
+    AABB bounds = shape.getAABB();
+
+    m_queryResult.clear();
+    for (ShapeID id : m_grid.queryAABB(bounds.first, bounds.second)) {
+        const Shape& other = *m_shapes[id];
+        if (&other != &shape && aabbsOverlap(m_aabbs[id], bounds) && shape.getCollision(other, nullptr)) {
+            m_queryResult.push_back(id);
+        }
+    }
+
+    return m_queryResult;
+}
+
+void CollisionWorld::insert(ShapeID id)
+{
+    m_aabbs[id] = m_shapes[id]->getAABB();
+    m_grid.insertEntity(id, m_aabbs[id].first, m_aabbs[id].second);
+}
@@ -6,22 +6,39 @@
 
 #include "fc/core/collision/shape.h"
 
-#include <cfloat>
-
-using CollisionFn = bool (*)(const Shape&, const Shape&, Collision::Response*);
-
-struct CollisionFnData
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <format>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+// called unqualified so Fixed finds its own versions
+using std::abs;
+using std::cos;
+using std::sin;
+using std::sqrt;
+
+/**
+ * Table of functions for each pair of shape types
+ *
+ * Each pair only needs to be registered once, the reverse pair is filled in
+ * with the same function and `reverse` set so the caller can swap the arguments.
+ */
+template<typename T, typename Fn>
+class ShapeFnTable
 {
-    CollisionFn fn;
-    bool reverse;
-};
+public:
+    struct Entry
+    {
+        Fn fn;
+        bool reverse;
+    };
 
-class CollisionFns
-{
-private:
-    std::array<std::array<CollisionFnData, Shape::COUNT>, Shape::COUNT> m_fns;
+    using Shape = BasicShape<T>;
 
-    void registerFn(Shape::Type typeA, Shape::Type typeB, const CollisionFn& fn)
+    void registerFn(typename Shape::Type typeA, typename Shape::Type typeB, const Fn& fn)
     {
         m_fns[typeA][typeB] = {
             .fn = fn,
@@ -36,10 +53,33 @@ private:
         }
     };
 
+    [[nodiscard]] const Entry& get(typename Shape::Type typeA, typename Shape::Type typeB) const
+    {
+        assert(typeA < Shape::COUNT);
+        assert(typeB < Shape::COUNT);
+
+        return m_fns[typeA][typeB];
+    }
+
+private:
+    std::array<std::array<Entry, Shape::COUNT>, Shape::COUNT> m_fns;
+};
+
+template<typename T>
+using CollisionFn = bool (*)(const BasicShape<T>&, const BasicShape<T>&, Collision::BasicResponse<T>*, Collision::SatCache*);
+
+template<typename T>
+class CollisionFns : public ShapeFnTable<T, CollisionFn<T>>
+{
 public:
+    using Shape = BasicShape<T>;
+    using Circle = BasicCircle<T>;
+    using Rect = BasicRect<T>;
+    using Polygon = BasicPolygon<T>;
+
     CollisionFns()
     {
-        registerFn(Shape::CIRCLE, Shape::CIRCLE, [](const Shape& shapeA, const Shape& shapeB, auto* res) {
+        this->registerFn(Shape::CIRCLE, Shape::CIRCLE, [](const Shape& shapeA, const Shape& shapeB, auto* res, auto* /*cache*/) {
             assert(shapeA.type == Shape::CIRCLE);
             assert(shapeB.type == Shape::CIRCLE);
 
@@ -47,7 +87,7 @@ public:
             const auto& b = static_cast<const Circle&>(shapeB);
             return CircleCircle(a.pos, a.rad, b.pos, b.rad, res);
         });
-        registerFn(Shape::CIRCLE, Shape::RECT, [](const Shape& shapeA, const Shape& shapeB, auto* res) {
+        this->registerFn(Shape::CIRCLE, Shape::RECT, [](const Shape& shapeA, const Shape& shapeB, auto* res, auto* /*cache*/) {
             assert(shapeA.type == Shape::CIRCLE);
             assert(shapeB.type == Shape::RECT);
 
@@ -55,15 +95,15 @@ public:
             const auto& b = static_cast<const Rect&>(shapeB);
             return CircleRect(a.pos, a.rad, b.min, b.max, res);
         });
-        registerFn(Shape::CIRCLE, Shape::POLYGON, [](const Shape& shapeA, const Shape& shapeB, auto* res) {
+        this->registerFn(Shape::CIRCLE, Shape::POLYGON, [](const Shape& shapeA, const Shape& shapeB, auto* res, auto* /*cache*/) {
             assert(shapeA.type == Shape::CIRCLE);
             assert(shapeB.type == Shape::POLYGON);
 
             const auto& a = static_cast<const Circle&>(shapeA);
             const auto& b = static_cast<const Polygon&>(shapeB);
-            return CirclePolygon(a.pos, a.rad, b.points, b.normals(), b.center(), res);
+            return CirclePolygon(a.pos, a.rad, b.points, b.normals(), b.center(), b.radius(), res);
         });
-        registerFn(Shape::RECT, Shape::RECT, [](const Shape& shapeA, const Shape& shapeB, auto* res) {
+        this->registerFn(Shape::RECT, Shape::RECT, [](const Shape& shapeA, const Shape& shapeB, auto* res, auto* /*cache*/) {
             assert(shapeA.type == Shape::RECT);
             assert(shapeB.type == Shape::RECT);
 
@@ -71,73 +111,314 @@ public:
             const auto& b = static_cast<const Rect&>(shapeB);
             return RectRect(a.min, a.max, b.min, b.max, res);
         });
-        registerFn(Shape::RECT, Shape::POLYGON, [](const Shape& shapeA, const Shape& shapeB, auto* res) {
+        this->registerFn(Shape::RECT, Shape::POLYGON, [](const Shape& shapeA, const Shape& shapeB, auto* res, auto* cache) {
             assert(shapeA.type == Shape::RECT);
             assert(shapeB.type == Shape::POLYGON);
 
             const auto& a = static_cast<const Rect&>(shapeA);
             const auto& b = static_cast<const Polygon&>(shapeB);
-            return RectPolygon(a.min, a.max, b.points, b.normals(), b.center(), res);
+            return RectPolygon(a.min, a.max, b.points, b.normals(), b.center(), b.radius(), res, cache);
         });
-        registerFn(Shape::POLYGON, Shape::POLYGON, [](const Shape& shapeA, const Shape& shapeB, auto* res) {
+        this->registerFn(Shape::POLYGON, Shape::POLYGON, [](const Shape& shapeA, const Shape& shapeB, auto* res, auto* cache) {
             assert(shapeA.type == Shape::POLYGON);
             assert(shapeB.type == Shape::POLYGON);
 
             const auto& a = static_cast<const Polygon&>(shapeA);
             const auto& b = static_cast<const Polygon&>(shapeB);
-            return PolygonPolygon(a.points, a.normals(), a.center(), b.points, b.normals(), b.center(), res);
+            return PolygonPolygon(a.points, a.normals(), a.center(), a.radius(), b.points, b.normals(), b.center(), b.radius(), res, cache);
         });
     };
 
-    bool check(const Shape& shapeA, const Shape& shapeB, Collision::Response* res) const
+    bool check(const Shape& shapeA, const Shape& shapeB, Collision::BasicResponse<T>* res, Collision::SatCache* cache) const
     {
-        assert(shapeA.type < Shape::COUNT);
-        assert(shapeB.type < Shape::COUNT);
-
-        const auto& collisionFn = m_fns[shapeA.type][shapeB.type];
+        const auto& collisionFn = this->get(shapeA.type, shapeB.type);
 
         if (collisionFn.reverse) {
-            bool collided = collisionFn.fn(shapeB, shapeA, res);
-            res->normal.invert();
+            bool collided = collisionFn.fn(shapeB, shapeA, res, cache);
+            if (collided && res != nullptr) {
+                res->normal.invert();
+            }
             return collided;
         }
 
-        return collisionFn.fn(shapeA, shapeB, res);
+        return collisionFn.fn(shapeA, shapeB, res, cache);
     };
 };
 
-bool Shape::getCollision(const Shape& other, Collision::Response* res) const
+template<typename T>
+using ManifoldFn = bool (*)(const BasicShape<T>&, const BasicShape<T>&, Collision::BasicManifold<T>*);
+
+template<typename T>
+class ManifoldFns : public ShapeFnTable<T, ManifoldFn<T>>
+{
+public:
+    using Shape = BasicShape<T>;
+    using Circle = BasicCircle<T>;
+    using Rect = BasicRect<T>;
+    using Polygon = BasicPolygon<T>;
+
+    ManifoldFns()
+    {
+        this->registerFn(Shape::CIRCLE, Shape::CIRCLE, [](const Shape& shapeA, const Shape& shapeB, auto* res) {
+            const auto& a = static_cast<const Circle&>(shapeA);
+            const auto& b = static_cast<const Circle&>(shapeB);
+            return ManifoldCircleCircle(a.pos, a.rad, b.pos, b.rad, res);
+        });
+        this->registerFn(Shape::CIRCLE, Shape::RECT, [](const Shape& shapeA, const Shape& shapeB, auto* res) {
+            const auto& a = static_cast<const Circle&>(shapeA);
+            const auto& b = static_cast<const Rect&>(shapeB);
+            return ManifoldCircleRect(a.pos, a.rad, b.min, b.max, res);
+        });
+        this->registerFn(Shape::CIRCLE, Shape::POLYGON, [](const Shape& shapeA, const Shape& shapeB, auto* res) {
+            const auto& a = static_cast<const Circle&>(shapeA);
+            const auto& b = static_cast<const Polygon&>(shapeB);
+            return ManifoldCirclePolygon(a.pos, a.rad, b.points, b.normals(), b.center(), b.radius(), res);
+        });
+        this->registerFn(Shape::RECT, Shape::RECT, [](const Shape& shapeA, const Shape& shapeB, auto* res) {
+            const auto& a = static_cast<const Rect&>(shapeA);
+            const auto& b = static_cast<const Rect&>(shapeB);
+            return ManifoldRectRect(a.min, a.max, b.min, b.max, res);
+        });
+        this->registerFn(Shape::RECT, Shape::POLYGON, [](const Shape& shapeA, const Shape& shapeB, auto* res) {
+            const auto& a = static_cast<const Rect&>(shapeA);
+            const auto& b = static_cast<const Polygon&>(shapeB);
+            return ManifoldRectPolygon(a.min, a.max, b.points, b.normals(), b.center(), b.radius(), res);
+        });
+        this->registerFn(Shape::POLYGON, Shape::POLYGON, [](const Shape& shapeA, const Shape& shapeB, auto* res) {
+            const auto& a = static_cast<const Polygon&>(shapeA);
+            const auto& b = static_cast<const Polygon&>(shapeB);
+            return ManifoldPolygonPolygon(a.points, a.normals(), a.center(), a.radius(), b.points, b.normals(), b.center(), b.radius(), res);
+        });
+    }
+
+    bool check(const Shape& shapeA, const Shape& shapeB, Collision::BasicManifold<T>* res) const
+    {
+        const auto& manifoldFn = this->get(shapeA.type, shapeB.type);
+
+        if (manifoldFn.reverse) {
+            bool collided = manifoldFn.fn(shapeB, shapeA, res);
+            if (collided && res != nullptr) {
+                res->normal.invert();
+            }
+            return collided;
+        }
+
+        return manifoldFn.fn(shapeA, shapeB, res);
+    }
+};
+
+template<typename T>
+using SweepFn = bool (*)(const BasicShape<T>&, Vec2<T>, const BasicShape<T>&, Vec2<T>, Collision::BasicTimeOfImpact<T>*);
+
+template<typename T>
+class SweepFns : public ShapeFnTable<T, SweepFn<T>>
 {
-    static const CollisionFns fns;
+public:
+    using Shape = BasicShape<T>;
+    using Circle = BasicCircle<T>;
+    using Rect = BasicRect<T>;
+    using Polygon = BasicPolygon<T>;
+
+    SweepFns()
+    {
+        this->registerFn(Shape::CIRCLE, Shape::CIRCLE, [](const Shape& shapeA, Vec2<T> moveA, const Shape& shapeB, Vec2<T> moveB, auto* res) {
+            const auto& a = static_cast<const Circle&>(shapeA);
+            const auto& b = static_cast<const Circle&>(shapeB);
+            return SweepCircleCircle(a.pos, a.rad, moveA, b.pos, b.rad, moveB, res);
+        });
+        this->registerFn(Shape::CIRCLE, Shape::RECT, [](const Shape& shapeA, Vec2<T> moveA, const Shape& shapeB, Vec2<T> moveB, auto* res) {
+            const auto& a = static_cast<const Circle&>(shapeA);
+            const auto& b = static_cast<const Rect&>(shapeB);
+            return SweepCircleRect(a.pos, a.rad, moveA, b.min, b.max, moveB, res);
+        });
+        this->registerFn(Shape::CIRCLE, Shape::POLYGON, [](const Shape& shapeA, Vec2<T> moveA, const Shape& shapeB, Vec2<T> moveB, auto* res) {
+            const auto& a = static_cast<const Circle&>(shapeA);
+            const auto& b = static_cast<const Polygon&>(shapeB);
+            return SweepCirclePolygon(a.pos, a.rad, moveA, b.points, b.normals(), b.center(), b.radius(), moveB, res);
+        });
+        this->registerFn(Shape::RECT, Shape::RECT, [](const Shape& shapeA, Vec2<T> moveA, const Shape& shapeB, Vec2<T> moveB, auto* res) {
+            const auto& a = static_cast<const Rect&>(shapeA);
+            const auto& b = static_cast<const Rect&>(shapeB);
+            return SweepRectRect(a.min, a.max, moveA, b.min, b.max, moveB, res);
+        });
+        this->registerFn(Shape::RECT, Shape::POLYGON, [](const Shape& shapeA, Vec2<T> moveA, const Shape& shapeB, Vec2<T> moveB, auto* res) {
+            const auto& a = static_cast<const Rect&>(shapeA);
+            const auto& b = static_cast<const Polygon&>(shapeB);
+            return SweepRectPolygon(a.min, a.max, moveA, b.points, b.normals(), b.center(), b.radius(), moveB, res);
+        });
+        this->registerFn(Shape::POLYGON, Shape::POLYGON, [](const Shape& shapeA, Vec2<T> moveA, const Shape& shapeB, Vec2<T> moveB, auto* res) {
+            const auto& a = static_cast<const Polygon&>(shapeA);
+            const auto& b = static_cast<const Polygon&>(shapeB);
+            return SweepPolygonPolygon(a.points, a.normals(), a.center(), a.radius(), moveA, b.points, b.normals(), b.center(), b.radius(), moveB, res);
+        });
+    }
+
+    bool check(const Shape& shapeA, Vec2<T> moveA, const Shape& shapeB, Vec2<T> moveB, Collision::BasicTimeOfImpact<T>* res) const
+    {
+        const auto& sweepFn = this->get(shapeA.type, shapeB.type);
+
+        if (sweepFn.reverse) {
+            bool collided = sweepFn.fn(shapeB, moveB, shapeA, moveA, res);
+            if (collided && res != nullptr) {
+                res->normal.invert();
+            }
+            return collided;
+        }
+
+        return sweepFn.fn(shapeA, moveA, shapeB, moveB, res);
+    }
+};
+
+/**
+ * AABB covering `bounds` from the start to the end of a movement
+ */
+template<typename T>
+static std::pair<Vec2<T>, Vec2<T>> sweptAABB(const std::pair<Vec2<T>, Vec2<T>>& bounds, Vec2<T> move)
+{
+    auto [min, max] = bounds;
+    return {Vec2<T>::min(min, min + move), Vec2<T>::max(max, max + move)};
+}
+
+/**
+ * Splits compound polygons into their parts and calls `fn(a, b)` for each pair that could touch,
+ * parts whose AABB doesn't reach the other shape are skipped.
+ *
+ * @return false if `fn` returned false to stop early
+ */
+template<typename T, typename Fn>
+static bool forEachPartPair(const BasicShape<T>& shapeA, Vec2<T> moveA, const BasicShape<T>& shapeB, Vec2<T> moveB, Fn&& fn)
+{
+    // a part swept by its own move overlaps the other AABB if it overlaps the other AABB swept backwards by that move
+    if (shapeA.type == BasicShape<T>::COMPOUND) {
+        const auto& compound = static_cast<const BasicCompoundPolygon<T>&>(shapeA);
+        auto [min, max] = sweptAABB(sweptAABB(shapeB.getAABB(), moveB), -moveA);
+
+        return compound.queryParts(min, max, [&](const BasicPolygon<T>& part) {
+            return forEachPartPair<T>(part, moveA, shapeB, moveB, fn);
+        });
+    }
+
+    if (shapeB.type == BasicShape<T>::COMPOUND) {
+        const auto& compound = static_cast<const BasicCompoundPolygon<T>&>(shapeB);
+        auto [min, max] = sweptAABB(sweptAABB(shapeA.getAABB(), moveA), -moveB);
+
+        return compound.queryParts(min, max, [&](const BasicPolygon<T>& part) {
+            return fn(shapeA, part);
+        });
+    }
+
+    return fn(shapeA, shapeB);
+}
+
+template<typename T>
+bool BasicShape<T>::getCollision(const BasicShape& other, Collision::BasicResponse<T>* res, Collision::SatCache* cache) const
+{
+    if (type == COMPOUND || other.type == COMPOUND) {
+        // keep the deepest part
+        bool collided = false;
+        forEachPartPair<T>(*this, {}, other, {}, [&](const BasicShape& a, const BasicShape& b) {
+            Collision::BasicResponse<T> partRes;
+            if (!a.getCollision(b, res != nullptr ? &partRes : nullptr)) {
+                return true;
+            }
+
+            if (res != nullptr && (!collided || partRes.depth > res->depth)) {
+                *res = partRes;
+            }
+            collided = true;
+            return res != nullptr;
+        });
+        return collided;
+    }
+
+    static const CollisionFns<T> fns;
+    return fns.check(*this, other, res, cache);
+}
+
+template<typename T>
+bool BasicShape<T>::getManifold(const BasicShape& other, Collision::BasicManifold<T>* res) const
+{
+    if (type == COMPOUND || other.type == COMPOUND) {
+        auto deepest = [](const Collision::BasicManifold<T>& manifold) {
+            return manifold.pointCount > 1 ? std::max(manifold.depths[0], manifold.depths[1]) : manifold.depths[0];
+        };
+
+        bool collided = false;
+        forEachPartPair<T>(*this, {}, other, {}, [&](const BasicShape& a, const BasicShape& b) {
+            Collision::BasicManifold<T> partRes;
+            if (!a.getManifold(b, res != nullptr ? &partRes : nullptr)) {
+                return true;
+            }
+
+            if (res != nullptr && (!collided || deepest(partRes) > deepest(*res))) {
+                *res = partRes;
+            }
+            collided = true;
+            return res != nullptr;
+        });
+        return collided;
+    }
+
+    static const ManifoldFns<T> fns;
     return fns.check(*this, other, res);
 }
 
-Circle::Circle(Vec2F pos, float rad) :
-    Shape(CIRCLE),
+template<typename T>
+bool BasicShape<T>::getTimeOfImpact(Vec2<T> move, const BasicShape& other, Vec2<T> otherMove, Collision::BasicTimeOfImpact<T>* res) const
+{
+    if (type == COMPOUND || other.type == COMPOUND) {
+        // keep the earliest part
+        bool collided = false;
+        forEachPartPair<T>(*this, move, other, otherMove, [&](const BasicShape& a, const BasicShape& b) {
+            Collision::BasicTimeOfImpact<T> partRes;
+            if (!a.getTimeOfImpact(move, b, otherMove, res != nullptr ? &partRes : nullptr)) {
+                return true;
+            }
+
+            if (res != nullptr && (!collided || partRes.time < res->time)) {
+                *res = partRes;
+            }
+            collided = true;
+            return res != nullptr;
+        });
+        return collided;
+    }
+
+    static const SweepFns<T> fns;
+    return fns.check(*this, move, other, otherMove, res);
+}
+
+template<typename T>
+BasicCircle<T>::BasicCircle(Vec2<T> pos, T rad) :
+    BasicShape<T>(BasicShape<T>::CIRCLE),
     pos(pos),
     rad(rad)
 {
     assert(rad >= 0);
 }
 
-Circle::Circle(const Circle& circ) :
-    Circle(circ.pos, circ.rad)
+template<typename T>
+BasicCircle<T>::BasicCircle(const BasicCircle& circ) :
+    BasicCircle(circ.pos, circ.rad)
 {
 }
 
-Circle::Circle(Circle&& circ) noexcept :
-    Circle({}, 0)
+template<typename T>
+BasicCircle<T>::BasicCircle(BasicCircle&& circ) noexcept :
+    BasicCircle({}, 0)
 {
     swap(*this, circ);
 }
 
-Circle& Circle::operator=(Circle circ)
+template<typename T>
+BasicCircle<T>& BasicCircle<T>::operator=(BasicCircle circ)
 {
     swap(*this, circ);
     return *this;
 }
 
-void Circle::swap(Circle& lhs, Circle& rhs) noexcept
+template<typename T>
+void BasicCircle<T>::swap(BasicCircle& lhs, BasicCircle& rhs) noexcept
 {
     using std::swap;
 
@@ -145,34 +426,51 @@ void Circle::swap(Circle& lhs, Circle& rhs) noexcept
     swap(lhs.rad, rhs.rad);
 }
 
-std::string Circle::toString() const
+template<typename T>
+std::string BasicCircle<T>::toString() const
 {
-    return std::format("Circle (X: {0:.4f}, Y: {1:.4f}, Rad: {2:.4f})", pos.x, pos.y, rad);
+    return std::format(
+        "Circle (X: {0:.4f}, Y: {1:.4f}, Rad: {2:.4f})",
+        static_cast<float>(pos.x),
+        static_cast<float>(pos.y),
+        static_cast<float>(rad)
+    );
 }
 
-bool Circle::pointInside(Vec2F point) const
+template<typename T>
+bool BasicCircle<T>::pointInside(Vec2<T> point) const
 {
     return Collision::PointCircle(point, pos, rad);
 }
 
-Vec2F Circle::center() const
+template<typename T>
+bool BasicCircle<T>::rayCast(Vec2<T> rayStart, Vec2<T> rayDelta, Collision::BasicRayHit<T>* res) const
+{
+    return Collision::RayCircle(rayStart, rayDelta, pos, rad, res);
+}
+
+template<typename T>
+Vec2<T> BasicCircle<T>::center() const
 {
     return pos;
 }
 
-Circle& Circle::translate(Vec2F posToAdd)
+template<typename T>
+BasicCircle<T>& BasicCircle<T>::translate(Vec2<T> posToAdd)
 {
     pos += posToAdd;
     return *this;
 }
 
-Circle& Circle::scale(float scale)
+template<typename T>
+BasicCircle<T>& BasicCircle<T>::scale(T scale)
 {
     rad *= scale;
     return *this;
 }
 
-std::pair<Vec2F, Vec2F> Circle::getAABB() const
+template<typename T>
+std::pair<Vec2<T>, Vec2<T>> BasicCircle<T>::getAABB() const
 {
     return {
         {pos.x - rad, pos.y - rad},
@@ -180,8 +478,9 @@ std::pair<Vec2F, Vec2F> Circle::getAABB() const
     };
 };
 
-Rect::Rect(Vec2F min, Vec2F max) :
-    Shape(RECT),
+template<typename T>
+BasicRect<T>::BasicRect(Vec2<T> min, Vec2<T> max) :
+    BasicShape<T>(BasicShape<T>::RECT),
     min(min),
     max(max)
 {
@@ -190,18 +489,21 @@ Rect::Rect(Vec2F min, Vec2F max) :
     assert(min.y < max.y);
 }
 
-Rect::Rect(const Rect& rect) :
-    Rect(rect.min, rect.max)
+template<typename T>
+BasicRect<T>::BasicRect(const BasicRect& rect) :
+    BasicRect(rect.min, rect.max)
 {
 }
 
-Rect::Rect(Rect&& rect) noexcept :
-    Rect({}, {})
+template<typename T>
+BasicRect<T>::BasicRect(BasicRect&& rect) noexcept :
+    BasicRect({}, {})
 {
     swap(*this, rect);
 }
 
-void Rect::swap(Rect& lhs, Rect& rhs) noexcept
+template<typename T>
+void BasicRect<T>::swap(BasicRect& lhs, BasicRect& rhs) noexcept
 {
     using std::swap;
 
@@ -209,22 +511,25 @@ void Rect::swap(Rect& lhs, Rect& rhs) noexcept
     swap(lhs.max, rhs.max);
 }
 
-Rect& Rect::operator=(Rect rect)
+template<typename T>
+BasicRect<T>& BasicRect<T>::operator=(BasicRect rect)
 {
     swap(*this, rect);
     return *this;
 }
 
-Rect Rect::fromDims(float width, float height, Vec2F center)
+template<typename T>
+BasicRect<T> BasicRect<T>::fromDims(T width, T height, Vec2<T> center)
 {
-    Vec2F size{width / 2, height / 2};
+    Vec2<T> size{width / 2, height / 2};
 
-    return Rect{center - size, center + size};
+    return BasicRect{center - size, center + size};
 }
 
-Rect& Rect::scale(float scale)
+template<typename T>
+BasicRect<T>& BasicRect<T>::scale(T scale)
 {
-    Vec2F center = this->center();
+    Vec2<T> center = this->center();
 
     min = (min - center) * scale + center;
     max = (max - center) * scale + center;
@@ -232,12 +537,14 @@ Rect& Rect::scale(float scale)
     return *this;
 }
 
-std::pair<Vec2F, Vec2F> Rect::getAABB() const
+template<typename T>
+std::pair<Vec2<T>, Vec2<T>> BasicRect<T>::getAABB() const
 {
     return {min, max};
 };
 
-Rect& Rect::translate(Vec2F posToAdd)
+template<typename T>
+BasicRect<T>& BasicRect<T>::translate(Vec2<T> posToAdd)
 {
     min += posToAdd;
     max += posToAdd;
@@ -245,17 +552,26 @@ Rect& Rect::translate(Vec2F posToAdd)
     return *this;
 }
 
-bool Rect::pointInside(Vec2F point) const
+template<typename T>
+bool BasicRect<T>::pointInside(Vec2<T> point) const
 {
     return Collision::PointRect(point, min, max);
 }
 
-std::string Rect::toString() const
+template<typename T>
+bool BasicRect<T>::rayCast(Vec2<T> rayStart, Vec2<T> rayDelta, Collision::BasicRayHit<T>* res) const
+{
+    return Collision::RayRect(rayStart, rayDelta, min, max, res);
+}
+
+template<typename T>
+std::string BasicRect<T>::toString() const
 {
     return std::format("Rect(Min ({}) Max ({}))", min.toString(), max.toString());
 }
 
-std::vector<Vec2F> Rect::getPoints() const
+template<typename T>
+std::vector<Vec2<T>> BasicRect<T>::getPoints() const
 {
     return {
         {max.x, min.y},
@@ -265,13 +581,15 @@ std::vector<Vec2F> Rect::getPoints() const
     };
 }
 
-Vec2F Rect::center() const
+template<typename T>
+Vec2<T> BasicRect<T>::center() const
 {
     return min + ((max - min) / 2);
 }
 
-Polygon::Polygon(std::vector<Vec2F> points) :
-    Shape(POLYGON),
+template<typename T>
+BasicPolygon<T>::BasicPolygon(std::vector<Vec2<T>> points) :
+    BasicShape<T>(BasicShape<T>::POLYGON),
     points(std::move(points)),
     m_normals(this->points.size())
 {
@@ -283,65 +601,83 @@ Polygon::Polygon(std::vector<Vec2F> points) :
     calculateCenter();
 }
 
-Polygon::Polygon(const Polygon& poly) : Polygon(poly.points)
+template<typename T>
+BasicPolygon<T>::BasicPolygon(const BasicPolygon& poly) : BasicPolygon(poly.points)
 {
 }
 
-Polygon::Polygon(Polygon&& poly) noexcept : Polygon({{}, {}, {}})
+template<typename T>
+BasicPolygon<T>::BasicPolygon(BasicPolygon&& poly) noexcept :
+    BasicShape<T>(BasicShape<T>::POLYGON),
+    points(std::move(poly.points)),
+    m_normals(std::move(poly.m_normals)),
+    m_center(poly.m_center),
+    m_radius(poly.m_radius)
 {
-    swap(*this, poly);
 }
 
-void Polygon::swap(Polygon& lhs, Polygon& rhs) noexcept
+template<typename T>
+void BasicPolygon<T>::swap(BasicPolygon& lhs, BasicPolygon& rhs) noexcept
 {
     using std::swap;
 
     swap(lhs.points, rhs.points);
     swap(lhs.m_normals, rhs.m_normals);
     swap(lhs.m_center, rhs.m_center);
+    swap(lhs.m_radius, rhs.m_radius);
 }
 
-Polygon& Polygon::operator=(Polygon poly)
+template<typename T>
+BasicPolygon<T>& BasicPolygon<T>::operator=(BasicPolygon poly)
 {
     swap(*this, poly);
     return *this;
 }
 
-Polygon Polygon::fromSides(size_t sides, Vec2F center, float radius)
+template<typename T>
+BasicPolygon<T> BasicPolygon<T>::fromSides(size_t sides, Vec2<T> center, T radius)
 {
-    std::vector<Vec2F> points;
+    std::vector<Vec2<T>> points;
     points.resize(sides);
 
-    float step = (M_PI * 2) / sides;
+    T step;
+    if constexpr (std::is_floating_point_v<T>) {
+        step = (M_PI * 2) / sides;
+    } else {
+        step = FixedConstants::TWO_PI / T((int)sides);
+    }
 
     for (size_t i = 0; i < sides; i++) {
-        float angle = step * i;
+        T angle = step * T((int)i);
 
-        Vec2F offset = {
-            std::cos(angle) * radius,
-            std::sin(angle) * radius
+        Vec2<T> offset = {
+            cos(angle) * radius,
+            sin(angle) * radius
         };
 
         points[i] = center + offset;
     }
 
-    return Polygon{points};
+    return BasicPolygon{points};
 }
 
-Polygon& Polygon::scale(float scale)
+template<typename T>
+BasicPolygon<T>& BasicPolygon<T>::scale(T scale)
 {
     for (auto& pt : points) {
-        Vec2F toCenter = m_center - pt;
-        float length = toCenter.length();
-        Vec2F dir = toCenter.normalize(length);
+        Vec2<T> toCenter = m_center - pt;
+        T length = toCenter.length();
+        Vec2<T> dir = toCenter.normalize(length);
 
         pt = m_center - (dir * (length * scale));
     }
+    m_radius *= abs(scale);
 
     return *this;
 }
 
-Polygon& Polygon::translate(Vec2F posToAdd)
+template<typename T>
+BasicPolygon<T>& BasicPolygon<T>::translate(Vec2<T> posToAdd)
 {
     for (auto& point : points) {
         point += posToAdd;
@@ -351,25 +687,23 @@ Polygon& Polygon::translate(Vec2F posToAdd)
     return *this;
 }
 
-std::pair<Vec2F, Vec2F> Polygon::getAABB() const
+template<typename T>
+std::pair<Vec2<T>, Vec2<T>> BasicPolygon<T>::getAABB() const
 {
-    Vec2F min{FLT_MAX, FLT_MAX};
-    Vec2F max{-FLT_MAX, -FLT_MAX};
-    for (const Vec2F& pt : points) {
-        min = Vec2F::min(pt, min);
-        max = Vec2F::max(pt, max);
+    Vec2<T> min{std::numeric_limits<T>::max()};
+    Vec2<T> max{std::numeric_limits<T>::lowest()};
+    for (const Vec2<T>& pt : points) {
+        min = Vec2<T>::min(pt, min);
+        max = Vec2<T>::max(pt, max);
     }
     return {min, max};
 };
 
-Polygon& Polygon::rotate(float rotation)
+template<typename T>
+BasicPolygon<T>& BasicPolygon<T>::rotate(T rotation)
 {
     for (auto& point : points) {
-        float dist = point.distanceTo(m_center);
-
-        Vec2F dir = (point - m_center).normalize().rotate(rotation).normalize();
-
-        point = m_center - (dir * dist);
+        point = m_center + (point - m_center).rotate(rotation);
     }
 
     calculateNormals();
@@ -377,12 +711,20 @@ Polygon& Polygon::rotate(float rotation)
     return *this;
 };
 
-bool Polygon::pointInside(Vec2F point) const
+template<typename T>
+bool BasicPolygon<T>::pointInside(Vec2<T> point) const
 {
     return Collision::PointPolygon(point, points);
 }
 
-std::string Polygon::toString() const
+template<typename T>
+bool BasicPolygon<T>::rayCast(Vec2<T> rayStart, Vec2<T> rayDelta, Collision::BasicRayHit<T>* res) const
+{
+    return Collision::RayPolygon(rayStart, rayDelta, points, m_normals, m_center, m_radius, res);
+}
+
+template<typename T>
+std::string BasicPolygon<T>::toString() const
 {
     std::string out = "Polygon [";
 
@@ -397,21 +739,30 @@ std::string Polygon::toString() const
     return out;
 }
 
-Vec2F Polygon::center() const
+template<typename T>
+Vec2<T> BasicPolygon<T>::center() const
 {
     return m_center;
 }
 
-void Polygon::calculateCenter()
+template<typename T>
+void BasicPolygon<T>::calculateCenter()
 {
     m_center = {0, 0};
     for (const auto& point : points) {
         m_center += point;
     }
-    m_center /= points.size();
+    m_center /= T((int)points.size());
+
+    T radiusSqr = 0;
+    for (const auto& point : points) {
+        radiusSqr = std::max(radiusSqr, (point - m_center).lengthSqr());
+    }
+    m_radius = sqrt(radiusSqr);
 }
 
-void Polygon::calculateNormals()
+template<typename T>
+void BasicPolygon<T>::calculateNormals()
 {
     size_t len = points.size();
     for (
@@ -419,35 +770,37 @@ void Polygon::calculateNormals()
         i < len;
         j = i++
     ) {
-        Vec2F pointA = points[j];
-        Vec2F pointB = points[i];
-        Vec2F edge = pointB - pointA;
+        Vec2<T> pointA = points[j];
+        Vec2<T> pointB = points[i];
+        Vec2<T> edge = pointB - pointA;
 
         m_normals[i] = edge.perp().normalize();
     }
 }
 
-[[nodiscard]] bool Polygon::isCounterClockwise(Vec2F a, Vec2F b, Vec2F c)
+template<typename T>
+[[nodiscard]] bool BasicPolygon<T>::isCounterClockwise(Vec2<T> a, Vec2<T> b, Vec2<T> c)
 {
-    float d1 = b.x * a.y + c.x * b.y + a.x * c.y;
-    float d2 = a.x * b.y + b.x * c.y + c.x * a.y;
+    T d1 = b.x * a.y + c.x * b.y + a.x * c.y;
+    T d2 = a.x * b.y + b.x * c.y + c.x * a.y;
     // d1 < d2 | counter-clockwise
     // d1 = d2 | collinear
     // d1 > d2 | clockwise
     return d1 < d2;
 }
 
-[[nodiscard]] bool Polygon::isConvex(const std::vector<Vec2F>& points)
+template<typename T>
+[[nodiscard]] bool BasicPolygon<T>::isConvex(const std::vector<Vec2<T>>& points)
 {
-    float winding = 0;
+    T winding = 0;
     size_t len = points.size();
     for (
         size_t i = 0, j = len - 1;
         i < len;
         j = i++
     ) {
-        Vec2F pointA = points[j];
-        Vec2F pointB = points[i];
+        Vec2<T> pointA = points[j];
+        Vec2<T> pointB = points[i];
 
         winding += (pointB.x - pointA.x) * (pointB.y + pointA.y);
     }
@@ -457,3 +810,412 @@ void Polygon::calculateNormals()
     // winding > 0 | clockwise
     return winding < 0;
 }
+
+template<typename T>
+BasicCompoundPolygon<T>::BasicCompoundPolygon(const std::vector<Vec2<T>>& outline) :
+    BasicShape<T>(BasicShape<T>::COMPOUND)
+{
+    assert(outline.size() >= 3);
+
+    for (auto& points : decompose(outline)) {
+        m_parts.emplace_back(std::move(points));
+    }
+    buildTree(0, (uint32_t)m_parts.size(), 1);
+
+    m_center = {0, 0};
+    for (const auto& point : outline) {
+        m_center += point;
+    }
+    m_center /= T((int)outline.size());
+
+    calculateAABB();
+}
+
+template<typename T>
+BasicCompoundPolygon<T>::BasicCompoundPolygon(const BasicCompoundPolygon& compound) :
+    BasicShape<T>(BasicShape<T>::COMPOUND),
+    m_parts(compound.m_parts),
+    m_nodes(compound.m_nodes),
+    m_center(compound.m_center)
+{
+}
+
+template<typename T>
+BasicCompoundPolygon<T>::BasicCompoundPolygon(BasicCompoundPolygon&& compound) noexcept :
+    BasicShape<T>(BasicShape<T>::COMPOUND),
+    m_parts(std::move(compound.m_parts)),
+    m_nodes(std::move(compound.m_nodes)),
+    m_center(compound.m_center)
+{
+}
+
+template<typename T>
+void BasicCompoundPolygon<T>::swap(BasicCompoundPolygon& lhs, BasicCompoundPolygon& rhs) noexcept
+{
+    using std::swap;
+
+    swap(lhs.m_parts, rhs.m_parts);
+    swap(lhs.m_nodes, rhs.m_nodes);
+    swap(lhs.m_center, rhs.m_center);
+}
+
+template<typename T>
+BasicCompoundPolygon<T>& BasicCompoundPolygon<T>::operator=(BasicCompoundPolygon compound)
+{
+    swap(*this, compound);
+    return *this;
+}
+
+template<typename T>
+std::string BasicCompoundPolygon<T>::toString() const
+{
+    std::string out = "CompoundPolygon [";
+
+    for (size_t i = 0, size = m_parts.size(); i < size; i++) {
+        out += m_parts[i].toString();
+        if (i != size - 1) {
+            out += ", ";
+        }
+    }
+    out += "]";
+
+    return out;
+}
+
+template<typename T>
+bool BasicCompoundPolygon<T>::pointInside(Vec2<T> point) const
+{
+    return !queryParts(point, point, [&](const BasicPolygon<T>& part) { return !part.pointInside(point); });
+}
+
+template<typename T>
+bool BasicCompoundPolygon<T>::rayCast(Vec2<T> rayStart, Vec2<T> rayDelta, Collision::BasicRayHit<T>* res) const
+{
+    // otherwise the ray would hit the diagonals between the parts
+    if (pointInside(rayStart)) {
+        return false;
+    }
+
+    // keep the closest part
+    bool hit = false;
+    Collision::BasicRayHit<T> closest;
+    Vec2<T> rayEnd = rayStart + rayDelta;
+    queryParts(Vec2<T>::min(rayStart, rayEnd), Vec2<T>::max(rayStart, rayEnd), [&](const BasicPolygon<T>& part) {
+        Collision::BasicRayHit<T> partHit;
+        if (!part.rayCast(rayStart, rayDelta, &partHit)) {
+            return true;
+        }
+
+        if (!hit || partHit.fraction < closest.fraction) {
+            closest = partHit;
+        }
+        hit = true;
+        return res != nullptr;
+    });
+
+    if (hit && res != nullptr) {
+        *res = closest;
+    }
+    return hit;
+}
+
+template<typename T>
+Vec2<T> BasicCompoundPolygon<T>::center() const
+{
+    return m_center;
+}
+
+template<typename T>
+BasicCompoundPolygon<T>& BasicCompoundPolygon<T>::translate(Vec2<T> posToAdd)
+{
+    for (auto& part : m_parts) {
+        part.translate(posToAdd);
+    }
+    for (auto& node : m_nodes) {
+        node.min += posToAdd;
+        node.max += posToAdd;
+    }
+    m_center += posToAdd;
+
+    return *this;
+}
+
+template<typename T>
+BasicCompoundPolygon<T>& BasicCompoundPolygon<T>::scale(T scale)
+{
+    transformPoints([&](Vec2<T> point) {
+        return m_center + ((point - m_center) * scale);
+    });
+
+    return *this;
+}
+
+template<typename T>
+BasicCompoundPolygon<T>& BasicCompoundPolygon<T>::rotate(T rotation)
+{
+    transformPoints([&](Vec2<T> point) {
+        return m_center + (point - m_center).rotate(rotation);
+    });
+
+    return *this;
+}
+
+template<typename T>
+template<typename Fn>
+void BasicCompoundPolygon<T>::transformPoints(Fn&& fn)
+{
+    for (auto& part : m_parts) {
+        for (auto& point : part.points) {
+            point = fn(point);
+        }
+        part.calculateNormals();
+        part.calculateCenter();
+    }
+
+    calculateAABB();
+}
+
+template<typename T>
+std::pair<Vec2<T>, Vec2<T>> BasicCompoundPolygon<T>::getAABB() const
+{
+    return {m_nodes[0].min, m_nodes[0].max};
+}
+
+template<typename T>
+uint32_t BasicCompoundPolygon<T>::buildTree(uint32_t begin, uint32_t end, size_t depth)
+{
+    assert(depth <= MAX_TREE_DEPTH);
+
+    auto nodeIdx = (uint32_t)m_nodes.size();
+    m_nodes.emplace_back();
+
+    if (end - begin <= PARTS_PER_LEAF) {
+        m_nodes[nodeIdx].first = begin;
+        m_nodes[nodeIdx].count = end - begin;
+        return nodeIdx;
+    }
+
+    // split at the median center along the longest side of the centers' bounds
+    Vec2<T> min = {std::numeric_limits<T>::max()};
+    Vec2<T> max = {std::numeric_limits<T>::lowest()};
+    for (uint32_t i = begin; i < end; i++) {
+        min = Vec2<T>::min(m_parts[i].center(), min);
+        max = Vec2<T>::max(m_parts[i].center(), max);
+    }
+    bool splitX = max.x - min.x >= max.y - min.y;
+
+    uint32_t mid = begin + ((end - begin) / 2);
+    std::nth_element(m_parts.begin() + begin, m_parts.begin() + mid, m_parts.begin() + end, [&](const auto& a, const auto& b) {
+        return splitX ? a.center().x < b.center().x : a.center().y < b.center().y;
+    });
+
+    buildTree(begin, mid, depth + 1);
+    uint32_t right = buildTree(mid, end, depth + 1);
+    m_nodes[nodeIdx].first = right;
+    return nodeIdx;
+}
+
+template<typename T>
+void BasicCompoundPolygon<T>::calculateAABB()
+{
+    // children always come after their parent
+    for (size_t i = m_nodes.size(); i-- > 0;) {
+        PartNode& node = m_nodes[i];
+
+        if (node.count > 0) {
+            node.min = {std::numeric_limits<T>::max()};
+            node.max = {std::numeric_limits<T>::lowest()};
+            for (uint32_t part = node.first; part < node.first + node.count; part++) {
+                auto [min, max] = m_parts[part].getAABB();
+                node.min = Vec2<T>::min(min, node.min);
+                node.max = Vec2<T>::max(max, node.max);
+            }
+        } else {
+            const PartNode& left = m_nodes[i + 1];
+            const PartNode& right = m_nodes[node.first];
+            node.min = Vec2<T>::min(left.min, right.min);
+            node.max = Vec2<T>::max(left.max, right.max);
+        }
+    }
+}
+
+/**
+ * Positive if `point` is on the left of the line going from `a` to `b`,
+ * so corners of counter-clockwise polygons are convex when it's positive
+ */
+template<typename T>
+static T sideOfLine(Vec2<T> a, Vec2<T> b, Vec2<T> point)
+{
+    return (b - a).cross(point - a);
+}
+
+template<typename T>
+std::vector<std::vector<Vec2<T>>> BasicCompoundPolygon<T>::decompose(const std::vector<Vec2<T>>& outline)
+{
+    // work with indices so shared edges between parts can be matched exactly
+    using Part = std::vector<size_t>;
+
+    auto isConvexCorner = [&](size_t prev, size_t corner, size_t next) {
+        return sideOfLine(outline[prev], outline[corner], outline[next]) > 0;
+    };
+
+    if (outline.size() < 3) {
+        throw std::invalid_argument(std::format("CompoundPolygon: outline needs at least 3 points, got {}", outline.size()));
+    }
+
+    // twice the signed area, as a fan from the first point so the products stay small
+    T area = 0;
+    for (size_t i = 1; i + 1 < outline.size(); i++) {
+        area += sideOfLine(outline[0], outline[i], outline[i + 1]);
+    }
+    if (area <= 0) {
+        throw std::invalid_argument("CompoundPolygon: outline is clockwise or has no area");
+    }
+
+    // ear clipping, each ear is a convex corner without any other point inside its triangle
+    std::vector<Part> parts;
+    std::vector<size_t> remaining(outline.size());
+    for (size_t i = 0; i < remaining.size(); i++) {
+        remaining[i] = i;
+    }
+
+    while (remaining.size() > 3) {
+        size_t count = remaining.size();
+        bool clipped = false;
+
+        for (size_t i = 0; i < count && !clipped; i++) {
+            size_t prev = remaining[(i + count - 1) % count];
+            size_t corner = remaining[i];
+            size_t next = remaining[(i + 1) % count];
+
+            if (!isConvexCorner(prev, corner, next)) {
+                continue;
+            }
+
+            bool isEar = std::ranges::none_of(remaining, [&](size_t other) {
+                if (other == prev || other == corner || other == next) {
+                    return false;
+                }
+                Vec2<T> point = outline[other];
+                return sideOfLine(outline[prev], outline[corner], point) >= 0
+                    && sideOfLine(outline[corner], outline[next], point) >= 0
+                    && sideOfLine(outline[next], outline[prev], point) >= 0;
+            });
+
+            if (isEar) {
+                parts.push_back({prev, corner, next});
+                remaining.erase(remaining.begin() + (ptrdiff_t)i);
+                clipped = true;
+            }
+        }
+
+        if (!clipped) {
+            // only collinear points are left to remove, they don't add any area
+            for (size_t i = 0; i < count && !clipped; i++) {
+                if (sideOfLine(outline[remaining[(i + count - 1) % count]], outline[remaining[i]], outline[remaining[(i + 1) % count]]) == 0) {
+                    remaining.erase(remaining.begin() + (ptrdiff_t)i);
+                    clipped = true;
+                }
+            }
+
+            // a counter-clockwise simple polygon always has an ear, stopping here would leave holes
+            if (!clipped) {
+                throw std::invalid_argument("CompoundPolygon: outline is self-intersecting");
+            }
+        }
+    }
+
+    if (remaining.size() == 3) {
+        T side = sideOfLine(outline[remaining[0]], outline[remaining[1]], outline[remaining[2]]);
+        if (side < 0) {
+            throw std::invalid_argument("CompoundPolygon: outline is self-intersecting");
+        }
+        if (side > 0) {
+            parts.push_back(remaining);
+        }
+    }
+
+    // Hertel-Mehlhorn, remove diagonals between parts as long as the merged part stays convex
+    auto isConvexPart = [&](const Part& part) {
+        size_t count = part.size();
+        for (size_t i = 0; i < count; i++) {
+            if (sideOfLine(outline[part[(i + count - 1) % count]], outline[part[i]], outline[part[(i + 1) % count]]) < 0) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // both parts are counter-clockwise so the shared edge goes in opposite directions
+    auto tryMerge = [&](const Part& partA, const Part& partB, Part& out) {
+        for (size_t edgeA = 0; edgeA < partA.size(); edgeA++) {
+            size_t from = partA[edgeA];
+            size_t to = partA[(edgeA + 1) % partA.size()];
+
+            for (size_t edgeB = 0; edgeB < partB.size(); edgeB++) {
+                if (partB[edgeB] != to || partB[(edgeB + 1) % partB.size()] != from) {
+                    continue;
+                }
+
+                // walk A from `to` back around to `from`, then the rest of B
+                out.clear();
+                for (size_t i = 0; i < partA.size(); i++) {
+                    out.push_back(partA[(edgeA + 1 + i) % partA.size()]);
+                }
+                for (size_t i = 2; i < partB.size(); i++) {
+                    out.push_back(partB[(edgeB + i) % partB.size()]);
+                }
+
+                return isConvexPart(out);
+            }
+        }
+        return false;
+    };
+
+    Part merged;
+    for (size_t a = 0; a < parts.size(); a++) {
+        for (size_t b = a + 1; b < parts.size(); b++) {
+            if (tryMerge(parts[a], parts[b], merged)) {
+                parts[a] = merged;
+                parts.erase(parts.begin() + (ptrdiff_t)b);
+                // the bigger part might merge with parts that were already checked
+                b = a;
+            }
+        }
+    }
+
+    std::vector<std::vector<Vec2<T>>> out;
+    out.reserve(parts.size());
+    for (Part& part : parts) {
+        // merging can leave straight corners, Polygon needs the first 3 points to make a turn
+        for (size_t i = 0; i < part.size() && part.size() > 3;) {
+            size_t count = part.size();
+            if (sideOfLine(outline[part[(i + count - 1) % count]], outline[part[i]], outline[part[(i + 1) % count]]) == 0) {
+                part.erase(part.begin() + (ptrdiff_t)i);
+                i = 0;
+            } else {
+                i++;
+            }
+        }
+
+        auto& points = out.emplace_back();
+        points.reserve(part.size());
+        for (size_t index : part) {
+            points.push_back(outline[index]);
+        }
+    }
+
+    return out;
+}
+
+template class BasicShape<float>;
+template class BasicCircle<float>;
+template class BasicRect<float>;
+template class BasicPolygon<float>;
+template class BasicCompoundPolygon<float>;
+
+template class BasicShape<Fixed>;
+template class BasicCircle<Fixed>;
+template class BasicRect<Fixed>;
+template class BasicPolygon<Fixed>;
+template class BasicCompoundPolygon<Fixed>;
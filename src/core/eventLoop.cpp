@@ -0,0 +1,414 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/eventLoop.h"
+
+#include "fc/core/tickSchedule.h"
+
+#include <uv.h>
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+static uint64_t toMilliseconds(double seconds)
+{
+    return (uint64_t)std::ceil(std::max(seconds, 0.0) * 1000);
+}
+
+struct EventLoop::Impl
+{
+    uv_loop_t loop;
+    uv_async_t async;
+
+    /**
+     * Set by the destructor, file operations still finish but their callbacks aren't called
+     */
+    bool closing = false;
+};
+
+struct EventLoop::Handle
+{
+    enum class Type : uint8_t
+    {
+        TIMEOUT,
+        INTERVAL,
+        TICKER,
+        IDLE,
+    };
+
+    union
+    {
+        uv_handle_t handle;
+        uv_timer_t timer;
+        uv_idle_t idle;
+    } uv;
+
+    EventLoop* loop = nullptr;
+    HandleID id = 0;
+    Type type = Type::TIMEOUT;
+    bool cancelled = false;
+
+    Callback fn;
+    TickCallback tickFn;
+
+    // tickers only
+    std::optional<TickSchedule> schedule;
+    uint32_t tick = 0;
+
+    static Handle& of(uv_handle_t* handle)
+    {
+        return *static_cast<Handle*>(handle->data);
+    }
+
+    static void onTimeout(uv_timer_t* timer)
+    {
+        Handle& handle = of((uv_handle_t*)timer);
+
+        // the handle is gone once cancelled, keep the callback alive while it runs
+        Callback fn = std::move(handle.fn);
+        handle.loop->cancel(handle.id);
+        fn();
+    }
+
+    static void onInterval(uv_timer_t* timer)
+    {
+        of((uv_handle_t*)timer).fn();
+    }
+
+    static void onTicker(uv_timer_t* timer)
+    {
+        Handle& handle = of((uv_handle_t*)timer);
+        handle.loop->runTicks(handle);
+    }
+
+    static void onIdle(uv_idle_t* idle)
+    {
+        of((uv_handle_t*)idle).fn();
+    }
+};
+
+struct EventLoop::FileOp
+{
+    enum class Stage : uint8_t
+    {
+        OPEN,
+        STAT,
+        TRANSFER,
+        CLOSE,
+    };
+
+    uv_fs_t req;
+    EventLoop* loop = nullptr;
+    Stage stage = Stage::OPEN;
+    bool isWrite = false;
+
+    std::string path;
+    uv_file file = -1;
+    std::vector<uint8_t> bytes;
+    size_t offset = 0;
+    std::string error;
+
+    ReadCallback readFn;
+    WriteCallback writeFn;
+
+    static void onDone(uv_fs_t* req)
+    {
+        auto* op = static_cast<FileOp*>(req->data);
+        op->loop->fileStep(op, req->result);
+    }
+};
+
+EventLoop::EventLoop() :
+    m_impl(std::make_unique<Impl>())
+{
+    int result = uv_loop_init(&m_impl->loop);
+    if (result < 0) {
+        throw std::runtime_error(std::format("EventLoop: couldn't make the loop: {}", uv_strerror(result)));
+    }
+
+    uv_async_init(&m_impl->loop, &m_impl->async, [](uv_async_t* async) {
+        static_cast<EventLoop*>(async->data)->runPosted();
+    });
+    m_impl->async.data = this;
+    // posts alone don't keep the loop running
+    uv_unref((uv_handle_t*)&m_impl->async);
+}
+
+EventLoop::~EventLoop()
+{
+    m_impl->closing = true;
+
+    while (!m_handles.empty()) {
+        cancel(m_handles.begin()->first);
+    }
+    uv_close((uv_handle_t*)&m_impl->async, nullptr);
+
+    // runs the close callbacks and waits for the file operations in flight
+    uv_run(&m_impl->loop, UV_RUN_DEFAULT);
+    uv_loop_close(&m_impl->loop);
+}
+
+void EventLoop::run()
+{
+    uv_run(&m_impl->loop, UV_RUN_DEFAULT);
+}
+
+bool EventLoop::runOnce()
+{
+    return uv_run(&m_impl->loop, UV_RUN_NOWAIT) != 0;
+}
+
+void EventLoop::stop()
+{
+    uv_stop(&m_impl->loop);
+}
+
+double EventLoop::now()
+{
+    return (double)uv_hrtime() / 1e9;
+}
+
+EventLoop::Handle& EventLoop::addHandle()
+{
+    auto handle = std::make_unique<Handle>();
+    handle->loop = this;
+    handle->id = m_nextHandleID++;
+
+    Handle& ref = *handle;
+    m_handles.emplace(ref.id, std::move(handle));
+    return ref;
+}
+
+EventLoop::HandleID EventLoop::setTimeout(double seconds, Callback fn)
+{
+    Handle& handle = addHandle();
+    handle.type = Handle::Type::TIMEOUT;
+    handle.fn = std::move(fn);
+
+    uv_timer_init(&m_impl->loop, &handle.uv.timer);
+    handle.uv.handle.data = &handle;
+    uv_timer_start(&handle.uv.timer, Handle::onTimeout, toMilliseconds(seconds), 0);
+    return handle.id;
+}
+
+EventLoop::HandleID EventLoop::setInterval(double seconds, Callback fn)
+{
+    Handle& handle = addHandle();
+    handle.type = Handle::Type::INTERVAL;
+    handle.fn = std::move(fn);
+
+    // a repeat of 0 means no repeat for libuv
+    uint64_t interval = std::max<uint64_t>(toMilliseconds(seconds), 1);
+
+    uv_timer_init(&m_impl->loop, &handle.uv.timer);
+    handle.uv.handle.data = &handle;
+    uv_timer_start(&handle.uv.timer, Handle::onInterval, interval, interval);
+    return handle.id;
+}
+
+EventLoop::HandleID EventLoop::setTicker(uint32_t rate, TickCallback fn)
+{
+    if (rate == 0) {
+        throw std::invalid_argument("setTicker: rate must be above 0");
+    }
+
+    Handle& handle = addHandle();
+    handle.type = Handle::Type::TICKER;
+    handle.tickFn = std::move(fn);
+    handle.schedule.emplace(rate);
+    handle.schedule->start(now());
+
+    uv_timer_init(&m_impl->loop, &handle.uv.timer);
+    handle.uv.handle.data = &handle;
+    uv_timer_start(&handle.uv.timer, Handle::onTicker, 0, 0);
+    return handle.id;
+}
+
+EventLoop::HandleID EventLoop::setIdle(Callback fn)
+{
+    Handle& handle = addHandle();
+    handle.type = Handle::Type::IDLE;
+    handle.fn = std::move(fn);
+
+    uv_idle_init(&m_impl->loop, &handle.uv.idle);
+    handle.uv.handle.data = &handle;
+    uv_idle_start(&handle.uv.idle, Handle::onIdle);
+    return handle.id;
+}
+
+void EventLoop::cancel(HandleID id)
+{
+    auto it = m_handles.find(id);
+    if (it == m_handles.end()) {
+        return;
+    }
+
+    // libuv frees handles asynchronously, the close callback owns it from now on
+    Handle* handle = it->second.release();
+    m_handles.erase(it);
+
+    handle->cancelled = true;
+    uv_close(&handle->uv.handle, [](uv_handle_t* uvHandle) {
+        delete &Handle::of(uvHandle);
+    });
+}
+
+void EventLoop::runTicks(Handle& handle)
+{
+    TickSchedule& schedule = *handle.schedule;
+    double time = now();
+
+    while (!handle.cancelled && schedule.next(time)) {
+        handle.tickFn(handle.tick, schedule.period());
+        handle.tick++;
+    }
+
+    if (handle.cancelled) {
+        return;
+    }
+
+    // libuv timers are in whole milliseconds, rounding up means it never wakes early and spins.
+    // The schedule comes from nextTime so the rounding doesn't add up over ticks
+    uv_update_time(&m_impl->loop);
+    uv_timer_start(&handle.uv.timer, Handle::onTicker, toMilliseconds(schedule.nextTime() - now()), 0);
+}
+
+void EventLoop::post(Callback fn)
+{
+    {
+        std::lock_guard lock(m_postMutex);
+        m_posted.push_back(std::move(fn));
+    }
+    uv_async_send(&m_impl->async);
+}
+
+void EventLoop::runPosted()
+{
+    std::vector<Callback> posted;
+    {
+        std::lock_guard lock(m_postMutex);
+        posted.swap(m_posted);
+    }
+
+    for (Callback& fn : posted) {
+        fn();
+    }
+}
+
+void EventLoop::readFile(const std::string& path, ReadCallback fn)
+{
+    auto* op = new FileOp();
+    op->loop = this;
+    op->path = path;
+    op->readFn = std::move(fn);
+    op->req.data = op;
+
+    int result = uv_fs_open(&m_impl->loop, &op->req, path.c_str(), UV_FS_O_RDONLY, 0, FileOp::onDone);
+    if (result < 0) {
+        fileStep(op, result);
+    }
+}
+
+void EventLoop::writeFile(const std::string& path, std::vector<uint8_t> bytes, WriteCallback fn)
+{
+    auto* op = new FileOp();
+    op->loop = this;
+    op->isWrite = true;
+    op->path = path;
+    op->bytes = std::move(bytes);
+    op->writeFn = std::move(fn);
+    op->req.data = op;
+
+    int flags = UV_FS_O_WRONLY | UV_FS_O_CREAT | UV_FS_O_TRUNC;
+    int result = uv_fs_open(&m_impl->loop, &op->req, path.c_str(), flags, 0644, FileOp::onDone);
+    if (result < 0) {
+        fileStep(op, result);
+    }
+}
+
+void EventLoop::fileStep(FileOp* op, intptr_t result)
+{
+    using Stage = FileOp::Stage;
+
+    uv_loop_t* loop = &m_impl->loop;
+    uint64_t fileSize = op->req.statbuf.st_size;
+    uv_fs_req_cleanup(&op->req);
+
+    if (result < 0 && op->stage != Stage::CLOSE) {
+        std::string_view action = op->stage == Stage::OPEN ? "open" : (op->isWrite ? "write" : "read");
+        op->error = std::format("EventLoop: couldn't {} {}: {}", action, op->path, uv_strerror((int)result));
+    }
+
+    switch (op->stage) {
+        case Stage::OPEN:
+            if (op->error.empty()) {
+                op->file = (uv_file)result;
+            }
+            op->stage = op->isWrite ? Stage::TRANSFER : Stage::STAT;
+            break;
+
+        case Stage::STAT:
+            if (op->error.empty()) {
+                op->bytes.resize(fileSize);
+            }
+            op->stage = Stage::TRANSFER;
+            break;
+
+        case Stage::TRANSFER:
+            if (result == 0 && !op->isWrite) {
+                // the file got shorter since it was stat'd
+                op->bytes.resize(op->offset);
+            } else if (result > 0) {
+                op->offset += result;
+            }
+            break;
+
+        case Stage::CLOSE:
+            if (!m_impl->closing) {
+                if (op->isWrite) {
+                    op->writeFn(op->error.empty() ? WriteResult() : std::unexpected(op->error));
+                } else if (op->error.empty()) {
+                    op->readFn(std::move(op->bytes));
+                } else {
+                    op->readFn(std::unexpected(op->error));
+                }
+            }
+            delete op;
+            return;
+    }
+
+    int submitted = 0;
+    bool done = !op->error.empty() || (op->stage == Stage::TRANSFER && op->offset >= op->bytes.size());
+
+    if (done && op->file < 0) {
+        // never opened, nothing to close
+        op->stage = Stage::CLOSE;
+        fileStep(op, 0);
+        return;
+    }
+
+    if (done) {
+        op->stage = Stage::CLOSE;
+        submitted = uv_fs_close(loop, &op->req, op->file, FileOp::onDone);
+    } else if (op->stage == Stage::STAT) {
+        submitted = uv_fs_fstat(loop, &op->req, op->file, FileOp::onDone);
+    } else {
+        uv_buf_t buff = uv_buf_init((char*)op->bytes.data() + op->offset, (unsigned int)(op->bytes.size() - op->offset));
+        if (op->isWrite) {
+            submitted = uv_fs_write(loop, &op->req, op->file, &buff, 1, (int64_t)op->offset, FileOp::onDone);
+        } else {
+            submitted = uv_fs_read(loop, &op->req, op->file, &buff, 1, (int64_t)op->offset, FileOp::onDone);
+        }
+    }
+
+    if (submitted < 0) {
+        fileStep(op, submitted);
+    }
+}
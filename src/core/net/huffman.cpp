@@ -0,0 +1,211 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/net/huffman.h"
+
+#include <algorithm>
+#include <format>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+static HuffmanModel::CodeLengths huffmanLengths(const HuffmanModel::ByteCounts& weights)
+{
+    // 256 leaves then the 255 nodes made by merging them, the root is last
+    constexpr size_t NODE_COUNT = (256 * 2) - 1;
+    std::array<uint64_t, NODE_COUNT> nodeWeights{};
+    std::array<uint16_t, NODE_COUNT> parents{};
+
+    // lightest first, ties by node index so the same counts always give the same code
+    using Item = std::pair<uint64_t, uint16_t>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<>> queue;
+    for (uint16_t i = 0; i < 256; i++) {
+        nodeWeights[i] = weights[i];
+        queue.emplace(weights[i], i);
+    }
+
+    for (uint16_t node = 256; node < NODE_COUNT; node++) {
+        auto [weightA, a] = queue.top();
+        queue.pop();
+        auto [weightB, b] = queue.top();
+        queue.pop();
+
+        parents[a] = node;
+        parents[b] = node;
+        nodeWeights[node] = weightA + weightB;
+        queue.emplace(nodeWeights[node], node);
+    }
+
+    // parents are always after their children so walking back down gives every depth
+    std::array<uint16_t, NODE_COUNT> depths{};
+    for (size_t node = NODE_COUNT - 1; node-- > 0;) {
+        depths[node] = depths[parents[node]] + 1;
+    }
+
+    HuffmanModel::CodeLengths lengths{};
+    for (size_t i = 0; i < 256; i++) {
+        lengths[i] = (uint8_t)std::min<uint16_t>(depths[i], UINT8_MAX);
+    }
+    return lengths;
+}
+
+void HuffmanModel::count(ByteCounts& counts, std::span<const uint8_t> packet)
+{
+    for (uint8_t byte : packet) {
+        counts[byte]++;
+    }
+}
+
+HuffmanModel::HuffmanModel(const ByteCounts& counts)
+{
+    ByteCounts weights;
+    for (size_t i = 0; i < 256; i++) {
+        weights[i] = std::max<uint64_t>(counts[i], 1);
+    }
+
+    // flatten the counts until the rare bytes fit in MAX_CODE_BITS,
+    // they're rare so their longer codes barely matter
+    while (true) {
+        m_lengths = huffmanLengths(weights);
+        if (std::ranges::max(m_lengths) <= MAX_CODE_BITS) {
+            break;
+        }
+
+        for (uint64_t& weight : weights) {
+            weight = std::max<uint64_t>(weight >> 1, 1);
+        }
+    }
+
+    buildCodes();
+}
+
+HuffmanModel HuffmanModel::fromCodeLengths(const CodeLengths& lengths)
+{
+    // a complete code fills the whole table, no gaps and no overlaps
+    size_t tableSlots = 0;
+    for (uint8_t length : lengths) {
+        if (length == 0 || length > MAX_CODE_BITS) {
+            throw std::invalid_argument(std::format("HuffmanModel: invalid code length {}", length));
+        }
+        tableSlots += size_t{1} << (MAX_CODE_BITS - length);
+    }
+
+    if (tableSlots != (size_t{1} << MAX_CODE_BITS)) {
+        throw std::invalid_argument("HuffmanModel: code lengths aren't the ones of a complete code");
+    }
+
+    HuffmanModel model;
+    model.m_lengths = lengths;
+    model.buildCodes();
+    return model;
+}
+
+void HuffmanModel::buildCodes()
+{
+    // canonical codes, by length then by byte, so the lengths are enough to rebuild them
+    std::array<uint16_t, MAX_CODE_BITS + 1> lengthCounts{};
+    for (uint8_t length : m_lengths) {
+        lengthCounts[length]++;
+    }
+
+    std::array<uint16_t, MAX_CODE_BITS + 1> nextCode{};
+    uint16_t code = 0;
+    for (size_t length = 1; length <= MAX_CODE_BITS; length++) {
+        code = (code + lengthCounts[length - 1]) << 1;
+        nextCode[length] = code;
+    }
+
+    m_table.assign(size_t{1} << MAX_CODE_BITS, {});
+
+    for (size_t byte = 0; byte < 256; byte++) {
+        uint8_t length = m_lengths[byte];
+        uint16_t canonical = nextCode[length]++;
+
+        uint16_t reversed = 0;
+        for (uint8_t bit = 0; bit < length; bit++) {
+            reversed |= ((canonical >> bit) & 1) << (length - 1 - bit);
+        }
+        m_codes[byte] = reversed;
+
+        // every table index that starts with the code
+        for (size_t rest = 0; rest < (size_t{1} << (MAX_CODE_BITS - length)); rest++) {
+            m_table[reversed | (rest << length)] = {(uint8_t)byte, length};
+        }
+    }
+}
+
+size_t HuffmanModel::encodedBits(std::span<const uint8_t> bytes) const
+{
+    size_t bits = 0;
+    for (uint8_t byte : bytes) {
+        bits += m_lengths[byte];
+    }
+    return bits;
+}
+
+void HuffmanModel::compress(BitStream& stream, std::span<const uint8_t> bytes) const
+{
+    size_t bits = encodedBits(bytes);
+    bool encoded = bits < bytes.size() * 8;
+
+    stream.writeBool(encoded);
+    stream.writeVarUint(bytes.size());
+
+    if (!encoded) {
+        stream.writeBytes(bytes.data(), bytes.size());
+        return;
+    }
+
+    BitStream::UncheckedWriter writer(stream, bits);
+    for (uint8_t byte : bytes) {
+        writer.writeBits(m_codes[byte], m_lengths[byte]);
+    }
+}
+
+void HuffmanModel::decompress(BitStream& stream, std::vector<uint8_t>& bytes) const
+{
+    bool encoded = stream.readBool();
+    uint64_t size = stream.readVarUint();
+
+    // every byte takes at least a bit, don't trust a size that can't fit before resizing
+    if (size > stream.bitSize() - stream.bitIndex()) {
+        throw std::out_of_range(std::format("HuffmanModel: {} bytes can't fit in the stream", size));
+    }
+    bytes.resize(size);
+
+    if (!encoded) {
+        stream.readBytes(bytes.data(), bytes.size());
+        return;
+    }
+
+    constexpr size_t TABLE_MASK = (size_t{1} << MAX_CODE_BITS) - 1;
+    constexpr size_t BYTES_PER_PEEK = 4;
+
+    const TableEntry* table = m_table.data();
+    uint8_t* out = bytes.data();
+
+    // a few codes per peek, moving the index once
+    size_t i = 0;
+    for (; i + BYTES_PER_PEEK <= bytes.size(); i += BYTES_PER_PEEK) {
+        uint64_t bits = stream.peekBits(MAX_CODE_BITS * BYTES_PER_PEEK);
+        size_t used = 0;
+
+        for (size_t j = 0; j < BYTES_PER_PEEK; j++) {
+            TableEntry entry = table[(bits >> used) & TABLE_MASK];
+            out[i + j] = entry.byte;
+            used += entry.length;
+        }
+
+        stream.setBitIndex(stream.bitIndex() + used);
+    }
+
+    for (; i < bytes.size(); i++) {
+        TableEntry entry = table[stream.peekBits(MAX_CODE_BITS)];
+        out[i] = entry.byte;
+        stream.setBitIndex(stream.bitIndex() + entry.length);
+    }
+}
@@ -0,0 +1,85 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/net/interestManager.h"
+
+#include <algorithm>
+#include <iterator>
+#include <span>
+
+InterestManager::InterestManager(ClientID maxClientID) :
+    m_clients(maxClientID + 1)
+{
+}
+
+void InterestManager::setView(ClientID client, Vec2F min, Vec2F max)
+{
+    Client& state = m_clients.at(client);
+    state.active = true;
+    state.min = min;
+    state.max = max;
+}
+
+void InterestManager::removeClient(ClientID client)
+{
+    Client& state = m_clients.at(client);
+    state.active = false;
+    state.visible.clear();
+    state.entered.clear();
+    state.left.clear();
+    state.kept.clear();
+    state.previous.clear();
+}
+
+void InterestManager::update(const SpatialGrid& grid, ThreadPool* pool)
+{
+    auto updateRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            if (m_clients[i].active) {
+                updateClient(m_clients[i], grid);
+            }
+        }
+    };
+
+    // each client only touches its own lists and the appending grid query doesn't write to the grid
+    if (pool != nullptr) {
+        pool->parallelFor(m_clients.size(), 4, updateRange);
+    } else {
+        updateRange(0, m_clients.size());
+    }
+}
+
+void InterestManager::updateClient(Client& client, const SpatialGrid& grid)
+{
+    client.previous.swap(client.visible);
+    client.visible.clear();
+
+    // entities spanning several cells show up once per cell
+    grid.queryAABB(client.min, client.max, client.visible);
+    std::ranges::sort(client.visible);
+    auto duplicates = std::ranges::unique(client.visible);
+    client.visible.erase(duplicates.begin(), duplicates.end());
+
+    client.entered.clear();
+    client.left.clear();
+    client.kept.clear();
+    std::ranges::set_difference(client.visible, client.previous, std::back_inserter(client.entered));
+    std::ranges::set_difference(client.previous, client.visible, std::back_inserter(client.left));
+    std::ranges::set_intersection(client.visible, client.previous, std::back_inserter(client.kept));
+}
+
+void InterestManager::filter(ClientID client, const Snapshot& world, Snapshot& out) const
+{
+    out.clear(world.tick());
+
+    // a client sees a small part of the world, searching for each of its entities beats walking the whole world
+    for (EntityID id : m_clients[client].visible) {
+        std::span<const uint32_t> fields = world.find(id);
+        if (!fields.empty()) {
+            out.add(id, fields);
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/net/priorityAccumulator.h"
+
+#include <algorithm>
+
+PriorityAccumulator::PriorityAccumulator(EntityID maxEntityID) :
+    m_priorities(maxEntityID + 1, 0),
+    m_queued(maxEntityID + 1, 0),
+    m_idBits((uint8_t)std::bit_width(maxEntityID))
+{
+}
+
+void PriorityAccumulator::accumulate(EntityID id, float priority)
+{
+    if (!(priority > 0)) {
+        return;
+    }
+
+    m_priorities.at(id) += priority;
+    if (m_queued[id] == 0) {
+        m_queued[id] = 1;
+        m_queue.push_back(id);
+    }
+}
+
+void PriorityAccumulator::remove(EntityID id)
+{
+    // stays queued until the next write drops it, so it's never queued twice
+    m_priorities.at(id) = 0;
+}
+
+void PriorityAccumulator::sortQueue()
+{
+    markSent();
+
+    // ties by ID so the same priorities always give the same packet
+    std::ranges::sort(m_queue, [this](EntityID a, EntityID b) {
+        float priorityA = m_priorities[a];
+        float priorityB = m_priorities[b];
+        return priorityA > priorityB || (priorityA == priorityB && a < b);
+    });
+}
+
+void PriorityAccumulator::markSent()
+{
+    std::erase_if(m_queue, [this](EntityID id) {
+        if (m_priorities[id] == 0) {
+            m_queued[id] = 0;
+            return true;
+        }
+        return false;
+    });
+}
@@ -0,0 +1,266 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/net/snapshot.h"
+
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
+/**
+ * Reads an ID written as the gap from the one after the last, `nextId` starts at 0.
+ * A gap that would go past the largest ID is rejected, wrapping around would break the ordering the snapshot relies on
+ */
+static Snapshot::EntityID readNextId(BitStream& stream, uint64_t& nextId)
+{
+    uint64_t gap = stream.readExpGolomb();
+    if (nextId > UINT32_MAX || gap > UINT32_MAX - nextId) {
+        throw std::out_of_range(std::format("SnapshotDecoder: ID gap of {} after {} is past the largest ID", gap, nextId));
+    }
+
+    auto id = (Snapshot::EntityID)(nextId + gap);
+    nextId = (uint64_t)id + 1;
+    return id;
+}
+
+std::span<const uint32_t> Snapshot::find(EntityID id) const
+{
+    auto it = std::ranges::lower_bound(m_ids, id);
+    if (it == m_ids.end() || *it != id) {
+        return {};
+    }
+
+    return fields(it - m_ids.begin());
+}
+
+SnapshotHistory::SnapshotHistory(size_t fieldCount, size_t capacity) :
+    m_snapshots(capacity, Snapshot(fieldCount)),
+    m_used(capacity, false)
+{
+    assert(capacity > 0);
+}
+
+Snapshot& SnapshotHistory::next(uint32_t tick)
+{
+    size_t slot = tick % m_snapshots.size();
+
+    m_used[slot] = true;
+    m_snapshots[slot].clear(tick);
+    return m_snapshots[slot];
+}
+
+const Snapshot* SnapshotHistory::find(uint32_t tick) const
+{
+    size_t slot = tick % m_snapshots.size();
+    if (!m_used[slot] || m_snapshots[slot].tick() != tick) {
+        return nullptr;
+    }
+
+    return &m_snapshots[slot];
+}
+
+const Snapshot& SnapshotHistory::swapIn(Snapshot& snapshot)
+{
+    size_t slot = snapshot.tick() % m_snapshots.size();
+
+    m_used[slot] = true;
+    m_snapshots[slot].swap(snapshot);
+    return m_snapshots[slot];
+}
+
+//
+// Format:
+// tick, has baseline, ticks since the baseline,
+// removed count, removed IDs,
+// changed count, changed entities: ID, changed fields mask, changed fields
+//
+// IDs are sorted so they're written as the gap since the previous one
+//
+
+SnapshotEncoder::SnapshotEncoder(std::vector<uint8_t> fieldBits, size_t historySize) :
+    m_fieldBits(std::move(fieldBits)),
+    m_history(m_fieldBits.size(), historySize)
+{
+    assert(m_fieldBits.size() <= MAX_FIELDS);
+    assert(std::ranges::all_of(m_fieldBits, [](uint8_t bits) { return bits <= 32; }));
+}
+
+Snapshot& SnapshotEncoder::next(uint32_t tick)
+{
+    Snapshot& snapshot = m_history.next(tick);
+    m_current = &snapshot;
+    return snapshot;
+}
+
+bool SnapshotEncoder::write(BitStream& stream, uint32_t ackedTick)
+{
+    assert(m_current != nullptr);
+    const Snapshot& current = *m_current;
+
+    const Snapshot* baseline = nullptr;
+    if (ackedTick != NO_BASELINE && ackedTick <= current.tick()) {
+        baseline = m_history.find(ackedTick);
+    }
+    size_t baselineSize = baseline != nullptr ? baseline->size() : 0;
+
+    // compare both snapshots in one pass, they're sorted by ID
+    m_changes.clear();
+    m_removed.clear();
+
+    size_t fieldCount = m_fieldBits.size();
+    size_t j = 0;
+    for (size_t i = 0; i < current.size(); i++) {
+        Snapshot::EntityID id = current.id(i);
+
+        while (j < baselineSize && baseline->id(j) < id) {
+            m_removed.push_back(baseline->id(j));
+            j++;
+        }
+
+        auto fields = current.fields(i);
+        uint32_t mask = 0;
+
+        if (j < baselineSize && baseline->id(j) == id) {
+            auto baseFields = baseline->fields(j);
+            for (size_t f = 0; f < fieldCount; f++) {
+                mask |= (fields[f] != baseFields[f] ? 1u : 0u) << f;
+            }
+            j++;
+
+            if (mask == 0) {
+                continue;
+            }
+        } else {
+            // new entity, written even if all its fields are 0 so it's created
+            for (size_t f = 0; f < fieldCount; f++) {
+                mask |= (fields[f] != 0 ? 1u : 0u) << f;
+            }
+        }
+
+        m_changes.push_back({id, (uint32_t)i, mask});
+    }
+    for (; j < baselineSize; j++) {
+        m_removed.push_back(baseline->id(j));
+    }
+
+    stream.writeUint32(current.tick());
+    stream.writeBool(baseline != nullptr);
+    if (baseline != nullptr) {
+        stream.writeVarUint(current.tick() - baseline->tick());
+    }
+
+    stream.writeVarUint(m_removed.size());
+    Snapshot::EntityID nextId = 0;
+    for (Snapshot::EntityID id : m_removed) {
+        stream.writeExpGolomb(id - nextId);
+        nextId = id + 1;
+    }
+
+    stream.writeVarUint(m_changes.size());
+    nextId = 0;
+    for (const Change& change : m_changes) {
+        stream.writeExpGolomb(change.id - nextId);
+        nextId = change.id + 1;
+
+        stream.writeBits<uint32_t>(change.mask, fieldCount);
+
+        auto fields = current.fields(change.index);
+        for (size_t f = 0; f < fieldCount; f++) {
+            if ((change.mask & (1u << f)) != 0) {
+                stream.writeBits<uint32_t>(fields[f], m_fieldBits[f]);
+            }
+        }
+    }
+
+    return baseline != nullptr;
+}
+
+SnapshotDecoder::SnapshotDecoder(std::vector<uint8_t> fieldBits, size_t historySize) :
+    m_fieldBits(std::move(fieldBits)),
+    m_history(m_fieldBits.size(), historySize),
+    m_decoded(m_fieldBits.size()),
+    m_scratchFields(m_fieldBits.size())
+{
+    assert(m_fieldBits.size() <= SnapshotEncoder::MAX_FIELDS);
+}
+
+const Snapshot& SnapshotDecoder::read(BitStream& stream)
+{
+    uint32_t tick = stream.readUint32();
+
+    const Snapshot* baseline = nullptr;
+    if (stream.readBool()) {
+        uint64_t age = stream.readVarUint();
+        baseline = m_history.find(tick - (uint32_t)age);
+
+        if (baseline == nullptr) {
+            throw std::runtime_error(
+                std::format("SnapshotDecoder: baseline of tick {} isn't in the history", tick - (uint32_t)age)
+            );
+        }
+    }
+    size_t baselineSize = baseline != nullptr ? baseline->size() : 0;
+
+    // every ID takes at least a bit, don't trust a count that can't fit before resizing
+    uint64_t removedCount = stream.readVarUint();
+    if (removedCount > stream.bitSize() - stream.bitIndex()) {
+        throw std::out_of_range(std::format("SnapshotDecoder: {} removed entities can't fit in the stream", removedCount));
+    }
+
+    m_removed.resize(removedCount);
+    uint64_t nextId = 0;
+    for (Snapshot::EntityID& id : m_removed) {
+        id = readNextId(stream, nextId);
+    }
+
+    m_decoded.clear(tick);
+
+    // baseline entities that weren't removed are kept as is
+    size_t j = 0;
+    size_t removedIndex = 0;
+    auto copyBaselineBefore = [&](uint64_t end) {
+        for (; j < baselineSize && baseline->id(j) < end; j++) {
+            Snapshot::EntityID id = baseline->id(j);
+
+            while (removedIndex < m_removed.size() && m_removed[removedIndex] < id) {
+                removedIndex++;
+            }
+            if (removedIndex < m_removed.size() && m_removed[removedIndex] == id) {
+                continue;
+            }
+
+            m_decoded.add(id, baseline->fields(j));
+        }
+    };
+
+    size_t fieldCount = m_fieldBits.size();
+    uint64_t changeCount = stream.readVarUint();
+    nextId = 0;
+    for (uint64_t i = 0; i < changeCount; i++) {
+        Snapshot::EntityID id = readNextId(stream, nextId);
+
+        copyBaselineBefore(id);
+
+        if (j < baselineSize && baseline->id(j) == id) {
+            std::ranges::copy(baseline->fields(j), m_scratchFields.begin());
+            j++;
+        } else {
+            std::ranges::fill(m_scratchFields, 0);
+        }
+
+        uint32_t mask = stream.readBits<uint32_t>(fieldCount);
+        for (size_t f = 0; f < fieldCount; f++) {
+            if ((mask & (1u << f)) != 0) {
+                m_scratchFields[f] = stream.readBits<uint32_t>(m_fieldBits[f]);
+            }
+        }
+
+        m_decoded.add(id, m_scratchFields);
+    }
+    copyBaselineBefore(UINT64_MAX);
+
+    return m_history.swapIn(m_decoded);
+}
@@ -0,0 +1,636 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/physics/physicsWorld.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+/**
+ * Cross product between an angular velocity and a vector
+ */
+static Vec2F crossScalar(float angular, Vec2F vec)
+{
+    return {-angular * vec.y, angular * vec.x};
+}
+
+static uint64_t contactKey(PhysicsWorld::BodyID a, PhysicsWorld::BodyID b)
+{
+    return ((uint64_t)a << 32) | b;
+}
+
+PhysicsWorld::PhysicsWorld(const Config& config) :
+    m_config(config),
+    m_idPool(config.maxBodies),
+    // IDs start at 1 so we need 1 extra slot
+    m_grid(config.worldSize, config.cellSize, config.maxBodies + 1),
+    m_threadPool(config.solverThreads)
+{
+    size_t count = config.maxBodies + 1;
+
+    m_shapes.resize(count);
+    m_velocities.resize(count);
+    m_angularVelocities.resize(count);
+    m_angles.resize(count);
+    m_invMasses.resize(count);
+    m_invInertias.resize(count);
+    m_restitutions.resize(count);
+    m_frictions.resize(count);
+    m_sleepTimes.resize(count);
+    m_flags.resize(count);
+
+    m_awakeIndices.resize(count, NOT_AWAKE);
+    m_islandParents.resize(count);
+    m_islandSleepTimes.resize(count);
+    m_sleepLinks.resize(count);
+    m_colorMasks.resize(count);
+}
+
+PhysicsWorld::BodyID PhysicsWorld::addBody(std::unique_ptr<Shape> shape, const BodyDef& def)
+{
+    assert(shape != nullptr);
+    assert(def.mass >= 0);
+
+    BodyID id = m_idPool.getId();
+
+    bool isDynamic = def.mass > 0;
+
+    m_velocities[id] = isDynamic ? def.velocity : Vec2F{};
+    m_angularVelocities[id] = isDynamic ? def.angularVelocity : 0.F;
+    m_angles[id] = 0;
+    m_invMasses[id] = isDynamic ? 1.F / def.mass : 0.F;
+    m_invInertias[id] = isDynamic && !def.fixedRotation ? computeInvInertia(*shape, def.mass) : 0.F;
+    m_restitutions[id] = def.restitution;
+    m_frictions[id] = def.friction;
+    m_sleepTimes[id] = 0;
+    m_sleepLinks[id] = id;
+    m_flags[id] = ALIVE;
+
+    auto [min, max] = shape->getAABB();
+    m_grid.insertEntity(id, min, max);
+
+    m_shapes[id] = std::move(shape);
+
+    if (isDynamic) {
+        setAwake(id, true);
+    }
+
+    return id;
+}
+
+void PhysicsWorld::removeBody(BodyID id)
+{
+    if (!isValid(id)) {
+        return;
+    }
+
+    // unlinks it from its sleeping island
+    wake(id);
+
+    // bodies resting on this one need to fall
+    for (BodyID other : m_grid.queryEntity(id)) {
+        if (other != id && !isStatic(other)) {
+            m_toWake.push_back(other);
+        }
+    }
+    for (BodyID other : m_toWake) {
+        wake(other);
+    }
+    m_toWake.clear();
+
+    setAwake(id, false);
+
+    m_grid.removeEntity(id);
+    m_contactCache.removeEntity(id);
+
+    m_shapes[id].reset();
+    m_flags[id] = 0;
+
+    m_idPool.giveId(id);
+}
+
+void PhysicsWorld::bodyMoved(BodyID id)
+{
+    assert(isValid(id));
+
+    auto [min, max] = m_shapes[id]->getAABB();
+    m_grid.insertEntity(id, min, max);
+
+    wake(id);
+}
+
+void PhysicsWorld::setVelocity(BodyID id, Vec2F velocity)
+{
+    assert(isValid(id));
+
+    if (isStatic(id)) {
+        return;
+    }
+
+    wake(id);
+    m_velocities[id] = velocity;
+}
+
+void PhysicsWorld::setAngularVelocity(BodyID id, float angularVelocity)
+{
+    assert(isValid(id));
+
+    if (isStatic(id)) {
+        return;
+    }
+
+    wake(id);
+    m_angularVelocities[id] = angularVelocity;
+}
+
+void PhysicsWorld::applyImpulse(BodyID id, Vec2F impulse)
+{
+    assert(isValid(id));
+
+    if (isStatic(id)) {
+        return;
+    }
+
+    wake(id);
+    m_velocities[id] += impulse * m_invMasses[id];
+}
+
+void PhysicsWorld::wake(BodyID id)
+{
+    assert(isValid(id));
+
+    if (isStatic(id) || isAwake(id)) {
+        return;
+    }
+
+    BodyID current = id;
+    do {
+        BodyID next = m_sleepLinks[current];
+        m_sleepLinks[current] = current;
+
+        setAwake(current, true);
+
+        current = next;
+    } while (current != id);
+}
+
+void PhysicsWorld::setAwake(BodyID id, bool awake)
+{
+    if (isAwake(id) == awake) {
+        return;
+    }
+
+    if (awake) {
+        m_flags[id] |= AWAKE;
+        m_awakeIndices[id] = m_awake.size();
+        m_awake.push_back(id);
+        m_sleepTimes[id] = 0;
+
+        m_contactCache.unpark(id);
+    } else {
+        m_flags[id] &= ~AWAKE;
+
+        // swap remove
+        uint32_t index = m_awakeIndices[id];
+        BodyID last = m_awake.back();
+        m_awake[index] = last;
+        m_awakeIndices[last] = index;
+        m_awake.pop_back();
+
+        m_awakeIndices[id] = NOT_AWAKE;
+        m_velocities[id] = {};
+        m_angularVelocities[id] = 0;
+    }
+}
+
+void PhysicsWorld::step(float dt)
+{
+    if (dt <= 0) {
+        return;
+    }
+
+    for (BodyID id : m_awake) {
+        m_velocities[id] += m_config.gravity * dt;
+    }
+
+    findContacts();
+    colorContacts();
+    prepareContacts(dt);
+    solveContacts();
+
+    storeImpulses();
+    integratePositions(dt);
+    updateSleep(dt);
+}
+
+void PhysicsWorld::findContacts()
+{
+    m_contacts.clear();
+    m_contactCache.beginTick();
+
+    float sleepVelocitySqr = m_config.sleepVelocity * m_config.sleepVelocity;
+
+    for (BodyID id : m_awake) {
+        const Shape& shape = *m_shapes[id];
+
+        for (BodyID other : m_grid.queryEntity(id)) {
+            if (other == id) {
+                continue;
+            }
+
+            bool otherAwake = isAwake(other);
+
+            // pairs of awake bodies are found twice, only keep one
+            if (otherAwake && other < id) {
+                continue;
+            }
+
+            Collision::Manifold manifold;
+            if (!shape.getManifold(*m_shapes[other], &manifold)) {
+                continue;
+            }
+
+            m_contactCache.addContact(id, other, manifold);
+
+            // sleeping bodies only wake up if something moving hits them
+            // otherwise they are treated as static
+            if (!otherAwake && !isStatic(other) && m_velocities[id].lengthSqr() > sleepVelocitySqr) {
+                m_toWake.push_back(other);
+            }
+
+            Contact& contact = m_contacts.emplace_back();
+            contact.a = id;
+            contact.b = other;
+            contact.normal = manifold.normal;
+            contact.friction = std::sqrt(m_frictions[id] * m_frictions[other]);
+            contact.restitution = std::max(m_restitutions[id], m_restitutions[other]);
+            contact.pointCount = manifold.pointCount;
+
+            for (uint8_t i = 0; i < manifold.pointCount; i++) {
+                // only the contact point and depth are needed for now, prepareContacts does the rest
+                contact.points[i].relA = manifold.points[i];
+                contact.points[i].bias = manifold.depths[i];
+            }
+        }
+    }
+
+    m_contactCache.endTick();
+
+    for (BodyID id : m_toWake) {
+        wake(id);
+    }
+    m_toWake.clear();
+}
+
+void PhysicsWorld::colorContacts()
+{
+    for (BodyID id : m_awake) {
+        m_colorMasks[id] = 0;
+    }
+
+    std::array<uint32_t, MAX_COLORS + 1> colorCounts{};
+    m_contactColors.resize(m_contacts.size());
+
+    // greedy coloring in the order contacts were found so the result is deterministic
+    // static and sleeping bodies are never written to by the solver so they can be in every color
+    for (size_t i = 0; i < m_contacts.size(); i++) {
+        const Contact& contact = m_contacts[i];
+
+        bool awakeA = isAwake(contact.a);
+        bool awakeB = isAwake(contact.b);
+
+        uint64_t used = (awakeA ? m_colorMasks[contact.a] : 0) | (awakeB ? m_colorMasks[contact.b] : 0);
+
+        uint32_t color = OVERFLOW_COLOR;
+        if (used != UINT64_MAX) {
+            color = std::countr_one(used);
+
+            uint64_t bit = uint64_t{1} << color;
+            if (awakeA) {
+                m_colorMasks[contact.a] |= bit;
+            }
+            if (awakeB) {
+                m_colorMasks[contact.b] |= bit;
+            }
+        }
+
+        m_contactColors[i] = color;
+        colorCounts[color]++;
+    }
+
+    m_colorOffsets[0] = 0;
+    for (uint32_t color = 0; color <= MAX_COLORS; color++) {
+        m_colorOffsets[color + 1] = m_colorOffsets[color] + colorCounts[color];
+    }
+
+    // stable counting sort by color
+    std::array<uint32_t, MAX_COLORS + 1> next{};
+    std::copy_n(m_colorOffsets.begin(), next.size(), next.begin());
+
+    m_sortedContacts.resize(m_contacts.size());
+    for (size_t i = 0; i < m_contacts.size(); i++) {
+        m_sortedContacts[next[m_contactColors[i]]++] = m_contacts[i];
+    }
+    std::swap(m_contacts, m_sortedContacts);
+}
+
+void PhysicsWorld::prepareContacts(float dt)
+{
+    for (auto& contact : m_contacts) {
+        BodyID a = contact.a;
+        BodyID b = contact.b;
+
+        float invMassA = solverInvMass(a);
+        float invMassB = solverInvMass(b);
+        float invInertiaA = solverInvInertia(a);
+        float invInertiaB = solverInvInertia(b);
+
+        Vec2F centerA = m_shapes[a]->center();
+        Vec2F centerB = m_shapes[b]->center();
+
+        Vec2F normal = contact.normal;
+        Vec2F tangent{-normal.y, normal.x};
+
+        auto lastImpulses = m_lastImpulses.find(contactKey(a, b));
+        bool warmStart = lastImpulses != m_lastImpulses.end();
+
+        for (uint8_t i = 0; i < contact.pointCount; i++) {
+            ContactPoint& point = contact.points[i];
+
+            Vec2F worldPoint = point.relA;
+            float depth = point.bias;
+
+            point.relA = worldPoint - centerA;
+            point.relB = worldPoint - centerB;
+
+            float rnA = point.relA.cross(normal);
+            float rnB = point.relB.cross(normal);
+            float normalK = invMassA + invMassB + (invInertiaA * rnA * rnA) + (invInertiaB * rnB * rnB);
+            point.normalMass = normalK > 0 ? 1.F / normalK : 0.F;
+
+            float rtA = point.relA.cross(tangent);
+            float rtB = point.relB.cross(tangent);
+            float tangentK = invMassA + invMassB + (invInertiaA * rtA * rtA) + (invInertiaB * rtB * rtB);
+            point.tangentMass = tangentK > 0 ? 1.F / tangentK : 0.F;
+
+            Vec2F relativeVel = m_velocities[b] + crossScalar(m_angularVelocities[b], point.relB)
+                - m_velocities[a] - crossScalar(m_angularVelocities[a], point.relA);
+            float normalVel = relativeVel * normal;
+
+            // the normal points from A to B so a negative velocity means they are approaching
+            float restitutionBias = normalVel < -m_config.restitutionThreshold
+                ? -contact.restitution * normalVel
+                : 0.F;
+            float penetrationBias = (m_config.baumgarte / dt) * std::max(0.F, depth - m_config.penetrationSlop);
+
+            point.bias = std::max(restitutionBias, penetrationBias);
+
+            point.normalImpulse = warmStart ? lastImpulses->second[i * 2] : 0.F;
+            point.tangentImpulse = warmStart ? lastImpulses->second[(i * 2) + 1] : 0.F;
+
+            if (warmStart) {
+                applyContactImpulse(contact, point, (normal * point.normalImpulse) + (tangent * point.tangentImpulse));
+            }
+        }
+    }
+}
+
+void PhysicsWorld::applyContactImpulse(const Contact& contact, const ContactPoint& point, Vec2F impulse)
+{
+    BodyID a = contact.a;
+    BodyID b = contact.b;
+
+    // bodies that aren't awake are shared between colors so they must not be written to
+    if (isAwake(a)) {
+        m_velocities[a] -= impulse * m_invMasses[a];
+        m_angularVelocities[a] -= m_invInertias[a] * point.relA.cross(impulse);
+    }
+
+    if (isAwake(b)) {
+        m_velocities[b] += impulse * m_invMasses[b];
+        m_angularVelocities[b] += m_invInertias[b] * point.relB.cross(impulse);
+    }
+}
+
+void PhysicsWorld::solveContacts()
+{
+    for (uint8_t iteration = 0; iteration < m_config.velocityIterations; iteration++) {
+        for (uint32_t color = 0; color < MAX_COLORS; color++) {
+            uint32_t begin = m_colorOffsets[color];
+            uint32_t end = m_colorOffsets[color + 1];
+
+            // colors are filled in order so the first empty one ends the list
+            if (begin == end) {
+                break;
+            }
+
+            m_threadPool.parallelFor(end - begin, SOLVER_GRAIN_SIZE, [&](size_t first, size_t last) {
+                for (size_t i = begin + first; i < begin + last; i++) {
+                    solveContact(m_contacts[i]);
+                }
+            });
+        }
+
+        for (uint32_t i = m_colorOffsets[OVERFLOW_COLOR]; i < m_colorOffsets[OVERFLOW_COLOR + 1]; i++) {
+            solveContact(m_contacts[i]);
+        }
+    }
+}
+
+void PhysicsWorld::solveContact(Contact& contact)
+{
+    BodyID a = contact.a;
+    BodyID b = contact.b;
+
+    Vec2F normal = contact.normal;
+    Vec2F tangent{-normal.y, normal.x};
+
+    for (uint8_t i = 0; i < contact.pointCount; i++) {
+        ContactPoint& point = contact.points[i];
+
+        // friction
+        {
+            Vec2F relativeVel = m_velocities[b] + crossScalar(m_angularVelocities[b], point.relB)
+                - m_velocities[a] - crossScalar(m_angularVelocities[a], point.relA);
+
+            float lambda = -(relativeVel * tangent) * point.tangentMass;
+
+            float maxFriction = contact.friction * point.normalImpulse;
+            float newImpulse = std::clamp(point.tangentImpulse + lambda, -maxFriction, maxFriction);
+            lambda = newImpulse - point.tangentImpulse;
+            point.tangentImpulse = newImpulse;
+
+            applyContactImpulse(contact, point, tangent * lambda);
+        }
+
+        // normal
+        {
+            Vec2F relativeVel = m_velocities[b] + crossScalar(m_angularVelocities[b], point.relB)
+                - m_velocities[a] - crossScalar(m_angularVelocities[a], point.relA);
+
+            float lambda = (point.bias - (relativeVel * normal)) * point.normalMass;
+
+            // contacts can only push, never pull
+            float newImpulse = std::max(point.normalImpulse + lambda, 0.F);
+            lambda = newImpulse - point.normalImpulse;
+            point.normalImpulse = newImpulse;
+
+            applyContactImpulse(contact, point, normal * lambda);
+        }
+    }
+}
+
+void PhysicsWorld::storeImpulses()
+{
+    m_lastImpulses.clear();
+
+    for (const auto& contact : m_contacts) {
+        std::array<float, 4> impulses{};
+        for (uint8_t i = 0; i < contact.pointCount; i++) {
+            impulses[i * 2] = contact.points[i].normalImpulse;
+            impulses[(i * 2) + 1] = contact.points[i].tangentImpulse;
+        }
+        m_lastImpulses[contactKey(contact.a, contact.b)] = impulses;
+    }
+}
+
+void PhysicsWorld::integratePositions(float dt)
+{
+    for (BodyID id : m_awake) {
+        Shape& shape = *m_shapes[id];
+
+        shape.translate(m_velocities[id] * dt);
+
+        float rotation = m_angularVelocities[id] * dt;
+        if (rotation != 0) {
+            // circles don't need to be rotated and rects can't be
+            if (shape.type == Shape::POLYGON) {
+                static_cast<Polygon&>(shape).rotate(rotation);
+            }
+            m_angles[id] += rotation;
+        }
+
+        auto [min, max] = shape.getAABB();
+        m_grid.insertEntity(id, min, max);
+    }
+}
+
+PhysicsWorld::BodyID PhysicsWorld::findIsland(BodyID id)
+{
+    while (m_islandParents[id] != id) {
+        // path halving
+        m_islandParents[id] = m_islandParents[m_islandParents[id]];
+        id = m_islandParents[id];
+    }
+    return id;
+}
+
+void PhysicsWorld::updateSleep(float dt)
+{
+    float sleepVelocitySqr = m_config.sleepVelocity * m_config.sleepVelocity;
+
+    for (BodyID id : m_awake) {
+        m_islandParents[id] = id;
+        m_islandSleepTimes[id] = std::numeric_limits<float>::max();
+
+        bool resting = m_velocities[id].lengthSqr() < sleepVelocitySqr
+            && std::abs(m_angularVelocities[id]) < m_config.sleepAngularVelocity;
+
+        m_sleepTimes[id] = resting ? m_sleepTimes[id] + dt : 0.F;
+    }
+
+    // static and sleeping bodies don't join islands
+    // so a pile of boxes on the floor doesn't turn the whole level into a single island
+    for (const auto& contact : m_contacts) {
+        if (!isAwake(contact.a) || !isAwake(contact.b)) {
+            continue;
+        }
+
+        BodyID rootA = findIsland(contact.a);
+        BodyID rootB = findIsland(contact.b);
+        if (rootA != rootB) {
+            m_islandParents[rootB] = rootA;
+        }
+    }
+
+    // an island can only sleep if all of its bodies are resting
+    for (BodyID id : m_awake) {
+        BodyID root = findIsland(id);
+        m_islandSleepTimes[root] = std::min(m_islandSleepTimes[root], m_sleepTimes[id]);
+    }
+
+    bool fellAsleep = false;
+    for (size_t i = 0; i < m_awake.size();) {
+        BodyID id = m_awake[i];
+        BodyID root = findIsland(id);
+
+        if (m_islandSleepTimes[root] < m_config.timeToSleep) {
+            i++;
+            continue;
+        }
+
+        // link the island in a ring, the root starts the ring
+        if (id != root) {
+            m_sleepLinks[id] = m_sleepLinks[root];
+            m_sleepLinks[root] = id;
+        }
+
+        // swaps the last awake body into this index so don't increment
+        setAwake(id, false);
+        fellAsleep = true;
+    }
+
+    // pairs with nothing awake aren't tested anymore but are still touching,
+    // parked they cost nothing per step until setAwake brings them back
+    if (fellAsleep) {
+        m_contactCache.park([this](const auto& contact) {
+            return !isAwake(contact.a) && !isAwake(contact.b);
+        });
+    }
+}
+
+float PhysicsWorld::computeInvInertia(const Shape& shape, float mass)
+{
+    float inertia = 0;
+
+    switch (shape.type) {
+    case Shape::CIRCLE: {
+        const auto& circle = static_cast<const Circle&>(shape);
+        inertia = 0.5F * mass * circle.rad * circle.rad;
+        break;
+    }
+    case Shape::POLYGON: {
+        const auto& poly = static_cast<const Polygon&>(shape);
+        Vec2F center = poly.center();
+
+        float numerator = 0;
+        float denominator = 0;
+
+        size_t count = poly.points.size();
+        for (size_t i = 0, j = count - 1; i < count; j = i++) {
+            Vec2F a = poly.points[j] - center;
+            Vec2F b = poly.points[i] - center;
+
+            float cross = std::abs(a.cross(b));
+            numerator += cross * ((a * a) + (a * b) + (b * b));
+            denominator += cross;
+        }
+
+        inertia = denominator > 0 ? (mass / 6.F) * (numerator / denominator) : 0.F;
+        break;
+    }
+    // rects are axis aligned and can't rotate
+    case Shape::RECT:
+    // compound polygons are meant for level geometry and don't rotate either
+    case Shape::COMPOUND:
+    default:
+        break;
+    }
+
+    return inertia > 0 ? 1.F / inertia : 0.F;
+}
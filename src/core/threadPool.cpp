@@ -0,0 +1,93 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/threadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t workerCount)
+{
+    m_workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; i++) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_jobReady.notify_all();
+
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::run(size_t count, size_t grainSize, JobFn fn, void* context)
+{
+    {
+        std::lock_guard lock(m_mutex);
+
+        m_jobFn = fn;
+        m_jobContext = context;
+        m_jobCount = count;
+        m_jobGrain = grainSize;
+        m_nextIndex.store(0, std::memory_order_relaxed);
+
+        m_busyWorkers = m_workers.size();
+        m_generation++;
+    }
+    m_jobReady.notify_all();
+
+    runChunks();
+
+    // the job lives on the caller's stack so wait for every worker to be done with it
+    std::unique_lock lock(m_mutex);
+    m_jobDone.wait(lock, [this] { return m_busyWorkers == 0; });
+}
+
+void ThreadPool::runChunks()
+{
+    while (true) {
+        size_t begin = m_nextIndex.fetch_add(m_jobGrain, std::memory_order_relaxed);
+        if (begin >= m_jobCount) {
+            return;
+        }
+
+        m_jobFn(m_jobContext, begin, std::min(begin + m_jobGrain, m_jobCount));
+    }
+}
+
+void ThreadPool::workerLoop()
+{
+    uint64_t lastGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock lock(m_mutex);
+            m_jobReady.wait(lock, [&] { return m_stopping || m_generation != lastGeneration; });
+
+            if (m_stopping) {
+                return;
+            }
+            lastGeneration = m_generation;
+        }
+
+        runChunks();
+
+        bool lastWorker = false;
+        {
+            std::lock_guard lock(m_mutex);
+            lastWorker = --m_busyWorkers == 0;
+        }
+        if (lastWorker) {
+            m_jobDone.notify_one();
+        }
+    }
+}
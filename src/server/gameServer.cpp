@@ -0,0 +1,283 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/server/gameServer.h"
+
+#include "fc/core/ticker.h"
+
+#include <App.h>
+#include <libusockets.h>
+
+#include <algorithm>
+#include <exception>
+#include <format>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+struct ClientData
+{
+    GameServer::ClientID id = 0;
+};
+
+using Socket = uWS::WebSocket<false, true, ClientData>;
+
+}
+
+struct GameServer::Impl
+{
+    /**
+     * Made in run, uWebSockets loops belong to the thread that makes them
+     */
+    std::unique_ptr<uWS::App> app;
+    uWS::Loop* loop = nullptr;
+    us_listen_socket_t* listenSocket = nullptr;
+    us_timer_t* timer = nullptr;
+
+    /**
+     * By client ID, IDs start at 1
+     */
+    std::vector<Socket*> sockets;
+};
+
+GameServer::GameServer(const Config& config) :
+    m_impl(std::make_unique<Impl>()),
+    m_config(config),
+    m_idPool(config.maxClients),
+    m_schedule(config.tickRate)
+{
+    m_impl->sockets.resize(config.maxClients + 1, nullptr);
+}
+
+GameServer::~GameServer() = default;
+
+bool GameServer::run()
+{
+    return runLoop(true, {});
+}
+
+bool GameServer::runLoop(bool listen, const std::function<void()>& onReady)
+{
+    uWS::App::WebSocketBehavior<ClientData> behavior;
+    // snapshots are already packed, deflate would cost more CPU than it saves
+    behavior.compression = uWS::DISABLED;
+    behavior.maxPayloadLength = m_config.maxMessageSize;
+    behavior.idleTimeout = m_config.idleTimeout;
+    behavior.maxBackpressure = m_config.maxBackpressure;
+    behavior.closeOnBackpressureLimit = false;
+
+    behavior.upgrade = [this](auto* res, auto* req, auto* context) {
+        if (!m_idPool.hasIdsLeft()) {
+            res->writeStatus("503 Service Unavailable")->end("server full");
+            return;
+        }
+
+        res->template upgrade<ClientData>(
+            {},
+            req->getHeader("sec-websocket-key"),
+            req->getHeader("sec-websocket-protocol"),
+            req->getHeader("sec-websocket-extensions"),
+            context
+        );
+    };
+
+    behavior.open = [this](Socket* socket) {
+        // upgrading moves the socket out of the HTTP context without closing it
+        m_connectingCount.fetch_sub(1, std::memory_order_relaxed);
+
+        ClientID id = m_idPool.getId();
+        socket->getUserData()->id = id;
+        m_impl->sockets[id] = socket;
+        m_clientCount.fetch_add(1, std::memory_order_relaxed);
+
+        onConnect(id);
+    };
+
+    behavior.message = [this](Socket* socket, std::string_view message, uWS::OpCode opCode) {
+        ClientID id = socket->getUserData()->id;
+        if (opCode != uWS::OpCode::BINARY) {
+            return;
+        }
+
+        // only read from, the stream needs a non const pointer
+        auto* data = reinterpret_cast<uint8_t*>(const_cast<char*>(message.data()));
+        BitStream stream(data, message.size());
+
+        try {
+            onMessage(id, stream);
+        } catch (const std::exception& e) {
+            std::cerr << std::format("GameServer: invalid message from client {}: {}\n", id, e.what());
+            socket->end(1008, "invalid message");
+        }
+    };
+
+    behavior.close = [this](Socket* socket, int /*code*/, std::string_view /*message*/) {
+        ClientID id = socket->getUserData()->id;
+        m_impl->sockets[id] = nullptr;
+        m_clientCount.fetch_sub(1, std::memory_order_relaxed);
+
+        onDisconnect(id);
+        m_idPool.giveId(id);
+    };
+
+    m_impl->app = std::make_unique<uWS::App>();
+    m_impl->app->ws<ClientData>("/*", std::move(behavior));
+
+    // called with 1 when an HTTP socket opens and -1 when one closes, upgraded ones are taken off in open
+    m_impl->app->filter([this](uWS::HttpResponse<false>* /*res*/, int change) {
+        if (change > 0) {
+            m_connectingCount.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            m_connectingCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+    });
+    m_impl->loop = uWS::Loop::get();
+
+    if (listen) {
+        m_impl->app->listen(m_config.port, [this](us_listen_socket_t* socket) {
+            m_impl->listenSocket = socket;
+        });
+
+        if (m_impl->listenSocket == nullptr) {
+            std::cerr << std::format("GameServer: couldn't listen on port {}\n", m_config.port);
+            m_impl->app.reset();
+            return false;
+        }
+    }
+
+    // wakes up a few times per tick, runTicks works out which ticks are due from the real time.
+    // It also keeps the loop running while a cluster worker has no sockets
+    auto* loop = reinterpret_cast<us_loop_t*>(m_impl->loop);
+    m_impl->timer = us_create_timer(loop, 0, sizeof(GameServer*));
+    *static_cast<GameServer**>(us_timer_ext(m_impl->timer)) = this;
+
+    int wakeMs = std::max(1, (int)(1000 / m_config.tickRate / 4));
+    m_schedule.start(Ticker::getTime());
+    us_timer_set(
+        m_impl->timer,
+        [](us_timer_t* timer) {
+            (*static_cast<GameServer**>(us_timer_ext(timer)))->runTicks();
+        },
+        wakeMs,
+        wakeMs
+    );
+
+    if (onReady) {
+        onReady();
+    }
+
+    m_impl->app->run();
+    m_impl->app.reset();
+    return true;
+}
+
+void GameServer::stop()
+{
+    if (m_impl->listenSocket != nullptr) {
+        us_listen_socket_close(0, m_impl->listenSocket);
+        m_impl->listenSocket = nullptr;
+    }
+
+    if (m_impl->timer != nullptr) {
+        us_timer_close(m_impl->timer);
+        m_impl->timer = nullptr;
+    }
+
+    for (Socket* socket : m_impl->sockets) {
+        if (socket != nullptr) {
+            socket->end(1001, "server stopping");
+        }
+    }
+
+    // sockets still in the HTTP phase would keep the loop alive until their idle timeout
+    if (m_impl->app != nullptr) {
+        m_impl->app->close();
+    }
+}
+
+void GameServer::adoptSocket(intptr_t socket)
+{
+    m_impl->app->adoptSocket((LIBUS_SOCKET_DESCRIPTOR)socket);
+}
+
+void GameServer::defer(std::function<void()> fn)
+{
+    m_impl->loop->defer(std::move(fn));
+}
+
+void GameServer::runTicks()
+{
+    double now = Ticker::getTime();
+
+    // stop can be called from a tick, the rest of the due ones don't run
+    while (m_impl->timer != nullptr && m_schedule.next(now)) {
+        double start = Ticker::getTime();
+        onTick(m_tick, (float)m_schedule.period());
+        m_stats.tickSeconds += Ticker::getTime() - start;
+
+        m_tick++;
+        m_stats.ticks++;
+    }
+}
+
+bool GameServer::send(ClientID client, std::span<const uint8_t> bytes)
+{
+    if (!isConnected(client)) {
+        return false;
+    }
+
+    Socket* socket = m_impl->sockets[client];
+    if (socket->getBufferedAmount() > m_config.maxBackpressure) {
+        m_stats.messagesDropped++;
+        return false;
+    }
+
+    std::string_view message(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    if (socket->send(message, uWS::OpCode::BINARY) == Socket::DROPPED) {
+        m_stats.messagesDropped++;
+        return false;
+    }
+
+    m_stats.messagesSent++;
+    m_stats.bytesSent += bytes.size();
+    return true;
+}
+
+bool GameServer::send(ClientID client, const BitStream& stream)
+{
+    return send(client, std::span<const uint8_t>(stream.data(), stream.byteIndex()));
+}
+
+void GameServer::disconnect(ClientID client)
+{
+    if (isConnected(client)) {
+        m_impl->sockets[client]->end(1000);
+    }
+}
+
+bool GameServer::isConnected(ClientID client) const
+{
+    return client < m_impl->sockets.size() && m_impl->sockets[client] != nullptr;
+}
+
+void GameServer::onConnect(ClientID /*client*/)
+{
+}
+
+void GameServer::onMessage(ClientID /*client*/, BitStream& /*message*/)
+{
+}
+
+void GameServer::onDisconnect(ClientID /*client*/)
+{
+}
+
+void GameServer::onTick(uint32_t /*tick*/, float /*dt*/)
+{
+}
@@ -0,0 +1,172 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/server/serverCluster.h"
+
+#include <App.h>
+#include <libusockets.h>
+
+#include <format>
+#include <iostream>
+#include <latch>
+#include <mutex>
+#include <stdexcept>
+
+namespace
+{
+
+/**
+ * The cluster accepting on this thread, the pre open handler is a plain function pointer
+ */
+thread_local ServerCluster* t_acceptingCluster = nullptr;
+
+}
+
+struct ServerCluster::Impl
+{
+    std::unique_ptr<uWS::App> acceptor;
+    us_listen_socket_t* listenSocket = nullptr;
+
+    /**
+     * The acceptor's loop while it runs, guarded so stop can be called from any thread
+     */
+    std::mutex loopMutex;
+    uWS::Loop* loop = nullptr;
+};
+
+ServerCluster::ServerCluster(uint16_t port, size_t workerCount, Factory factory) :
+    m_impl(std::make_unique<Impl>()),
+    m_port(port),
+    m_factory(std::move(factory)),
+    m_workers(workerCount)
+{
+    if (workerCount == 0) {
+        throw std::invalid_argument("ServerCluster: needs at least one worker");
+    }
+}
+
+ServerCluster::~ServerCluster() = default;
+
+bool ServerCluster::run()
+{
+    // the servers and their loops are made on their own thread, uWebSockets loops are per thread
+    std::latch ready((std::ptrdiff_t)m_workers.size());
+    for (size_t i = 0; i < m_workers.size(); i++) {
+        Worker& worker = m_workers[i];
+        worker.thread = std::thread([this, i, &worker, &ready] {
+            worker.server = m_factory(i);
+            worker.server->runLoop(false, [&ready] {
+                ready.count_down();
+            });
+        });
+    }
+    ready.wait();
+
+    m_impl->acceptor = std::make_unique<uWS::App>();
+
+    // sockets are handed over right after accept, before the acceptor reads anything from them
+    m_impl->acceptor->preOpen([](us_socket_context_t* /*context*/, LIBUS_SOCKET_DESCRIPTOR socket) {
+        t_acceptingCluster->dispatch((intptr_t)socket);
+        return (LIBUS_SOCKET_DESCRIPTOR)-1;
+    });
+
+    m_impl->acceptor->listen(m_port, [this](us_listen_socket_t* socket) {
+        m_impl->listenSocket = socket;
+    });
+
+    bool listening = m_impl->listenSocket != nullptr;
+    if (!listening) {
+        std::cerr << std::format("ServerCluster: couldn't listen on port {}\n", m_port);
+    } else {
+        {
+            std::lock_guard lock(m_impl->loopMutex);
+            m_impl->loop = uWS::Loop::get();
+        }
+
+        // stopped before the loop could be deferred to
+        if (m_stopping) {
+            us_listen_socket_close(0, m_impl->listenSocket);
+            m_impl->listenSocket = nullptr;
+        }
+
+        t_acceptingCluster = this;
+        m_impl->acceptor->run();
+        t_acceptingCluster = nullptr;
+
+        std::lock_guard lock(m_impl->loopMutex);
+        m_impl->loop = nullptr;
+    }
+
+    m_impl->acceptor.reset();
+
+    // nothing is dispatched anymore, so no socket can be deferred to a worker after its stop
+    stopWorkers();
+
+    // reset on the way out, a stop that came before run must still stop it
+    m_stopping = false;
+    return listening;
+}
+
+void ServerCluster::stop()
+{
+    m_stopping = true;
+
+    std::lock_guard lock(m_impl->loopMutex);
+    if (m_impl->loop != nullptr) {
+        m_impl->loop->defer([this] {
+            if (m_impl->listenSocket != nullptr) {
+                us_listen_socket_close(0, m_impl->listenSocket);
+                m_impl->listenSocket = nullptr;
+            }
+        });
+    }
+}
+
+uint32_t ServerCluster::load(size_t worker) const
+{
+    const Worker& w = m_workers[worker];
+    uint32_t clients = w.server != nullptr ? w.server->clientCount() + w.server->connectingCount() : 0;
+
+    // adopting opens the socket in the worker's HTTP context, so it's counted as connecting before pending drops
+    return clients + w.pending.load(std::memory_order_relaxed);
+}
+
+void ServerCluster::dispatch(intptr_t socket)
+{
+    size_t best = 0;
+    uint32_t bestLoad = UINT32_MAX;
+    for (size_t i = 0; i < m_workers.size(); i++) {
+        uint32_t workerLoad = load(i);
+        if (workerLoad < bestLoad) {
+            best = i;
+            bestLoad = workerLoad;
+        }
+    }
+
+    Worker& worker = m_workers[best];
+    worker.pending.fetch_add(1, std::memory_order_relaxed);
+
+    GameServer* server = worker.server.get();
+    server->defer([server, &worker, socket] {
+        server->adoptSocket(socket);
+        worker.pending.fetch_sub(1, std::memory_order_relaxed);
+    });
+}
+
+void ServerCluster::stopWorkers()
+{
+    for (Worker& worker : m_workers) {
+        GameServer* server = worker.server.get();
+        server->defer([server] {
+            server->stop();
+        });
+    }
+
+    for (Worker& worker : m_workers) {
+        worker.thread.join();
+        worker.server.reset();
+    }
+}
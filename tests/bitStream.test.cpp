@@ -4,9 +4,15 @@
     SPDX-FileCopyrightText: 2026 firecat2d developers
 */
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
 #include <cstdint>
 #include <doctest/doctest.h>
 #include <numbers>
+#include <random>
+#include <utility>
+#include <vector>
 
 #include "fc/core/bitStream.h"
 
@@ -52,6 +58,76 @@ TEST_CASE("BitStream tests")
         CHECK(bs.readBits<uint32_t>(20) == 99999);
     }
 
+    SUBCASE("Wire format")
+    {
+        // least significant bits first, same bytes as the original byte by byte version
+        uint8_t buff[16] = {};
+        BitStream small{buff, sizeof(buff)};
+
+        small.writeBits<uint8_t>(9, 5);
+        small.writeBits<uint16_t>(999, 11);
+        small.writeBits<int16_t>(-99, 13);
+        small.writeBits<uint32_t>(0xABCDE, 20);
+        small.writeBits<uint64_t>(0x0123456789ABCDEF, 64);
+
+        const uint8_t expected[16] = {0xE9, 0x7C, 0x9D, 0xDF, 0x9B, 0x57, 0xDF, 0x9B, 0x57, 0x13, 0xCF, 0x8A, 0x46, 0x02, 0x00, 0x00};
+        CHECK(small.bitIndex() == 113);
+        for (size_t i = 0; i < sizeof(buff); i++) {
+            CHECK(buff[i] == expected[i]);
+        }
+    }
+
+    SUBCASE("Unaligned 64 bit values")
+    {
+        // every bit offset, the last ones end at the end of the buffer
+        for (size_t offset = 0; offset < 8; offset++) {
+            bs.setBitIndex(offset);
+            bs.writeUint64(0xFEDCBA9876543210);
+            bs.writeInt64(-1234567890123);
+            bs.writeBits<int64_t>(-5, 63);
+
+            bs.setBitIndex(bs.bitSize() - 64 - offset);
+            bs.writeUint64(0x0F0F0F0F0F0F0F0F);
+            bs.writeBits<uint8_t>(0x55, offset);
+
+            bs.setBitIndex(offset);
+            CHECK(bs.readUint64() == 0xFEDCBA9876543210);
+            CHECK(bs.readInt64() == -1234567890123);
+            CHECK(bs.readBits<int64_t>(63) == -5);
+
+            bs.setBitIndex(bs.bitSize() - 64 - offset);
+            CHECK(bs.readUint64() == 0x0F0F0F0F0F0F0F0F);
+            CHECK(bs.readBits<uint8_t>(offset) == (0x55 & ((1 << offset) - 1)));
+        }
+    }
+
+    SUBCASE("Peek")
+    {
+        bs.writeBits<uint16_t>(0x1ABC, 13);
+        bs.setBitIndex(4);
+        CHECK(bs.peekBits(9) == 0x1AB);
+        CHECK(bs.bitIndex() == 4);
+
+        // zeros past the end
+        bs.setBitIndex(bs.bitSize() - 4);
+        bs.writeBits<uint8_t>(0xF, 4);
+        bs.setBitIndex(bs.bitSize() - 4);
+        CHECK(bs.peekBits(12) == 0xF);
+        bs.setBitIndex(bs.bitSize());
+        CHECK(bs.peekBits(12) == 0);
+    }
+
+    SUBCASE("Writes keep the bits around them")
+    {
+        bs.writeUint32(0xFFFFFFFF);
+        bs.setBitIndex(3);
+        bs.writeBits<uint8_t>(0, 5);
+        bs.writeBits<uint16_t>(0, 10);
+
+        bs.setBitIndex(0);
+        CHECK(bs.readUint32() == 0xFFFC0007);
+    }
+
     SUBCASE("Floats and doubles")
     {
         bs.writeFloat32(99.99);
@@ -78,6 +154,62 @@ TEST_CASE("BitStream tests")
 
         CHECK(bs.readFloat(8, 10, 16) == doctest::Approx(9.9).epsilon(0.1));
         CHECK(bs.readFloat(-10, 1, 16) == doctest::Approx(-6.6).epsilon(0.1));
+
+        // the ends of the range are exact
+        bs.setBitIndex(0);
+        bs.writeFloat(10, 8, 10, 16);
+        bs.writeFloat(8, 8, 10, 16);
+        bs.writeFloat(1, -10, 1, 32);
+        bs.setBitIndex(0);
+        CHECK(bs.readFloat(8, 10, 16) == 10.0f);
+        CHECK(bs.readFloat(8, 10, 16) == 8.0f);
+        CHECK(bs.readFloat(-10, 1, 32) == 1.0f);
+    }
+
+    SUBCASE("Quantized vectors, angles and normals")
+    {
+        std::mt19937 rng(99);
+        std::uniform_real_distribution<float> posDist(-2048, 2048);
+        std::uniform_real_distribution<float> angleDist(-20, 20);
+
+        constexpr float POS_ERROR = 4096.0f / 65535 / 2;
+        constexpr float ANGLE_ERROR = std::numbers::pi_v<float> / 1024;
+
+        for (size_t i = 0; i < 200; i++) {
+            Vec2F pos(posDist(rng), posDist(rng));
+            float angle = angleDist(rng);
+            Vec2F normal(std::cos(angle), std::sin(angle));
+
+            bs.setBitIndex(0);
+            bs.writeVec2(pos, {-2048, -2048}, {2048, 2048}, 16);
+            bs.writeAngle(angle, 10);
+            bs.writeUnitVec2(normal, 10);
+            CHECK(bs.bitIndex() == 32 + 10 + 10);
+
+            bs.setBitIndex(0);
+            Vec2F readPos = bs.readVec2({-2048, -2048}, {2048, 2048}, 16);
+            CHECK(std::abs(readPos.x - pos.x) <= POS_ERROR + 1e-3f);
+            CHECK(std::abs(readPos.y - pos.y) <= POS_ERROR + 1e-3f);
+
+            float readAngle = bs.readAngle(10);
+            CHECK(readAngle >= -std::numbers::pi_v<float>);
+            CHECK(readAngle < std::numbers::pi_v<float>);
+            // same direction, the difference is a whole number of turns
+            float diff = std::remainder(readAngle - angle, 2 * std::numbers::pi_v<float>);
+            CHECK(std::abs(diff) <= ANGLE_ERROR + 1e-5f);
+
+            Vec2F readNormal = bs.readUnitVec2(10);
+            CHECK(readNormal.length() == doctest::Approx(1.0f));
+            CHECK(readNormal.distanceTo(normal) <= ANGLE_ERROR + 1e-5f);
+        }
+
+        // right under a full turn rounds back to 0
+        bs.setBitIndex(0);
+        bs.writeAngle(2 * std::numbers::pi_v<float> - 0.0001f, 8);
+        bs.setBitIndex(0);
+        CHECK(bs.readAngle(8) == 0.0f);
+
+        CHECK_THROWS_AS(bs.writeVec2({0, 5}, {0, 0}, {4, 4}, 8), std::out_of_range);
     }
 
     SUBCASE("Strings")
@@ -107,6 +239,247 @@ TEST_CASE("BitStream tests")
         CHECK(bs.byteIndex() == 5);
         bs.setBitIndex(0);
         CHECK(bs.readString(6) == std::string("meow"));
+
+        // not byte aligned
+        bs.setBitIndex(3);
+        bs.writeString("Deers are cool🦌");
+        bs.writeString("meow meow meow", 9);
+        bs.setBitIndex(3);
+        CHECK(bs.readString() == std::string("Deers are cool🦌"));
+        CHECK(bs.readString(9) == std::string("meow meow"));
+        CHECK_THROWS_AS((void)bs.readStringView(), std::logic_error);
+    }
+
+    SUBCASE("String views")
+    {
+        bs.writeString("Deers are cool");
+        bs.writeString("meow meow meow", 9);
+        bs.writeString("");
+
+        bs.setBitIndex(0);
+        std::string_view deers = bs.readStringView();
+        CHECK(deers == "Deers are cool");
+        CHECK(static_cast<const void*>(deers.data()) == BUFF);
+        CHECK(bs.readStringView(9) == "meow meow");
+        CHECK(bs.readStringView(9).empty());
+        CHECK(bs.byteIndex() == 25);
+
+        // no terminator before the end of the buffer
+        std::fill(std::begin(BUFF), std::end(BUFF), 'A');
+        bs.setBitIndex(bs.bitSize() - 32);
+        CHECK_THROWS_AS((void)bs.readStringView(), std::out_of_range);
+        CHECK(bs.readStringView(4) == "AAAA");
+        std::fill(std::begin(BUFF), std::end(BUFF), 0);
+    }
+
+    SUBCASE("Bytes")
+    {
+        std::vector<uint8_t> bytes(37);
+        for (size_t i = 0; i < bytes.size(); i++) {
+            bytes[i] = (uint8_t)(i * 29 + 7);
+        }
+
+        for (size_t offset : {0, 1, 5, 8, 13}) {
+            std::fill(std::begin(BUFF), std::end(BUFF), 0xFF);
+            bs.setBitIndex(offset);
+            bs.writeBytes(bytes.data(), bytes.size());
+            bs.writeUint8(0x5A);
+
+            CHECK(bs.bitIndex() == offset + (bytes.size() * 8) + 8);
+
+            // same bits as writing byte by byte
+            bs.setBitIndex(offset);
+            for (uint8_t byte : bytes) {
+                CHECK(bs.readUint8() == byte);
+            }
+            CHECK(bs.readUint8() == 0x5A);
+
+            // the bits before are kept
+            bs.setBitIndex(0);
+            CHECK(bs.readBits<uint16_t>(offset) == (1 << offset) - 1);
+
+            std::vector<uint8_t> read(bytes.size());
+            bs.setBitIndex(offset);
+            bs.readBytes(read.data(), read.size());
+            CHECK(read == bytes);
+            CHECK(bs.readUint8() == 0x5A);
+        }
+        std::fill(std::begin(BUFF), std::end(BUFF), 0);
+
+        uint8_t tooMany[16] = {};
+        bs.setBitIndex(bs.bitSize() - 121);
+        CHECK_THROWS_AS(bs.writeBytes(tooMany, 16), std::out_of_range);
+        CHECK_THROWS_AS(bs.readBytes(tooMany, 16), std::out_of_range);
+        CHECK(bs.bitIndex() == bs.bitSize() - 121);
+    }
+
+    SUBCASE("Variable length integers")
+    {
+        const std::vector<uint64_t> values = {0, 1, 2, 6, 7, 127, 128, 16383, 16384, 1ULL << 40, UINT64_MAX - 1, UINT64_MAX};
+        const std::vector<int64_t> signedValues = {0, -1, 1, -64, 63, -65, INT64_MIN, INT64_MAX};
+
+        for (uint64_t value : values) {
+            bs.writeVarUint(value);
+        }
+        for (int64_t value : signedValues) {
+            bs.writeVarInt(value);
+        }
+
+        bs.setBitIndex(0);
+        for (uint64_t value : values) {
+            CHECK(bs.readVarUint() == value);
+        }
+        for (int64_t value : signedValues) {
+            CHECK(bs.readVarInt() == value);
+        }
+
+        // sizes
+        bs.setBitIndex(0);
+        bs.writeVarUint(127);
+        CHECK(bs.bitIndex() == 8);
+        bs.writeVarUint(128);
+        CHECK(bs.bitIndex() == 24);
+        bs.writeVarInt(-64);
+        CHECK(bs.bitIndex() == 32);
+        bs.writeVarUint(UINT64_MAX);
+        CHECK(bs.bitIndex() == 32 + 80);
+
+        // 11 continuation bytes
+        bs.setBitIndex(0);
+        for (int i = 0; i < 11; i++) {
+            bs.writeUint8(0xFF);
+        }
+        bs.setBitIndex(0);
+        CHECK_THROWS_AS((void)bs.readVarUint(), std::out_of_range);
+
+        // 10 bytes whose last one has more than the 64th bit
+        bs.setBitIndex(0);
+        for (int i = 0; i < 9; i++) {
+            bs.writeUint8(0xFF);
+        }
+        bs.writeUint8(0x7F);
+        bs.setBitIndex(0);
+        CHECK_THROWS_AS((void)bs.readVarUint(), std::out_of_range);
+
+        // the same with only the 64th bit is UINT64_MAX
+        bs.setBitIndex(9 * 8);
+        bs.writeUint8(0x01);
+        bs.setBitIndex(0);
+        CHECK(bs.readVarUint() == UINT64_MAX);
+    }
+
+    SUBCASE("Exp-Golomb")
+    {
+        for (uint8_t k : {0, 1, 4, 12}) {
+            bs.setBitIndex(3);
+            for (uint64_t value = 0; value < 100; value++) {
+                bs.writeExpGolomb(value, k);
+            }
+            bs.writeExpGolomb(UINT64_MAX - (1ULL << k), k);
+            for (int64_t value = -50; value < 50; value++) {
+                bs.writeExpGolombInt(value, k);
+            }
+            bs.writeExpGolombInt(INT64_MIN + (1LL << k), k);
+
+            bs.setBitIndex(3);
+            for (uint64_t value = 0; value < 100; value++) {
+                CHECK(bs.readExpGolomb(k) == value);
+            }
+            CHECK(bs.readExpGolomb(k) == UINT64_MAX - (1ULL << k));
+            for (int64_t value = -50; value < 50; value++) {
+                CHECK(bs.readExpGolombInt(k) == value);
+            }
+            CHECK(bs.readExpGolombInt(k) == INT64_MIN + (1LL << k));
+        }
+
+        // 1 bit for 0, 3 bits up to 2, 5 bits up to 6
+        bs.setBitIndex(0);
+        bs.writeExpGolomb(0);
+        CHECK(bs.bitIndex() == 1);
+        bs.writeExpGolomb(2);
+        CHECK(bs.bitIndex() == 4);
+        bs.writeExpGolomb(6);
+        CHECK(bs.bitIndex() == 9);
+        bs.writeExpGolomb(7);
+        CHECK(bs.bitIndex() == 16);
+
+        // only zeros until the end
+        bs.setBitIndex(bs.bitSize() - 16);
+        bs.writeUint16(0);
+        bs.setBitIndex(bs.bitSize() - 16);
+        CHECK_THROWS_AS((void)bs.readExpGolomb(), std::out_of_range);
+    }
+
+    SUBCASE("Unchecked writer and reader")
+    {
+        {
+            BitStream::UncheckedWriter writer(bs, 5 + 13 + 1 + 32);
+            writer.writeBits<uint8_t>(9, 5);
+            writer.writeBits<int16_t>(-99, 13);
+            writer.writeBool(true);
+            CHECK(writer.remainingBits() == 32);
+            writer.writeFloat32(1.5F);
+            CHECK(writer.remainingBits() == 0);
+        }
+        CHECK(bs.bitIndex() == 51);
+
+        // same bytes as the checked version
+        bs.setBitIndex(0);
+        CHECK(bs.readBits<uint8_t>(5) == 9);
+        CHECK(bs.readBits<int16_t>(13) == -99);
+
+        bs.setBitIndex(0);
+        BitStream::UncheckedReader reader(bs, 51);
+        CHECK(reader.readBits<uint8_t>(5) == 9);
+        CHECK(reader.readBits<int16_t>(13) == -99);
+        CHECK(reader.readBool());
+        CHECK(reader.readFloat32() == 1.5F);
+        CHECK(reader.remainingBits() == 0);
+
+        // random fields at every start offset give the same bytes as the checked writes,
+        // including the bits before and after the block
+        std::mt19937 rng(1337);
+        for (size_t start = 0; start < 16; start++) {
+            uint8_t checked[64];
+            uint8_t unchecked[64];
+            std::ranges::fill(checked, 0xA5);
+            std::ranges::fill(unchecked, 0xA5);
+
+            std::vector<std::pair<uint64_t, uint8_t>> fields;
+            size_t bits = 0;
+            while (true) {
+                uint8_t count = rng() % 65;
+                if (bits + count > 400) {
+                    break;
+                }
+                fields.emplace_back(((uint64_t)rng() << 32) | rng(), count);
+                bits += count;
+            }
+
+            BitStream checkedStream{checked, sizeof(checked)};
+            checkedStream.setBitIndex(start);
+            for (auto [value, count] : fields) {
+                checkedStream.writeBits(value, count);
+            }
+
+            BitStream uncheckedStream{unchecked, sizeof(unchecked)};
+            uncheckedStream.setBitIndex(start);
+            {
+                BitStream::UncheckedWriter writer(uncheckedStream, bits);
+                for (auto [value, count] : fields) {
+                    writer.writeBits(value, count);
+                }
+            }
+
+            CHECK(uncheckedStream.bitIndex() == checkedStream.bitIndex());
+            CHECK(std::ranges::equal(checked, unchecked));
+        }
+
+        // the whole block is checked up front
+        bs.setBitIndex(bs.bitSize() - 8);
+        CHECK_THROWS_AS(BitStream::UncheckedWriter(bs, 9), std::out_of_range);
+        CHECK_THROWS_AS(BitStream::UncheckedReader(bs, 9), std::out_of_range);
+        CHECK(bs.bitIndex() == bs.bitSize() - 8);
     }
 
     SUBCASE("Exceptions")
@@ -119,3 +492,87 @@ TEST_CASE("BitStream tests")
         CHECK_THROWS_WITH_AS(bs.writeUint8(1), "writeBits: trying to write past the end of the buffer, buff size: 8192, buff index: 8192, bits to write: 8", std::out_of_range);
     }
 }
+
+TEST_CASE("Growable BitStream")
+{
+    BufferPool pool;
+    BitStream bs(pool);
+
+    REQUIRE(bs.isGrowable());
+    REQUIRE(bs.byteSize() == 0);
+
+    // nothing to read from before the first grow, the buffer is still null
+    CHECK(bs.readBits<uint32_t>(0) == 0);
+    CHECK_THROWS_AS((void)bs.readExpGolomb(), std::out_of_range);
+
+    // grows instead of throwing
+    for (uint32_t i = 0; i < 1000; i++) {
+        bs.writeBits<uint32_t>(i, 13);
+    }
+    bs.writeString("end");
+
+    CHECK(bs.byteSize() >= bs.byteIndex());
+
+    bs.setBitIndex(0);
+    for (uint32_t i = 0; i < 1000; i++) {
+        CHECK(bs.readBits<uint32_t>(13) == i);
+    }
+    CHECK(bs.readString() == "end");
+
+    std::vector<uint8_t> bytes = bs.takeBytes();
+    CHECK(bytes.size() == ((1000 * 13) + 7) / 8 + 4);
+    CHECK(bs.byteSize() == 0);
+    CHECK(bs.bitIndex() == 0);
+
+    // the bytes read back the same from a regular stream
+    BitStream reader(bytes.data(), bytes.size());
+    CHECK(reader.readBits<uint32_t>(13) == 0);
+    CHECK(reader.readBits<uint32_t>(13) == 1);
+
+    SUBCASE("Buffers are reused once released")
+    {
+        pool.release(std::move(bytes));
+        size_t allocations = pool.allocations();
+
+        for (int tick = 0; tick < 10; tick++) {
+            BitStream packet(pool, 256);
+            for (uint32_t i = 0; i < 500; i++) {
+                packet.writeUint16(i);
+            }
+            pool.release(packet.takeBytes());
+        }
+
+        CHECK(pool.allocations() == allocations);
+    }
+
+    SUBCASE("Reserving grows up front")
+    {
+        bs.reserveBits(100000);
+        CHECK(bs.bitSize() >= bs.bitIndex() + 100000);
+
+        BitStream::UncheckedWriter writer(bs, 200000);
+        CHECK(bs.bitSize() >= bs.bitIndex() + 200000);
+        writer.writeBits<uint32_t>(77, 20);
+    }
+
+    SUBCASE("Copies own their bytes")
+    {
+        bs.writeUint32(1234);
+        BitStream copy = bs;
+        copy.setBitIndex(0);
+        copy.writeUint32(5678);
+
+        bs.setBitIndex(0);
+        copy.setBitIndex(0);
+        CHECK(bs.readUint32() == 1234);
+        CHECK(copy.readUint32() == 5678);
+    }
+
+    SUBCASE("Fixed streams don't own their bytes")
+    {
+        uint8_t buff[4];
+        BitStream fixed{buff, sizeof(buff)};
+        CHECK_FALSE(fixed.isGrowable());
+        CHECK_THROWS_AS((void)fixed.takeBytes(), std::logic_error);
+    }
+}
@@ -0,0 +1,563 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/collision/collision.h"
+#include "fc/core/collision/contactCache.h"
+#include "fc/core/collision/shape.h"
+
+#include <cmath>
+#include <doctest/doctest.h>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Time of impact")
+{
+    Collision::TimeOfImpact toi;
+
+    SUBCASE("Fast circle doesn't tunnel through thin rect")
+    {
+        Circle bullet({0, 0}, 1);
+        Rect wall({50, -10}, {51, 10});
+        Vec2F move{100, 0};
+
+        Circle moved = bullet;
+        moved.translate(move);
+        CHECK_FALSE(moved.getCollision(wall, nullptr));
+
+        REQUIRE(bullet.getTimeOfImpact(move, wall, {}, &toi));
+        CHECK(toi.time == doctest::Approx(0.49));
+        CHECK(toi.normal.equals({1, 0}, 0.0001));
+    }
+
+    SUBCASE("Moving away or too slow doesn't hit")
+    {
+        Circle bullet({0, 0}, 1);
+        Rect wall({50, -10}, {51, 10});
+
+        CHECK_FALSE(bullet.getTimeOfImpact({-100, 0}, wall, {}, &toi));
+        CHECK_FALSE(bullet.getTimeOfImpact({10, 0}, wall, {}, &toi));
+        CHECK_FALSE(bullet.getTimeOfImpact({100, 100}, wall, {}, &toi));
+    }
+
+    SUBCASE("Already colliding returns time 0")
+    {
+        Circle a({0, 0}, 2);
+        Circle b({3, 0}, 2);
+
+        REQUIRE(a.getTimeOfImpact({}, b, {}, &toi));
+        CHECK(toi.time == 0);
+        CHECK(toi.normal.equals({1, 0}, 0.0001));
+    }
+
+    SUBCASE("Circle circle")
+    {
+        Circle a({0, 0}, 1);
+        Circle b({10, 0}, 1);
+
+        REQUIRE(a.getTimeOfImpact({8, 0}, b, {-8, 0}, &toi));
+        CHECK(toi.time == doctest::Approx(0.5));
+        CHECK(toi.normal.equals({1, 0}, 0.0001));
+    }
+
+    SUBCASE("Circle hits polygon vertex")
+    {
+        Circle circle({-10, 1.5}, 1);
+        Polygon square(Rect({0, -1}, {2, 1}).getPoints());
+
+        // touches the (0, 1) corner when the circle center is at (-sqrt(0.75), 1.5)
+        REQUIRE(circle.getTimeOfImpact({20, 0}, square, {}, &toi));
+        CHECK(toi.time == doctest::Approx((10 - std::sqrt(0.75)) / 20));
+        CHECK(toi.normal.equals({std::sqrt(0.75F), -0.5F}, 0.0001));
+    }
+
+    SUBCASE("Rect rect")
+    {
+        Rect a({0, 0}, {1, 1});
+        Rect b({10, 0}, {11, 1});
+
+        REQUIRE(a.getTimeOfImpact({18, 0}, b, {}, &toi));
+        CHECK(toi.time == doctest::Approx(0.5));
+        CHECK(toi.normal.equals({1, 0}, 0.0001));
+
+        // reversed order should flip the normal
+        REQUIRE(b.getTimeOfImpact({}, a, {18, 0}, &toi));
+        CHECK(toi.time == doctest::Approx(0.5));
+        CHECK(toi.normal.equals({-1, 0}, 0.0001));
+
+        CHECK_FALSE(a.getTimeOfImpact({0, 18}, b, {}, &toi));
+    }
+
+    SUBCASE("Polygon polygon")
+    {
+        Polygon a = Polygon::fromSides(6, {0, 0}, 1);
+        Polygon b = Polygon::fromSides(6, {0, 10}, 1);
+
+        REQUIRE(a.getTimeOfImpact({0, 20}, b, {}, &toi));
+        CHECK(toi.time > 0.35);
+        CHECK(toi.time < 0.5);
+        CHECK(toi.normal.y > 0.9);
+
+        CHECK_FALSE(a.getTimeOfImpact({20, 0}, b, {}, &toi));
+    }
+
+    SUBCASE("Rect polygon")
+    {
+        Rect rect({-1, -1}, {1, 1});
+        Polygon poly = Polygon::fromSides(4, {10, 0}, 1);
+
+        REQUIRE(poly.getTimeOfImpact({-20, 0}, rect, {}, &toi));
+        CHECK(toi.time == doctest::Approx(0.4));
+        CHECK(toi.normal.equals({-1, 0}, 0.0001));
+    }
+}
+
+TEST_CASE("Separating axis cache")
+{
+    Polygon a = Polygon::fromSides(8, {0, 0}, 1);
+    Polygon b = Polygon::fromSides(8, {3, 0}, 1);
+    Rect rect({-1, -1}, {1, 1});
+
+    Collision::SatCache cache;
+    Collision::Response res;
+    Collision::Response cachedRes;
+
+    SUBCASE("Cache is stored when separated and cleared when colliding")
+    {
+        // far enough for the bounding circles to skip the separating axis test
+        CHECK_FALSE(a.getCollision(b, nullptr, &cache));
+        CHECK_FALSE(cache.valid);
+
+        // facing edges are 0.924 away from the center but the bounding circles have a radius of 1
+        Vec2F edgeDir = Vec2F{1, 0}.rotate(M_PI / 8);
+        b.translate((edgeDir * 1.95F) - b.center());
+        CHECK_FALSE(a.getCollision(b, nullptr, &cache));
+        CHECK(cache.valid);
+
+        b.translate(edgeDir * -0.05F);
+        CHECK_FALSE(a.getCollision(b, nullptr, &cache));
+        CHECK(cache.valid);
+
+        b.translate(edgeDir * -0.3F);
+        REQUIRE(a.getCollision(b, &cachedRes, &cache));
+        CHECK_FALSE(cache.valid);
+
+        REQUIRE(a.getCollision(b, &res));
+        CHECK(res.normal == cachedRes.normal);
+        CHECK(res.depth == cachedRes.depth);
+    }
+
+    SUBCASE("Results match the uncached test while moving")
+    {
+        for (int i = 0; i < 60; i++) {
+            b.translate({-0.05, 0.01}).rotate(0.02);
+
+            INFO(i);
+            bool uncached = Collision::RectPolygon(rect.min, rect.max, b.points, b.normals(), b.center(), b.radius(), nullptr);
+            bool cached = Collision::RectPolygon(rect.min, rect.max, b.points, b.normals(), b.center(), b.radius(), nullptr, &cache);
+            CHECK(uncached == cached);
+        }
+    }
+}
+
+TEST_CASE("Polygon bounding radius")
+{
+    Polygon poly = Polygon::fromSides(6, {10, 10}, 2);
+    CHECK(poly.radius() == doctest::Approx(2));
+
+    poly.rotate(0.3).translate({5, 5});
+    CHECK(poly.radius() == doctest::Approx(2));
+
+    poly.scale(0.5);
+    CHECK(poly.radius() == doctest::Approx(1));
+
+    Polygon copy = poly;
+    CHECK(copy.radius() == doctest::Approx(1));
+
+    for (const auto& point : poly.points) {
+        CHECK(point.distanceTo(poly.center()) <= poly.radius() + 0.0001);
+    }
+}
+
+TEST_CASE("Contact manifolds")
+{
+    Collision::Manifold manifold;
+
+    SUBCASE("Box resting on box has 2 points")
+    {
+        Rect ground({-10, -1}, {10, 0});
+        Rect box({-1, -0.1}, {1, 1.9});
+
+        REQUIRE(box.getManifold(ground, &manifold));
+        CHECK(manifold.normal.equals({0, -1}, 0.0001));
+        REQUIRE(manifold.pointCount == 2);
+        for (int i = 0; i < 2; i++) {
+            CHECK(manifold.depths[i] == doctest::Approx(0.1));
+            CHECK(std::abs(manifold.points[i].x) == doctest::Approx(1));
+        }
+    }
+
+    SUBCASE("Polygon corner on rect has 1 point")
+    {
+        Rect ground({-10, -1}, {10, 0});
+        Polygon diamond({{0, -0.2}, {1, 0.8}, {0, 1.8}, {-1, 0.8}});
+
+        REQUIRE(ground.getManifold(diamond, &manifold));
+        CHECK(manifold.normal.equals({0, 1}, 0.0001));
+        REQUIRE(manifold.pointCount == 1);
+        CHECK(manifold.points[0].equals({0, -0.2}, 0.0001));
+        CHECK(manifold.depths[0] == doctest::Approx(0.2));
+    }
+
+    SUBCASE("Circle has 1 point")
+    {
+        Circle circle({0, 0.9}, 1);
+        Rect ground({-10, -1}, {10, 0});
+
+        REQUIRE(circle.getManifold(ground, &manifold));
+        CHECK(manifold.normal.equals({0, -1}, 0.0001));
+        REQUIRE(manifold.pointCount == 1);
+        CHECK(manifold.points[0].equals({0, -0.05}, 0.0001));
+        CHECK(manifold.depths[0] == doctest::Approx(0.1));
+    }
+
+    SUBCASE("No manifold when not colliding")
+    {
+        Polygon a = Polygon::fromSides(5, {0, 0}, 1);
+        Polygon b = Polygon::fromSides(5, {5, 0}, 1);
+        CHECK_FALSE(a.getManifold(b, &manifold));
+    }
+}
+
+TEST_CASE("Contact cache")
+{
+    ContactCache<uint32_t> cache;
+    Collision::Manifold manifold;
+
+    cache.beginTick();
+    cache.addContact(1, 2, manifold);
+    cache.addContact(3, 4, manifold);
+    cache.endTick();
+
+    CHECK(cache.began().size() == 2);
+    CHECK(cache.stayed().empty());
+    CHECK(cache.ended().empty());
+    CHECK(cache.touching(2, 1));
+
+    cache.beginTick();
+    cache.addContact(2, 1, manifold);
+    cache.addContact(5, 6, manifold);
+    cache.endTick();
+
+    REQUIRE(cache.began().size() == 1);
+    CHECK(cache.began()[0].a == 5);
+    REQUIRE(cache.stayed().size() == 1);
+    CHECK(cache.stayed()[0].a == 2);
+    REQUIRE(cache.ended().size() == 1);
+    CHECK(cache.ended()[0].a == 3);
+    CHECK_FALSE(cache.touching(3, 4));
+
+    cache.beginTick();
+    cache.addContact(1, 2, manifold);
+    cache.addContact(5, 6, manifold);
+    cache.removeEntity(6);
+    cache.endTick();
+
+    CHECK(cache.stayed().size() == 2);
+    REQUIRE(cache.ended().size() == 1);
+    CHECK(cache.ended()[0].b == 6);
+    CHECK(cache.size() == 1);
+    CHECK(cache.find(1, 2) != nullptr);
+    CHECK(cache.find(5, 6) == nullptr);
+
+    SUBCASE("Parked pairs")
+    {
+        cache.beginTick();
+        cache.addContact(1, 2, manifold);
+        cache.addContact(2, 3, manifold);
+        cache.addContact(7, 8, manifold);
+        cache.endTick();
+
+        // 1, 2 and 3 fall asleep
+        cache.park([](const auto& contact) {
+            return contact.a < 7;
+        });
+        CHECK(cache.parkedCount() == 2);
+        CHECK(cache.size() == 3);
+
+        // not reported but still touching
+        cache.beginTick();
+        cache.addContact(7, 8, manifold);
+        cache.endTick();
+        CHECK(cache.ended().empty());
+        CHECK(cache.touching(1, 2));
+        CHECK(cache.find(3, 2) != nullptr);
+
+        // waking 3 brings back its pair only, which ends when it's not reported
+        cache.unpark(3);
+        CHECK(cache.parkedCount() == 1);
+
+        cache.beginTick();
+        cache.endTick();
+        REQUIRE(cache.ended().size() == 2);
+        CHECK_FALSE(cache.touching(2, 3));
+        CHECK(cache.touching(1, 2));
+
+        // reporting a parked pair brings it back as if it never stopped touching
+        cache.beginTick();
+        cache.addContact(2, 1, manifold);
+        cache.endTick();
+        CHECK(cache.began().empty());
+        CHECK(cache.stayed().size() == 1);
+        CHECK(cache.parkedCount() == 0);
+
+        cache.park([](const auto&) {
+            return true;
+        });
+        cache.removeEntity(1);
+        cache.beginTick();
+        cache.endTick();
+        REQUIRE(cache.ended().size() == 1);
+        CHECK(cache.size() == 0);
+    }
+}
+
+TEST_CASE("Ray casts")
+{
+    Collision::RayHit hit;
+
+    SUBCASE("Circle")
+    {
+        Circle circle({10, 0}, 2);
+
+        REQUIRE(circle.rayCast({0, 0}, {20, 0}, &hit));
+        CHECK(hit.fraction == doctest::Approx(0.4));
+        CHECK(hit.normal.equals({-1, 0}, 0.0001));
+
+        CHECK_FALSE(circle.rayCast({0, 0}, {5, 0}, &hit));
+        CHECK_FALSE(circle.rayCast({0, 3}, {20, 0}, &hit));
+        CHECK_FALSE(circle.rayCast({10, 0}, {20, 0}, &hit));
+    }
+
+    SUBCASE("Rect")
+    {
+        Rect rect({10, -1}, {12, 1});
+
+        REQUIRE(rect.rayCast({0, 0}, {20, 0}, &hit));
+        CHECK(hit.fraction == doctest::Approx(0.5));
+        CHECK(hit.normal.equals({-1, 0}, 0.0001));
+
+        REQUIRE(rect.rayCast({11, 10}, {0, -20}, &hit));
+        CHECK(hit.fraction == doctest::Approx(0.45));
+        CHECK(hit.normal.equals({0, 1}, 0.0001));
+
+        CHECK_FALSE(rect.rayCast({0, 2}, {20, 0}, &hit));
+        CHECK_FALSE(rect.rayCast({0, 0}, {-20, 0}, &hit));
+        CHECK_FALSE(rect.rayCast({11, 0}, {20, 0}, &hit));
+    }
+
+    SUBCASE("Polygon")
+    {
+        // diamond with its left vertex at (8, 0)
+        Polygon diamond({{10, -2}, {12, 0}, {10, 2}, {8, 0}});
+
+        REQUIRE(diamond.rayCast({0, 1}, {20, 0}, &hit));
+        CHECK(hit.fraction == doctest::Approx(0.45));
+        CHECK(hit.normal.equals(Vec2F{-1, 1}.normalize(), 0.0001));
+
+        REQUIRE(diamond.rayCast({10, 10}, {0, -20}, &hit));
+        CHECK(hit.fraction == doctest::Approx(0.4));
+
+        CHECK_FALSE(diamond.rayCast({0, 3}, {20, 0}, &hit));
+        CHECK_FALSE(diamond.rayCast({10, 0}, {20, 0}, &hit));
+    }
+
+    SUBCASE("Batched versions match the single shape versions")
+    {
+        std::vector<float> posX, posY, rads;
+        std::vector<float> minX, minY, maxX, maxY;
+
+        for (int y = -5; y <= 5; y++) {
+            for (int x = -5; x <= 5; x++) {
+                posX.push_back(x * 10.F);
+                posY.push_back(y * 10.F);
+                rads.push_back(1.F + (float)((x + y + 10) % 4));
+
+                minX.push_back((x * 10.F) - 2);
+                minY.push_back((y * 10.F) - 3);
+                maxX.push_back((x * 10.F) + 3);
+                maxY.push_back((y * 10.F) + 2);
+            }
+        }
+
+        std::vector<float> fractions(posX.size());
+
+        for (Vec2F delta : {Vec2F{100, 37}, Vec2F{0, -80}, Vec2F{-60, 0}, Vec2F{3, 3}}) {
+            Vec2F start{1, 4};
+            INFO(delta);
+
+            Collision::RayCircles(start, delta, posX, posY, rads, fractions);
+            for (size_t i = 0; i < fractions.size(); i++) {
+                bool expected = Collision::RayCircle(start, delta, {posX[i], posY[i]}, rads[i], &hit);
+                REQUIRE((fractions[i] != Collision::RAY_MISS) == expected);
+                if (expected) {
+                    CHECK(fractions[i] == doctest::Approx(hit.fraction));
+                }
+            }
+
+            Collision::RayRects(start, delta, minX, minY, maxX, maxY, fractions);
+            for (size_t i = 0; i < fractions.size(); i++) {
+                bool expected = Collision::RayRect(start, delta, {minX[i], minY[i]}, {maxX[i], maxY[i]}, &hit);
+                REQUIRE((fractions[i] != Collision::RAY_MISS) == expected);
+                if (expected) {
+                    CHECK(fractions[i] == doctest::Approx(hit.fraction));
+                }
+            }
+        }
+    }
+}
+
+static float polygonArea(const std::vector<Vec2F>& points)
+{
+    float area = 0;
+    for (size_t i = 0, j = points.size() - 1; i < points.size(); j = i++) {
+        area += points[j].cross(points[i]);
+    }
+    return area / 2;
+}
+
+TEST_CASE("Compound polygons")
+{
+    // U shape with a notch from x 2 to 4 and y 1 to 4
+    const std::vector<Vec2F> outline = {{0, 0}, {6, 0}, {6, 4}, {4, 4}, {4, 1}, {2, 1}, {2, 4}, {0, 4}};
+    CompoundPolygon compound(outline);
+
+    SUBCASE("Decomposition")
+    {
+        REQUIRE(compound.parts().size() == 3);
+
+        float area = 0;
+        for (const auto& part : compound.parts()) {
+            CHECK(Polygon::isConvex(part.points));
+            area += polygonArea(part.points);
+        }
+        CHECK(area == doctest::Approx(polygonArea(outline)));
+
+        auto [min, max] = compound.getAABB();
+        CHECK(min == Vec2F(0, 0));
+        CHECK(max == Vec2F(6, 4));
+
+        // comb with a lot of reflex corners
+        std::vector<Vec2F> comb = {{0, 0}, {20, 0}};
+        for (int tooth = 9; tooth >= 0; tooth--) {
+            comb.emplace_back((tooth * 2) + 2, 5);
+            comb.emplace_back((tooth * 2) + 1.5F, 1);
+            comb.emplace_back((tooth * 2) + 0.5F, 1);
+            comb.emplace_back(tooth * 2, 5);
+        }
+
+        area = 0;
+        auto parts = CompoundPolygon::decompose(comb);
+        for (const auto& part : parts) {
+            CHECK(Polygon::isConvex(part));
+            area += polygonArea(part);
+        }
+        CHECK(area == doctest::Approx(polygonArea(comb)));
+        // at most 4 times the minimum of 11 parts
+        CHECK(parts.size() <= 44);
+
+        // the part tree finds exactly the parts that overlap the query
+        CompoundPolygon combCompound(comb);
+        size_t queried = 0;
+        combCompound.queryParts({-1, -1}, {21, 6}, [&](const Polygon&) {
+            queried++;
+            return true;
+        });
+        CHECK(queried == combCompound.parts().size());
+
+        combCompound.queryParts({4.5F, 2}, {5.5F, 3}, [&](const Polygon& part) {
+            auto [partMin, partMax] = part.getAABB();
+            CHECK(partMin.x <= 5.5F);
+            CHECK(partMax.x >= 4.5F);
+            return true;
+        });
+    }
+
+    SUBCASE("Invalid outlines")
+    {
+        std::vector<Vec2F> clockwise(outline.rbegin(), outline.rend());
+        CHECK_THROWS_AS(CompoundPolygon{clockwise}, std::invalid_argument);
+        CHECK_THROWS_AS((void)CompoundPolygon::decompose(clockwise), std::invalid_argument);
+
+        CHECK_THROWS_AS((void)CompoundPolygon::decompose({{0, 0}, {1, 0}}), std::invalid_argument);
+        CHECK_THROWS_AS((void)CompoundPolygon::decompose({{0, 0}, {1, 0}, {2, 0}}), std::invalid_argument);
+
+        // pentagram, counter-clockwise but crossing itself so it has no ears
+        std::vector<Vec2F> star;
+        for (int i = 0; i < 5; i++) {
+            float angle = (float)i * 4 * std::numbers::pi_v<float> / 5;
+            star.emplace_back(10 * std::cos(angle), 10 * std::sin(angle));
+        }
+        CHECK_THROWS_AS((void)CompoundPolygon::decompose(star), std::invalid_argument);
+    }
+
+    SUBCASE("Queries")
+    {
+        CHECK(compound.pointInside({1, 2}));
+        CHECK_FALSE(compound.pointInside({3, 2}));
+
+        Collision::Response res;
+        CHECK_FALSE(compound.getCollision(Circle({3, 2.5F}, 0.5F), &res));
+        CHECK_FALSE(Circle({3, 2.5F}, 0.5F).getCollision(compound, nullptr));
+
+        REQUIRE(Circle({2.8F, 2.5F}, 1).getCollision(compound, &res));
+        CHECK(res.depth == doctest::Approx(0.2F));
+        CHECK(res.normal.equals({-1, 0}, 0.001F));
+
+        REQUIRE(compound.getCollision(Circle({2.8F, 2.5F}, 1), &res));
+        CHECK(res.normal.equals({1, 0}, 0.001F));
+
+        Collision::Manifold manifold;
+        REQUIRE(Rect({1.5F, 3}, {4.5F, 5}).getManifold(compound, &manifold));
+        CHECK(manifold.pointCount > 0);
+
+        Collision::RayHit hit;
+        REQUIRE(compound.rayCast({-1, 2}, {10, 0}, &hit));
+        CHECK(hit.fraction == doctest::Approx(0.1F));
+        CHECK(hit.normal.equals({-1, 0}, 0.001F));
+
+        REQUIRE(compound.rayCast({3, 3}, {10, 0}, &hit));
+        CHECK(hit.fraction == doctest::Approx(0.1F));
+        CHECK(hit.normal.equals({-1, 0}, 0.001F));
+
+        // starting inside
+        CHECK_FALSE(compound.rayCast({1, 2}, {10, 0}, &hit));
+
+        Collision::TimeOfImpact toi;
+        REQUIRE(Circle({3, 10}, 0.5F).getTimeOfImpact({0, -10}, compound, {}, &toi));
+        CHECK(toi.time == doctest::Approx(0.85F));
+        CHECK(toi.normal.equals({0, -1}, 0.001F));
+    }
+
+    SUBCASE("Transforms")
+    {
+        compound.translate({10, 10});
+        auto [min, max] = compound.getAABB();
+        CHECK(min == Vec2F(10, 10));
+        CHECK(max == Vec2F(16, 14));
+        CHECK(compound.pointInside({11, 12}));
+
+        compound.scale(2);
+        std::tie(min, max) = compound.getAABB();
+        CHECK(min.equals({7, 7.75F}, 0.001F));
+        CHECK(max.equals({19, 15.75F}, 0.001F));
+
+        CompoundPolygon copy = compound;
+        copy.rotate(M_PI);
+        CHECK(copy.pointInside(compound.center() + Vec2F{-4, -2}));
+        CHECK_FALSE(copy.pointInside(compound.center() + Vec2F{0, -2}));
+    }
+}
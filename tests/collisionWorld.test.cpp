@@ -0,0 +1,102 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/collision/collisionWorld.h"
+
+#include "fc/core/collision/shape.h"
+
+#include <algorithm>
+#include <doctest/doctest.h>
+#include <memory>
+#include <vector>
+
+static bool contains(const std::vector<CollisionWorld::ShapeID>& ids, CollisionWorld::ShapeID id)
+{
+    return std::ranges::find(ids, id) != ids.end();
+}
+
+TEST_CASE("Collision world")
+{
+    CollisionWorld world({});
+
+    auto wall = world.add(std::make_unique<Rect>(Vec2F{100, 100}, Vec2F{200, 110}));
+    auto ball = world.add(std::make_unique<Circle>(Vec2F{150, 50}, 5));
+    auto tri = world.add(std::make_unique<Polygon>(std::vector<Vec2F>{{300, 300}, {340, 300}, {320, 330}}));
+
+    REQUIRE(world.isValid(wall));
+    REQUIRE(world.isValid(ball));
+    REQUIRE(world.isValid(tri));
+    REQUIRE(world.dirtyCount() == 0);
+
+    SUBCASE("AABBs are cached when added")
+    {
+        CHECK(world.getAABB(wall).first == Vec2F(100, 100));
+        CHECK(world.getAABB(wall).second == Vec2F(200, 110));
+        CHECK(world.getAABB(ball).first == Vec2F(145, 45));
+        CHECK(world.getAABB(tri).second == Vec2F(340, 330));
+    }
+
+    SUBCASE("Queries")
+    {
+        // same grid cell as the wall but outside of its AABB
+        CHECK(world.queryAABB({101, 111}, {102, 112}).empty());
+
+        const auto& inWall = world.queryAABB({150, 105}, {151, 106});
+        CHECK(inWall.size() == 1);
+        CHECK(contains(inWall, wall));
+
+        Circle probe({150, 98}, 3);
+        const auto& touching = world.queryShape(probe);
+        CHECK(touching.size() == 1);
+        CHECK(contains(touching, wall));
+
+        // doesn't find itself
+        CHECK(world.queryShape(world.shape(ball)).empty());
+    }
+
+    SUBCASE("Only modified shapes are re-inserted on update")
+    {
+        world.modify(ball).translate({0, 50});
+        // twice before the update is still one dirty shape
+        world.modify(ball).translate({0, 1});
+
+        CHECK(world.isDirty(ball));
+        CHECK_FALSE(world.isDirty(wall));
+        CHECK(world.dirtyCount() == 1);
+
+        // queries use the state of the last update
+        CHECK(world.getAABB(ball).first == Vec2F(145, 45));
+        CHECK_FALSE(contains(world.queryAABB({148, 99}, {152, 101}), ball));
+
+        world.update();
+
+        CHECK_FALSE(world.isDirty(ball));
+        CHECK(world.dirtyCount() == 0);
+        CHECK(world.getAABB(ball).first == Vec2F(145, 96));
+
+        const auto& touching = world.queryShape(world.shape(ball));
+        CHECK(touching.size() == 1);
+        CHECK(contains(touching, wall));
+
+        CHECK(contains(world.queryAABB({148, 99}, {152, 101}), ball));
+        CHECK_FALSE(contains(world.queryAABB({148, 49}, {152, 51}), ball));
+    }
+
+    SUBCASE("Remove")
+    {
+        world.modify(tri).translate({-150, -150});
+        world.remove(tri);
+
+        CHECK_FALSE(world.isValid(tri));
+        CHECK(world.dirtyCount() == 0);
+        CHECK(world.queryAABB({0, 0}, {1000, 1000}).size() == 2);
+
+        // the ID is reused
+        auto box = world.add(std::make_unique<Rect>(Vec2F{0, 0}, Vec2F{10, 10}));
+        CHECK(world.isValid(box));
+        CHECK(world.queryAABB({0, 0}, {1000, 1000}).size() == 3);
+    }
+}
@@ -0,0 +1,211 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/eventLoop.h"
+
+#include <cstdint>
+#include <doctest/doctest.h>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+TEST_CASE("Event loop")
+{
+    SUBCASE("Timers")
+    {
+        EventLoop loop;
+        std::vector<int> order;
+
+        loop.setTimeout(0.02, [&] { order.push_back(2); });
+        loop.setTimeout(0.01, [&] { order.push_back(1); });
+        EventLoop::HandleID cancelled = loop.setTimeout(0.01, [&] { order.push_back(-1); });
+        loop.cancel(cancelled);
+
+        // cancelling twice or an unknown ID does nothing
+        loop.cancel(cancelled);
+        loop.cancel(12345);
+
+        double start = EventLoop::now();
+        loop.run();
+
+        CHECK(order == std::vector<int>{1, 2});
+        CHECK(EventLoop::now() - start >= 0.019);
+    }
+
+    SUBCASE("Intervals cancelling themselves")
+    {
+        EventLoop loop;
+        int calls = 0;
+
+        EventLoop::HandleID interval = 0;
+        interval = loop.setInterval(0.001, [&] {
+            if (++calls == 5) {
+                loop.cancel(interval);
+            }
+        });
+        loop.run();
+
+        CHECK(calls == 5);
+    }
+
+    SUBCASE("Ticker")
+    {
+        EventLoop loop;
+        std::vector<uint32_t> ticks;
+
+        EventLoop::HandleID ticker = 0;
+        double start = EventLoop::now();
+        ticker = loop.setTicker(100, [&](uint32_t tick, double dt) {
+            CHECK(dt == doctest::Approx(0.01));
+            ticks.push_back(tick);
+            if (ticks.size() == 20) {
+                loop.cancel(ticker);
+            }
+        });
+        loop.run();
+        double elapsed = EventLoop::now() - start;
+
+        REQUIRE(ticks.size() == 20);
+        for (uint32_t i = 0; i < ticks.size(); i++) {
+            CHECK(ticks[i] == i);
+        }
+
+        // the first tick is right away, then one every 10 ms without drifting.
+        // No upper bound, a loaded machine can be late by any amount
+        CHECK(elapsed >= 0.19);
+
+        CHECK_THROWS_AS((void)loop.setTicker(0, [](uint32_t, double) {}), std::invalid_argument);
+    }
+
+    SUBCASE("Idle")
+    {
+        EventLoop loop;
+        int calls = 0;
+
+        EventLoop::HandleID idle = 0;
+        idle = loop.setIdle([&] {
+            if (++calls == 3) {
+                loop.cancel(idle);
+            }
+        });
+        loop.run();
+
+        CHECK(calls == 3);
+    }
+
+    SUBCASE("Posting from other threads")
+    {
+        EventLoop loop;
+        int received = 0;
+
+        // keeps the loop running until every post arrived
+        EventLoop::HandleID keepAlive = loop.setInterval(1, [] {});
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; i++) {
+            threads.emplace_back([&] {
+                for (int j = 0; j < 100; j++) {
+                    loop.post([&] {
+                        if (++received == 400) {
+                            loop.cancel(keepAlive);
+                        }
+                    });
+                }
+            });
+        }
+
+        loop.run();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        CHECK(received == 400);
+    }
+
+    SUBCASE("Stop")
+    {
+        EventLoop loop;
+        int calls = 0;
+
+        loop.setInterval(0.001, [&] {
+            calls++;
+            loop.stop();
+        });
+        loop.run();
+        CHECK(calls == 1);
+
+        // the interval is still there
+        loop.run();
+        CHECK(calls == 2);
+        CHECK(loop.runOnce());
+    }
+
+    SUBCASE("Files")
+    {
+        EventLoop loop;
+        std::string path = (std::filesystem::temp_directory_path() / "fc_event_loop_test.bin").string();
+
+        std::vector<uint8_t> bytes(100'000);
+        for (size_t i = 0; i < bytes.size(); i++) {
+            bytes[i] = (uint8_t)(i * 7);
+        }
+
+        // REQUIRE throws, which callbacks mustn't do, results are kept to be checked after the loop
+        bool written = false;
+        std::optional<EventLoop::ReadResult> readBack;
+        loop.writeFile(path, bytes, [&](EventLoop::WriteResult result) {
+            CHECK(result.has_value());
+            written = true;
+
+            loop.readFile(path, [&](EventLoop::ReadResult read) {
+                readBack = std::move(read);
+            });
+        });
+        loop.run();
+        CHECK(written);
+        REQUIRE(readBack.has_value());
+        REQUIRE(readBack->has_value());
+        CHECK(**readBack == bytes);
+
+        // empty files
+        loop.writeFile(path, {}, [](EventLoop::WriteResult result) { CHECK(result.has_value()); });
+        loop.run();
+        readBack.reset();
+        loop.readFile(path, [&](EventLoop::ReadResult read) {
+            readBack = std::move(read);
+        });
+        loop.run();
+        REQUIRE(readBack.has_value());
+        REQUIRE(readBack->has_value());
+        CHECK((*readBack)->empty());
+
+        std::filesystem::remove(path);
+
+        readBack.reset();
+        loop.readFile(path, [&](EventLoop::ReadResult read) {
+            readBack = std::move(read);
+        });
+        loop.run();
+        REQUIRE(readBack.has_value());
+        REQUIRE_FALSE(readBack->has_value());
+        CHECK(readBack->error().find("couldn't open") != std::string::npos);
+    }
+
+    SUBCASE("Destroying with work left")
+    {
+        bool called = false;
+        {
+            EventLoop loop;
+            loop.setTimeout(10, [&] { called = true; });
+            loop.setIdle([&] { called = true; });
+            loop.readFile("does_not_exist", [&](EventLoop::ReadResult) { called = true; });
+        }
+        CHECK_FALSE(called);
+    }
+}
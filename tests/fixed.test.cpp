@@ -0,0 +1,216 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/collision/collision.h"
+#include "fc/core/collision/grid.h"
+#include "fc/core/collision/shape.h"
+#include "fc/core/math/fixed.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <doctest/doctest.h>
+#include <random>
+
+TEST_CASE("Fixed point math")
+{
+    // 1 / 65536, the smallest step
+    const float step = 1.F / Fixed::ONE;
+
+    SUBCASE("Arithmetic")
+    {
+        Fixed a(1.5F);
+        Fixed b = 2;
+
+        CHECK((a + b).toFloat() == 3.5F);
+        CHECK((a - b).toFloat() == -0.5F);
+        CHECK((a * b).toFloat() == 3.F);
+        CHECK((a / b).toFloat() == 0.75F);
+        CHECK((-a).toFloat() == -1.5F);
+        CHECK((2 * a) == (a * 2));
+
+        CHECK(a < b);
+        CHECK(b > 1);
+        CHECK(Fixed(2.F) == b);
+
+        // conversion to int rounds down
+        CHECK((int)Fixed(2.75F) == 2);
+        CHECK((int)Fixed(-2.25F) == -3);
+
+        // squared world coordinates don't overflow
+        Fixed big = 30'000;
+        CHECK((big * big).toFloat() == 900'000'000.F);
+    }
+
+    SUBCASE("sqrt and abs")
+    {
+        CHECK(sqrt(Fixed(4)) == 2);
+        CHECK(sqrt(Fixed(0)) == 0);
+        CHECK(abs(Fixed(-3)) == 3);
+
+        for (float value : {0.25F, 2.F, 10.F, 1234.5F, 1'000'000.F}) {
+            INFO(value);
+            CHECK(sqrt(Fixed(value)).toFloat() == doctest::Approx(std::sqrt(value)).epsilon(0.0001));
+        }
+    }
+
+    SUBCASE("sin and cos")
+    {
+        float maxError = 0;
+        for (int i = -2000; i <= 2000; i++) {
+            float angle = i * 0.01F;
+
+            maxError = std::max(maxError, std::abs(sin(Fixed(angle)).toFloat() - std::sin(angle)));
+            maxError = std::max(maxError, std::abs(cos(Fixed(angle)).toFloat() - std::cos(angle)));
+        }
+        CHECK(maxError <= step * 4);
+
+        CHECK(sin(Fixed(0)) == 0);
+        CHECK(cos(Fixed(0)) == 1);
+    }
+
+    SUBCASE("Vectors")
+    {
+        Vec2Fx vec(3, 4);
+        CHECK(vec.length() == 5);
+
+        vec.normalize();
+        CHECK(vec.equals(Vec2Fx(Fixed(0.6F), Fixed(0.8F)), Fixed::fromRaw(2)));
+
+        Vec2Fx right(1, 0);
+        right.rotate(FixedConstants::HALF_PI);
+        CHECK(right.equals(Vec2Fx(0, 1), Fixed::fromRaw(2)));
+    }
+}
+
+TEST_CASE("Fixed point collision")
+{
+    SUBCASE("Matches float results")
+    {
+        CircleFx circleFx({0, 0}, 2);
+        PolygonFx squareFx({{1, -1}, {3, -1}, {3, 1}, {1, 1}});
+
+        Circle circle({0, 0}, 2);
+        Polygon square({{1, -1}, {3, -1}, {3, 1}, {1, 1}});
+
+        Collision::ResponseFx resFx;
+        Collision::Response res;
+        REQUIRE(circleFx.getCollision(squareFx, &resFx));
+        REQUIRE(circle.getCollision(square, &res));
+
+        CHECK(resFx.depth.toFloat() == doctest::Approx(res.depth).epsilon(0.001));
+        CHECK(resFx.normal.x.toFloat() == doctest::Approx(res.normal.x).epsilon(0.001));
+        CHECK(resFx.normal.y.toFloat() == doctest::Approx(res.normal.y).epsilon(0.001));
+
+        RectFx rectFx({5, 0}, {6, 1});
+        CHECK_FALSE(rectFx.getCollision(squareFx, nullptr));
+
+        Collision::TimeOfImpactFx toi;
+        REQUIRE(rectFx.getTimeOfImpact({-4, 0}, squareFx, {}, &toi));
+        CHECK(toi.time.toFloat() == doctest::Approx(0.5F).epsilon(0.001));
+
+        Collision::RayHitFx hit;
+        REQUIRE(squareFx.rayCast({-10, 0}, {20, 0}, &hit));
+        CHECK(hit.fraction.toFloat() == doctest::Approx(0.55F).epsilon(0.001));
+        CHECK(hit.normal == Vec2Fx(-1, 0));
+
+        REQUIRE(rectFx.rayCast({Fixed(5.5F), -5}, {0, 10}, &hit));
+        CHECK(hit.fraction.toFloat() == doctest::Approx(0.5F).epsilon(0.001));
+        CHECK(hit.normal == Vec2Fx(0, -1));
+    }
+
+    SUBCASE("Rays and sweeps at world scale")
+    {
+        // squared distances of a few thousand units are close to what Fixed can multiply
+        std::mt19937 rng(1337);
+
+        for (float scale : {200.F, 1000.F, 4000.F}) {
+            std::uniform_real_distribution<float> position(0, scale);
+            std::uniform_real_distribution<float> radius(1, scale / 10);
+
+            int hits = 0;
+            for (int i = 0; i < 500; i++) {
+                Vec2F start(position(rng), position(rng));
+                Vec2F end(position(rng), position(rng));
+                Vec2F circlePos(position(rng), position(rng));
+                float circleRad = radius(rng);
+
+                Vec2Fx startFx(Fixed(start.x), Fixed(start.y));
+                Vec2Fx endFx(Fixed(end.x), Fixed(end.y));
+                Vec2Fx circlePosFx(Fixed(circlePos.x), Fixed(circlePos.y));
+
+                INFO(scale, " ", i);
+
+                Collision::RayHit hit;
+                Collision::RayHitFx hitFx;
+                bool rayHit = Collision::RayCircle(start, end - start, circlePos, circleRad, &hit);
+                REQUIRE(Collision::RayCircle(startFx, endFx - startFx, circlePosFx, Fixed(circleRad), &hitFx) == rayHit);
+                if (rayHit) {
+                    CHECK(hitFx.fraction.toFloat() == doctest::Approx(hit.fraction).epsilon(0.001));
+                    hits++;
+                }
+
+                // the circle moving the other way, half of the move each
+                Collision::TimeOfImpact toi;
+                Collision::TimeOfImpactFx toiFx;
+                Vec2F move = (end - start) / 2;
+                Vec2Fx moveFx = (endFx - startFx) / 2;
+                bool sweepHit = Collision::SweepCircleCircle(start, 1.F, move, circlePos, circleRad, -move, &toi);
+                REQUIRE(
+                    Collision::SweepCircleCircle(startFx, Fixed(1), moveFx, circlePosFx, Fixed(circleRad), -moveFx, &toiFx)
+                    == sweepHit
+                );
+                if (sweepHit) {
+                    CHECK(toiFx.time.toFloat() == doctest::Approx(toi.time).epsilon(0.001));
+                }
+            }
+
+            // enough of them hit to mean something
+            CHECK(hits > 10);
+        }
+    }
+
+    SUBCASE("Results are exact")
+    {
+        // the same inputs always give the same bits, even after many steps
+        auto simulate = [] {
+            PolygonFx poly = PolygonFx::fromSides(7, {10, 10}, 3);
+            CircleFx circle({0, 10}, 1);
+
+            int64_t checksum = 0;
+            for (int i = 0; i < 200; i++) {
+                poly.rotate(Fixed(0.05F));
+                circle.translate({Fixed(0.1F), Fixed(0.01F)});
+
+                Collision::ResponseFx res;
+                if (circle.getCollision(poly, &res)) {
+                    circle.translate(res.normal * -res.depth);
+                    checksum += res.depth.raw() + res.normal.x.raw() + res.normal.y.raw();
+                }
+            }
+            return checksum + circle.pos.x.raw() + circle.pos.y.raw();
+        };
+
+        int64_t first = simulate();
+        CHECK(first != 0);
+        CHECK(simulate() == first);
+    }
+
+    SUBCASE("Grid")
+    {
+        Grid<uint32_t, uint32_t, Fixed> grid(1024, 16, 16);
+
+        grid.insertEntity(1, {Fixed(0.5F), Fixed(0.5F)}, {20, 20});
+        grid.insertEntity(2, {100, 100}, {Fixed(100.5F), Fixed(100.5F)});
+
+        auto result = grid.queryAABB({10, 10}, {40, 40});
+        CHECK(result.size() == 1);
+        CHECK(result[0] == 1);
+
+        result = grid.queryLine({Fixed(0.5F), Fixed(0.5F)}, {Fixed(120.5F), Fixed(120.5F)});
+        CHECK(result.size() == 2);
+    }
+}
@@ -0,0 +1,194 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/server/gameServer.h"
+#include "fc/server/serverCluster.h"
+
+#include "fc/core/ticker.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <doctest/doctest.h>
+#include <thread>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Stops itself `stopAfter` ticks after `ready` is set
+ */
+class StoppingServer : public GameServer
+{
+public:
+    uint32_t ticksRun = 0;
+    uint32_t stopAfter = 0;
+    std::atomic<bool> ready = true;
+
+    using GameServer::GameServer;
+
+protected:
+    void onTick(uint32_t tick, float dt) override
+    {
+        CHECK(tick == ticksRun);
+        CHECK(dt == doctest::Approx(1.F / config().tickRate));
+
+        ticksRun++;
+        if (ready) {
+            m_readyTicks++;
+        }
+        if (m_readyTicks == stopAfter) {
+            stop();
+        }
+    }
+
+private:
+    uint32_t m_readyTicks = 0;
+};
+
+#ifndef _WIN32
+/**
+ * Connects without sending anything, so the server is left with a socket in the HTTP phase
+ */
+static int connectIdle(uint16_t port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+#endif
+
+TEST_CASE("Game server")
+{
+    SUBCASE("Ticks at its rate until stopped")
+    {
+        // port 0 picks any free one
+        StoppingServer server({.port = 0, .tickRate = 50});
+        server.stopAfter = 10;
+
+        double start = Ticker::getTime();
+        REQUIRE(server.run());
+        double elapsed = Ticker::getTime() - start;
+
+        CHECK(server.ticksRun == 10);
+        CHECK(server.currentTick() == 10);
+        CHECK(server.stats().ticks == 10);
+
+        // the first tick runs right away, the other 9 are 20ms apart
+        CHECK(elapsed >= 0.17);
+        CHECK(elapsed < 2);
+        CHECK(server.clientCount() == 0);
+    }
+
+#ifndef _WIN32
+    SUBCASE("Stopping closes sockets that didn't upgrade")
+    {
+        constexpr uint16_t PORT = 29517;
+
+        // connects once the server is up, then the server stops itself a few ticks later
+        StoppingServer server({.port = PORT, .tickRate = 50});
+        server.stopAfter = 5;
+        server.ready = false;
+
+        int fd = -1;
+        std::thread client([&] {
+            for (int attempt = 0; attempt < 100 && fd < 0; attempt++) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                fd = connectIdle(PORT);
+            }
+            server.ready = true;
+        });
+
+        double start = Ticker::getTime();
+        bool listened = server.run();
+        double elapsed = Ticker::getTime() - start;
+        client.join();
+
+        REQUIRE(listened);
+        CHECK(fd >= 0);
+
+        // well before the HTTP idle timeout
+        CHECK(elapsed < 5);
+
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+static std::unique_ptr<GameServer> makeWorker(size_t /*worker*/)
+{
+    return std::make_unique<GameServer>(GameServer::Config{.port = 0, .tickRate = 30});
+}
+
+TEST_CASE("Server cluster")
+{
+    SUBCASE("A stop before run isn't lost")
+    {
+        ServerCluster cluster(0, 2, makeWorker);
+        cluster.stop();
+
+        double start = Ticker::getTime();
+        CHECK(cluster.run());
+        CHECK(Ticker::getTime() - start < 5);
+    }
+
+#ifndef _WIN32
+    SUBCASE("Connections that didn't upgrade yet count as load")
+    {
+        constexpr uint16_t PORT = 29518;
+
+        ServerCluster cluster(PORT, 2, makeWorker);
+        bool listened = false;
+        std::thread acceptor([&] {
+            listened = cluster.run();
+        });
+
+        int first = -1;
+        for (int attempt = 0; attempt < 100 && first < 0; attempt++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            first = connectIdle(PORT);
+        }
+        int second = connectIdle(PORT);
+
+        // neither sends its HTTP upgrade, so they're never clients but each worker still gets one
+        for (int i = 0; i < 100 && cluster.load(0) + cluster.load(1) < 2; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        CHECK(first >= 0);
+        CHECK(second >= 0);
+        CHECK(cluster.load(0) == 1);
+        CHECK(cluster.load(1) == 1);
+
+        double start = Ticker::getTime();
+        cluster.stop();
+        acceptor.join();
+        CHECK(listened);
+        CHECK(Ticker::getTime() - start < 5);
+
+        for (int fd : {first, second}) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+#endif
+}
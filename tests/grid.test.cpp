@@ -6,9 +6,11 @@
 
 #include "fc/core/collision/shape.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <doctest/doctest.h>
+#include <vector>
 
 #define private public
 #include "fc/core/collision/grid.h"
@@ -167,6 +169,18 @@ TEST_CASE("Grid tests")
 
         const auto& query4 = grid.queryAABB({50, 50}, {60, 60});
         CHECK(query4.empty());
+
+        // appending version, once per overlapping cell and without touching the query state
+        uint32_t queryID = grid.m_nextQueryID;
+        std::vector<uint32_t> out = {1};
+        grid.queryAABB({25, 25}, {30, 30}, out);
+        CHECK(out == std::vector<uint32_t>{1, entityA.id, entityB.id});
+
+        out.clear();
+        grid.queryAABB({0, 0}, {20, 20}, out);
+        CHECK(std::ranges::count(out, entityA.id) == 4);
+        CHECK(std::ranges::count(out, entityB.id) == 1);
+        CHECK(grid.m_nextQueryID == queryID);
     }
 
     SUBCASE("queryPosition")
@@ -0,0 +1,150 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/net/huffman.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <doctest/doctest.h>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * Mostly small bytes like the ones of quantized deltas and counts
+ */
+static std::vector<uint8_t> skewedPacket(std::mt19937& rng, size_t size)
+{
+    std::geometric_distribution<uint32_t> dist(0.3);
+
+    std::vector<uint8_t> packet(size);
+    for (uint8_t& byte : packet) {
+        byte = (uint8_t)std::min<uint32_t>(dist(rng), 255);
+    }
+    return packet;
+}
+
+TEST_CASE("Huffman model")
+{
+    std::mt19937 rng(5);
+
+    HuffmanModel::ByteCounts counts{};
+    for (size_t i = 0; i < 50; i++) {
+        HuffmanModel::count(counts, skewedPacket(rng, 200));
+    }
+    HuffmanModel model(counts);
+
+    CHECK(std::ranges::max(model.codeLengths()) <= HuffmanModel::MAX_CODE_BITS);
+    // the most common byte has the shortest code
+    CHECK(model.codeLengths()[0] == std::ranges::min(model.codeLengths()));
+
+    std::vector<uint8_t> buff(4096);
+    std::vector<uint8_t> read;
+
+    SUBCASE("Round trip")
+    {
+        for (size_t size : {0, 1, 3, 4, 5, 100, 1000}) {
+            std::vector<uint8_t> packet = skewedPacket(rng, size);
+
+            BitStream stream(buff.data(), buff.size());
+            stream.writeBits<uint8_t>(5, 3);
+            model.compress(stream, packet);
+            stream.writeUint8(0xAB);
+            size_t end = stream.bitIndex();
+
+            stream.setBitIndex(0);
+            CHECK(stream.readBits<uint8_t>(3) == 5);
+            model.decompress(stream, read);
+            CHECK(read == packet);
+            CHECK(stream.readUint8() == 0xAB);
+            CHECK(stream.bitIndex() == end);
+        }
+    }
+
+    SUBCASE("Smaller than the raw bytes")
+    {
+        std::vector<uint8_t> packet = skewedPacket(rng, 1000);
+
+        BitStream stream(buff.data(), buff.size());
+        model.compress(stream, packet);
+        CHECK(stream.byteIndex() < packet.size() / 2);
+    }
+
+    SUBCASE("Bytes that don't compress are written raw")
+    {
+        std::vector<uint8_t> packet(500);
+        for (uint8_t& byte : packet) {
+            byte = (uint8_t)rng();
+        }
+        // every byte value is encodable even if it was never seen
+        CHECK(model.encodedBits(packet) > packet.size() * 8);
+
+        BitStream stream(buff.data(), buff.size());
+        model.compress(stream, packet);
+        // flag, size, raw bytes
+        CHECK(stream.bitIndex() == 1 + 16 + (packet.size() * 8));
+
+        stream.setBitIndex(0);
+        model.decompress(stream, read);
+        CHECK(read == packet);
+    }
+
+    SUBCASE("Rebuilt from its code lengths")
+    {
+        HuffmanModel rebuilt = HuffmanModel::fromCodeLengths(model.codeLengths());
+        std::vector<uint8_t> packet = skewedPacket(rng, 300);
+
+        BitStream stream(buff.data(), buff.size());
+        model.compress(stream, packet);
+        stream.setBitIndex(0);
+        rebuilt.decompress(stream, read);
+        CHECK(read == packet);
+
+        HuffmanModel::CodeLengths lengths = model.codeLengths();
+        lengths[7]++;
+        CHECK_THROWS_AS((void)HuffmanModel::fromCodeLengths(lengths), std::invalid_argument);
+        lengths[7] = 0;
+        CHECK_THROWS_AS((void)HuffmanModel::fromCodeLengths(lengths), std::invalid_argument);
+    }
+
+    SUBCASE("Truncated streams")
+    {
+        std::vector<uint8_t> packet = skewedPacket(rng, 300);
+
+        BitStream stream(buff.data(), buff.size());
+        model.compress(stream, packet);
+
+        BitStream truncated(buff.data(), stream.byteIndex() - 4);
+        CHECK_THROWS_AS(model.decompress(truncated, read), std::out_of_range);
+    }
+}
+
+TEST_CASE("Huffman code lengths are limited")
+{
+    // fibonacci counts make the deepest possible tree
+    HuffmanModel::ByteCounts counts{};
+    uint64_t a = 1;
+    uint64_t b = 1;
+    for (size_t i = 0; i < 60; i++) {
+        counts[i] = a;
+        a = std::exchange(b, a + b);
+    }
+
+    HuffmanModel model(counts);
+    CHECK(std::ranges::max(model.codeLengths()) == HuffmanModel::MAX_CODE_BITS);
+    CHECK_NOTHROW((void)HuffmanModel::fromCodeLengths(model.codeLengths()));
+
+    std::vector<uint8_t> packet = {0, 59, 58, 200, 1, 59};
+    std::vector<uint8_t> buff(64);
+    BitStream stream(buff.data(), buff.size());
+    model.compress(stream, packet);
+
+    std::vector<uint8_t> read;
+    stream.setBitIndex(0);
+    model.decompress(stream, read);
+    CHECK(read == packet);
+}
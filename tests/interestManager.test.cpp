@@ -0,0 +1,168 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/net/interestManager.h"
+
+#include "fc/core/bitStream.h"
+#include "fc/core/net/snapshot.h"
+#include "fc/core/threadPool.h"
+
+#include <array>
+#include <cstdint>
+#include <doctest/doctest.h>
+#include <random>
+#include <vector>
+
+using IDs = std::vector<uint32_t>;
+
+static void place(InterestManager::SpatialGrid& grid, uint32_t id, Vec2F position)
+{
+    grid.insertEntity(id, position, position);
+}
+
+TEST_CASE("Interest manager")
+{
+    // 16x16 cells of 64
+    InterestManager::SpatialGrid grid(1024, 64, 128);
+    InterestManager interest(8);
+
+    SUBCASE("Enter, leave and keep")
+    {
+        place(grid, 1, {10, 10});
+        place(grid, 2, {100, 10});
+        place(grid, 3, {500, 500});
+
+        // covers the 4 top left cells
+        interest.setView(1, {0, 0}, {127, 127});
+        CHECK(interest.hasClient(1));
+        CHECK_FALSE(interest.hasClient(2));
+
+        interest.update(grid);
+        CHECK(interest.visible(1) == IDs{1, 2});
+        CHECK(interest.entered(1) == IDs{1, 2});
+        CHECK(interest.left(1).empty());
+        CHECK(interest.kept(1).empty());
+
+        // 2 leaves, 3 enters, 1 moves but stays in view
+        place(grid, 1, {20, 20});
+        place(grid, 2, {300, 10});
+        place(grid, 3, {60, 60});
+
+        interest.update(grid);
+        CHECK(interest.visible(1) == IDs{1, 3});
+        CHECK(interest.entered(1) == IDs{3});
+        CHECK(interest.left(1) == IDs{2});
+        CHECK(interest.kept(1) == IDs{1});
+
+        // removed from the grid
+        grid.removeEntity(1);
+        interest.update(grid);
+        CHECK(interest.left(1) == IDs{1});
+        CHECK(interest.kept(1) == IDs{3});
+
+        // a client that comes back sees everything as entered again
+        interest.removeClient(1);
+        CHECK_FALSE(interest.hasClient(1));
+        interest.setView(1, {0, 0}, {127, 127});
+        interest.update(grid);
+        CHECK(interest.entered(1) == IDs{3});
+    }
+
+    SUBCASE("Entities spanning cells are listed once")
+    {
+        grid.insertEntity(5, {50, 50}, {150, 150});
+
+        interest.setView(2, {0, 0}, {1023, 1023});
+        interest.update(grid);
+        CHECK(interest.visible(2) == IDs{5});
+    }
+
+    SUBCASE("Parallel updates match serial ones")
+    {
+        std::mt19937 rng(1337);
+        std::uniform_real_distribution<float> position(0, 1023);
+
+        InterestManager serial(8);
+        ThreadPool pool(3);
+
+        for (int round = 0; round < 10; round++) {
+            for (uint32_t id = 1; id <= 100; id++) {
+                place(grid, id, {position(rng), position(rng)});
+            }
+            for (uint32_t client = 1; client <= 8; client++) {
+                Vec2F min(position(rng), position(rng));
+                interest.setView(client, min, min + 200);
+                serial.setView(client, min, min + 200);
+            }
+
+            interest.update(grid, &pool);
+            serial.update(grid);
+
+            for (uint32_t client = 1; client <= 8; client++) {
+                INFO(round, client);
+                CHECK(interest.visible(client) == serial.visible(client));
+                CHECK(interest.entered(client) == serial.entered(client));
+                CHECK(interest.left(client) == serial.left(client));
+                CHECK(interest.kept(client) == serial.kept(client));
+            }
+        }
+    }
+
+    SUBCASE("Feeding a per client snapshot encoder")
+    {
+        for (uint32_t id = 1; id <= 4; id++) {
+            place(grid, id, {(float)id * 100, 10});
+        }
+
+        Snapshot world(1);
+        auto fillWorld = [&](uint32_t tick) {
+            world.clear(tick);
+            for (uint32_t id = 1; id <= 4; id++) {
+                world.add(id, std::array{id * 10 + tick});
+            }
+        };
+
+        SnapshotEncoder encoder({16}, 8);
+        SnapshotDecoder decoder({16}, 8);
+        std::vector<uint8_t> buff(256);
+
+        // sees 1 and 2
+        interest.setView(3, {0, 0}, {250, 50});
+        interest.update(grid);
+
+        fillWorld(1);
+        Snapshot& first = encoder.next(1);
+        interest.filter(3, world, first);
+        CHECK(first.tick() == 1);
+        REQUIRE(first.size() == 2);
+
+        BitStream stream(buff.data(), buff.size());
+        encoder.write(stream, SnapshotEncoder::NO_BASELINE);
+        stream.setBitIndex(0);
+        const Snapshot& decoded = decoder.read(stream);
+        REQUIRE(decoded.size() == 2);
+        CHECK(decoded.find(1)[0] == 11);
+        CHECK(decoded.find(2)[0] == 21);
+
+        // the view moves right, 1 leaves and 3 enters
+        interest.setView(3, {150, 0}, {350, 50});
+        interest.update(grid);
+        CHECK(interest.entered(3) == IDs{3});
+        CHECK(interest.left(3) == IDs{1});
+
+        fillWorld(2);
+        interest.filter(3, world, encoder.next(2));
+
+        BitStream delta(buff.data(), buff.size());
+        CHECK(encoder.write(delta, 1));
+        delta.setBitIndex(0);
+        const Snapshot& decodedDelta = decoder.read(delta);
+        REQUIRE(decodedDelta.size() == 2);
+        CHECK(decodedDelta.find(1).empty());
+        CHECK(decodedDelta.find(2)[0] == 22);
+        CHECK(decodedDelta.find(3)[0] == 32);
+    }
+}
@@ -0,0 +1,184 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/physics/physicsWorld.h"
+
+#include "fc/core/collision/shape.h"
+
+#include <doctest/doctest.h>
+#include <memory>
+#include <vector>
+
+static void stepFor(PhysicsWorld& world, float seconds)
+{
+    constexpr float DT = 1.F / 60.F;
+    for (float time = 0; time < seconds; time += DT) {
+        world.step(DT);
+    }
+}
+
+TEST_CASE("Physics world")
+{
+    PhysicsWorld::Config config;
+    config.gravity = {0, 100};
+
+    PhysicsWorld world(config);
+
+    auto ground = world.addBody(std::make_unique<Rect>(Vec2F{0, 500}, Vec2F{1000, 520}), {.mass = 0});
+
+    REQUIRE(world.isValid(ground));
+    REQUIRE(world.isStatic(ground));
+    REQUIRE_FALSE(world.isAwake(ground));
+    REQUIRE(world.awakeCount() == 0);
+
+    SUBCASE("Box falls and rests on the ground")
+    {
+        auto box = world.addBody(std::make_unique<Rect>(Vec2F{100, 400}, Vec2F{120, 420}), {});
+
+        REQUIRE(world.isAwake(box));
+        REQUIRE(world.awakeCount() == 1);
+
+        stepFor(world, 3);
+
+        const auto& rect = static_cast<const Rect&>(world.shape(box));
+        CHECK(rect.max.y == doctest::Approx(500).epsilon(0.001));
+        CHECK(rect.min.x == doctest::Approx(100));
+        CHECK(world.contacts().touching(box, ground));
+
+        SUBCASE("Resting box goes to sleep")
+        {
+            CHECK_FALSE(world.isAwake(box));
+            CHECK(world.awakeCount() == 0);
+            CHECK(world.velocity(box) == Vec2F{});
+
+            // sleeping contacts keep touching, parked out of each step's bookkeeping
+            world.step(1.F / 60.F);
+            CHECK(world.contacts().touching(box, ground));
+            CHECK(world.contacts().ended().empty());
+            CHECK(world.contacts().parkedCount() == 1);
+        }
+
+        SUBCASE("Impulse wakes the box")
+        {
+            world.applyImpulse(box, {0, -500});
+            CHECK(world.isAwake(box));
+            CHECK(world.contacts().parkedCount() == 0);
+            CHECK(world.contacts().touching(box, ground));
+            CHECK(world.velocity(box).y == doctest::Approx(-500));
+
+            // contacts are found before moving the bodies
+            world.step(1.F / 60.F);
+            world.step(1.F / 60.F);
+            CHECK_FALSE(world.contacts().touching(box, ground));
+            REQUIRE(world.contacts().ended().size() == 1);
+        }
+    }
+
+    SUBCASE("Stacked boxes sleep and wake together")
+    {
+        auto bottom = world.addBody(std::make_unique<Rect>(Vec2F{100, 480}, Vec2F{120, 500}), {});
+        auto top = world.addBody(std::make_unique<Rect>(Vec2F{100, 459}, Vec2F{120, 479}), {});
+
+        stepFor(world, 3);
+
+        REQUIRE_FALSE(world.isAwake(bottom));
+        REQUIRE_FALSE(world.isAwake(top));
+        CHECK(world.contacts().parkedCount() == 2);
+
+        world.wake(top);
+        CHECK(world.isAwake(top));
+        CHECK(world.isAwake(bottom));
+        CHECK(world.contacts().parkedCount() == 0);
+        CHECK(world.contacts().touching(top, bottom));
+
+        SUBCASE("Removing the bottom box drops the top one")
+        {
+            stepFor(world, 3);
+            REQUIRE_FALSE(world.isAwake(top));
+
+            float restingY = static_cast<const Rect&>(world.shape(top)).max.y;
+
+            world.removeBody(bottom);
+            CHECK_FALSE(world.isValid(bottom));
+            CHECK(world.isAwake(top));
+
+            stepFor(world, 3);
+            CHECK(static_cast<const Rect&>(world.shape(top)).max.y > restingY + 15);
+            CHECK_FALSE(world.contacts().touching(top, bottom));
+        }
+    }
+
+    SUBCASE("Bouncy circle")
+    {
+        auto ball = world.addBody(std::make_unique<Circle>(Vec2F{300, 400}, 10), {.restitution = 1});
+
+        bool bounced = false;
+        for (int i = 0; i < 120 && !bounced; i++) {
+            world.step(1.F / 60.F);
+            bounced = world.velocity(ball).y < -50;
+        }
+        CHECK(bounced);
+    }
+
+    SUBCASE("Rolling polygon rotates")
+    {
+        auto poly = world.addBody(
+            std::make_unique<Polygon>(Polygon::fromSides(8, {300, 480}, 19)), {.friction = 1, .velocity = {100, 0}}
+        );
+        world.addBody(std::make_unique<Rect>(Vec2F{0, 499}, Vec2F{1000, 500}), {.mass = 0, .friction = 1});
+
+        stepFor(world, 0.5F);
+
+        CHECK(world.angle(poly) != 0);
+        CHECK(world.shape(poly).center().x > 300);
+    }
+}
+
+TEST_CASE("Physics world solver threads")
+{
+    // the same pile of bodies must end up in the exact same place for any thread count
+    auto simulate = [](uint32_t threads) {
+        PhysicsWorld::Config config;
+        config.gravity = {0, 100};
+        config.solverThreads = threads;
+
+        PhysicsWorld world(config);
+        world.addBody(std::make_unique<Rect>(Vec2F{0, 1000}, Vec2F{1024, 1024}), {.mass = 0});
+
+        std::vector<PhysicsWorld::BodyID> bodies;
+        for (int y = 0; y < 20; y++) {
+            for (int x = 0; x < 30; x++) {
+                Vec2F pos{50.F + (x * 30.F) + (y % 2 * 5.F), 980.F - (y * 22.F)};
+                if ((x + y) % 3 == 0) {
+                    bodies.push_back(world.addBody(std::make_unique<Circle>(pos, 10), {}));
+                } else if ((x + y) % 3 == 1) {
+                    bodies.push_back(world.addBody(std::make_unique<Rect>(pos - Vec2F{10, 10}, pos + Vec2F{10, 10}), {}));
+                } else {
+                    bodies.push_back(world.addBody(std::make_unique<Polygon>(Polygon::fromSides(6, pos, 10)), {}));
+                }
+            }
+        }
+
+        for (int i = 0; i < 120; i++) {
+            world.step(1.F / 60.F);
+        }
+
+        std::vector<Vec2F> centers;
+        for (auto id : bodies) {
+            centers.push_back(world.shape(id).center());
+        }
+        return centers;
+    };
+
+    auto serial = simulate(0);
+    auto parallel = simulate(4);
+
+    REQUIRE(serial.size() == parallel.size());
+    for (size_t i = 0; i < serial.size(); i++) {
+        INFO(i);
+        REQUIRE(serial[i] == parallel[i]);
+    }
+}
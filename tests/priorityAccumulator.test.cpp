@@ -0,0 +1,167 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/net/priorityAccumulator.h"
+
+#include "fc/core/bitStream.h"
+#include "fc/core/bufferPool.h"
+
+#include <cstdint>
+#include <doctest/doctest.h>
+#include <stdexcept>
+#include <vector>
+
+using IDs = std::vector<uint32_t>;
+
+/**
+ * Entities of 16 bits, so each one takes 1 + 8 + 16 = 25 bits with IDs up to 255
+ */
+static size_t writeAll(PriorityAccumulator& accumulator, BitStream& stream, size_t budget)
+{
+    return accumulator.write(stream, budget, [](BitStream& out, uint32_t id) {
+        out.writeUint16(id * 100);
+    });
+}
+
+static IDs readAll(BitStream& stream)
+{
+    IDs ids;
+    PriorityAccumulator::read(stream, 8, [&](BitStream& in, uint32_t id) {
+        CHECK(in.readUint16() == id * 100);
+        ids.push_back(id);
+    });
+    return ids;
+}
+
+TEST_CASE("Priority accumulator")
+{
+    PriorityAccumulator accumulator(255);
+    REQUIRE(accumulator.idBits() == 8);
+
+    std::vector<uint8_t> buff(256);
+
+    SUBCASE("Highest priority first within the budget")
+    {
+        accumulator.accumulate(1, 1);
+        accumulator.accumulate(2, 5);
+        accumulator.accumulate(3, 3);
+        accumulator.accumulate(4, 2);
+        accumulator.accumulate(4, 2);
+        CHECK(accumulator.priority(4) == 4);
+        CHECK(accumulator.pendingCount() == 4);
+
+        // room for 2 entities and the end marker
+        BitStream stream(buff.data(), buff.size());
+        CHECK(writeAll(accumulator, stream, 51) == 2);
+        CHECK(stream.bitIndex() == 51);
+
+        stream.setBitIndex(0);
+        CHECK(readAll(stream) == IDs{2, 4});
+
+        // sent ones start over, the others keep what they had
+        CHECK(accumulator.priority(2) == 0);
+        CHECK(accumulator.priority(4) == 0);
+        CHECK(accumulator.priority(3) == 3);
+        CHECK(accumulator.pendingCount() == 2);
+    }
+
+    SUBCASE("Waiting entities get their turn")
+    {
+        IDs sent;
+        for (int tick = 0; tick < 6; tick++) {
+            accumulator.accumulate(1, 3);
+            accumulator.accumulate(2, 2);
+            accumulator.accumulate(3, 1);
+
+            // 1 entity per tick
+            BitStream stream(buff.data(), buff.size());
+            writeAll(accumulator, stream, 26);
+            stream.setBitIndex(0);
+            IDs ids = readAll(stream);
+            REQUIRE(ids.size() == 1);
+            sent.push_back(ids[0]);
+        }
+
+        // 2 overtakes 1 after waiting a tick, 3 gets its turn after waiting 5
+        CHECK(sent == IDs{1, 2, 1, 2, 1, 3});
+    }
+
+    SUBCASE("Smaller entities fill what's left")
+    {
+        accumulator.accumulate(1, 3);
+        accumulator.accumulate(2, 2);
+        accumulator.accumulate(3, 1);
+
+        // 2 is too big for what's left after 1, 3 still fits
+        BitStream stream(buff.data(), buff.size());
+        size_t written = accumulator.write(stream, 80, [](BitStream& out, uint32_t id) {
+            out.writeBits<uint64_t>(id, id == 2 ? 64 : 16);
+        });
+        CHECK(written == 2);
+        CHECK(accumulator.priority(2) == 2);
+        CHECK(accumulator.pendingCount() == 1);
+
+        stream.setBitIndex(0);
+        IDs ids;
+        PriorityAccumulator::read(stream, accumulator.idBits(), [&](BitStream& in, uint32_t id) {
+            CHECK(in.readUint16() == id);
+            ids.push_back(id);
+        });
+        CHECK(ids == IDs{1, 3});
+    }
+
+    SUBCASE("Removing")
+    {
+        accumulator.accumulate(1, 1);
+        accumulator.accumulate(2, 1);
+        accumulator.remove(1);
+        CHECK(accumulator.priority(1) == 0);
+
+        // coming back right away doesn't queue it twice
+        accumulator.accumulate(1, 0.5F);
+
+        BitStream stream(buff.data(), buff.size());
+        CHECK(writeAll(accumulator, stream, 1000) == 2);
+        stream.setBitIndex(0);
+        CHECK(readAll(stream) == IDs{2, 1});
+        CHECK(accumulator.pendingCount() == 0);
+
+        // ignored
+        accumulator.accumulate(3, 0);
+        accumulator.accumulate(3, -1);
+        CHECK(accumulator.pendingCount() == 0);
+    }
+
+    SUBCASE("Nothing to send")
+    {
+        BitStream stream(buff.data(), buff.size());
+        CHECK(writeAll(accumulator, stream, 1) == 0);
+        CHECK(stream.bitIndex() == 1);
+
+        stream.setBitIndex(0);
+        CHECK(readAll(stream).empty());
+    }
+
+    SUBCASE("Budgets")
+    {
+        accumulator.accumulate(1, 1);
+
+        BitStream stream(buff.data(), buff.size());
+        CHECK_THROWS_AS(writeAll(accumulator, stream, 0), std::invalid_argument);
+        CHECK_THROWS_AS(writeAll(accumulator, stream, (buff.size() * 8) + 1), std::out_of_range);
+        CHECK(accumulator.pendingCount() == 1);
+
+        // growable streams take any budget, they only grow as much as is written
+        BufferPool pool;
+        BitStream growable(pool);
+        CHECK(writeAll(accumulator, growable, 10'000) == 1);
+        CHECK(growable.bitIndex() == 26);
+    }
+
+    CHECK(PriorityAccumulator::byDistance(8, 0, 100) == 8);
+    CHECK(PriorityAccumulator::byDistance(8, 100, 100) == 4);
+    CHECK(PriorityAccumulator::byDistance(8, 300, 100) == 2);
+}
@@ -0,0 +1,114 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/net/schema.h"
+
+#include <cmath>
+#include <cstdint>
+#include <doctest/doctest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+struct Move
+{
+    uint16_t id;
+    bool jumping;
+    int16_t velX;
+    float x;
+    float angle;
+    uint64_t flags;
+};
+
+using MoveSchema = Schema<
+    Move,
+    IntField<&Move::id, 12>,
+    BoolField<&Move::jumping>,
+    IntField<&Move::velX, 11>,
+    FloatField<&Move::x, 0.0f, 1024.0f, 16>,
+    FloatField<&Move::angle, -3.2f, 3.2f, 10>,
+    IntField<&Move::flags, 60>>;
+
+static_assert(MoveSchema::BITS == 12 + 1 + 11 + 16 + 10 + 60);
+static_assert(Schema<Move>::BITS == 0);
+
+TEST_CASE("Schema")
+{
+    std::vector<uint8_t> buff(2048);
+    BitStream stream(buff.data(), buff.size());
+
+    SUBCASE("Same bits as writing the fields by hand")
+    {
+        Move move{.id = 1234, .jumping = true, .velX = -700, .x = 0, .angle = 3.2f, .flags = (uint64_t{1} << 59) | 5};
+
+        stream.writeBool(true);
+        MoveSchema::write(stream, move);
+        CHECK(stream.bitIndex() == 1 + MoveSchema::BITS);
+
+        stream.setBitIndex(0);
+        CHECK(stream.readBool());
+        CHECK(stream.readBits<uint16_t>(12) == 1234);
+        CHECK(stream.readBool());
+        CHECK(stream.readBits<int16_t>(11) == -700);
+        CHECK(stream.readBits<uint16_t>(16) == 0);
+        CHECK(stream.readBits<uint16_t>(10) == 1023);
+        CHECK(stream.readBits<uint64_t>(60) == ((uint64_t{1} << 59) | 5));
+
+        stream.setBitIndex(1);
+        Move read = MoveSchema::read(stream);
+        CHECK(read.id == 1234);
+        CHECK(read.jumping);
+        CHECK(read.velX == -700);
+        CHECK(read.x == 0.0f);
+        CHECK(read.angle == doctest::Approx(3.2f));
+        CHECK(read.flags == move.flags);
+    }
+
+    SUBCASE("Quantized floats")
+    {
+        constexpr float X_STEP = 1024.0f / 65535;
+        constexpr float ANGLE_STEP = 6.4f / 1023;
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> xDist(0, 1024);
+        std::uniform_real_distribution<float> angleDist(-3.2f, 3.2f);
+
+        std::vector<Move> moves(100);
+        for (Move& move : moves) {
+            move.x = xDist(rng);
+            move.angle = angleDist(rng);
+        }
+
+        MoveSchema::write(stream, std::span<const Move>(moves));
+        CHECK(stream.bitIndex() == MoveSchema::BITS * moves.size());
+
+        std::vector<Move> read(moves.size());
+        stream.setBitIndex(0);
+        MoveSchema::read(stream, std::span<Move>(read));
+
+        for (size_t i = 0; i < moves.size(); i++) {
+            CHECK(std::abs(read[i].x - moves[i].x) <= X_STEP / 2 + 1e-4f);
+            CHECK(std::abs(read[i].angle - moves[i].angle) <= ANGLE_STEP / 2 + 1e-5f);
+        }
+
+        // clamped to the range
+        Move outside{.x = 2000, .angle = -10};
+        stream.setBitIndex(0);
+        MoveSchema::write(stream, outside);
+        stream.setBitIndex(0);
+        Move clamped = MoveSchema::read(stream);
+        CHECK(clamped.x == 1024.0f);
+        CHECK(clamped.angle == doctest::Approx(-3.2f));
+    }
+
+    SUBCASE("A single size check")
+    {
+        stream.setBitIndex(stream.bitSize() - MoveSchema::BITS + 1);
+        CHECK_THROWS_AS(MoveSchema::write(stream, Move{}), std::out_of_range);
+        CHECK_THROWS_AS((void)MoveSchema::read(stream), std::out_of_range);
+        CHECK(stream.bitIndex() == stream.bitSize() - MoveSchema::BITS + 1);
+    }
+}
@@ -0,0 +1,240 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/net/snapshot.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <doctest/doctest.h>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+static bool sameEntities(const Snapshot& a, const Snapshot& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a.id(i) != b.id(i) || !std::ranges::equal(a.fields(i), b.fields(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("Snapshot deltas")
+{
+    // x, y, health
+    SnapshotEncoder encoder({12, 12, 7}, 8);
+    SnapshotDecoder decoder({12, 12, 7}, 8);
+
+    std::vector<uint8_t> buff(4096);
+
+    Snapshot& first = encoder.next(1);
+    first.add(3, std::array<uint32_t, 3>{100, 200, 50});
+    first.add(7, std::array<uint32_t, 3>{0, 0, 0});
+    first.add(20, std::array<uint32_t, 3>{4000, 17, 99});
+
+    BitStream full(buff.data(), buff.size());
+    CHECK_FALSE(encoder.write(full, SnapshotEncoder::NO_BASELINE));
+    full.setBitIndex(0);
+
+    const Snapshot& firstRead = decoder.read(full);
+    CHECK(firstRead.tick() == 1);
+    CHECK(sameEntities(firstRead, first));
+    CHECK(firstRead.find(7).size() == 3);
+    CHECK(firstRead.find(8).empty());
+
+    SUBCASE("Unchanged entities aren't written")
+    {
+        Snapshot& second = encoder.next(2);
+        second.add(3, std::array<uint32_t, 3>{100, 200, 50});
+        second.add(7, std::array<uint32_t, 3>{0, 0, 0});
+        second.add(20, std::array<uint32_t, 3>{4000, 17, 99});
+
+        BitStream stream(buff.data(), buff.size());
+        CHECK(encoder.write(stream, 1));
+
+        // tick, baseline, age, removed count, changed count
+        CHECK(stream.bitIndex() == 32 + 1 + 8 + 8 + 8);
+
+        stream.setBitIndex(0);
+        CHECK(sameEntities(decoder.read(stream), second));
+    }
+
+    SUBCASE("Only changed fields are written")
+    {
+        Snapshot& second = encoder.next(2);
+        second.add(3, std::array<uint32_t, 3>{101, 200, 50});
+        second.add(7, std::array<uint32_t, 3>{0, 0, 0});
+        second.add(20, std::array<uint32_t, 3>{4000, 17, 98});
+
+        BitStream stream(buff.data(), buff.size());
+        CHECK(encoder.write(stream, 1));
+
+        // 2 changed entities, an ID, a mask and 1 field each
+        size_t idBits = 5 + 9; // exp-Golomb of 3 and 16
+        CHECK(stream.bitIndex() == 32 + 1 + 8 + 8 + 8 + idBits + 3 + 12 + 3 + 7);
+
+        stream.setBitIndex(0);
+        CHECK(sameEntities(decoder.read(stream), second));
+    }
+
+    SUBCASE("Added and removed entities")
+    {
+        Snapshot& second = encoder.next(2);
+        second.add(3, std::array<uint32_t, 3>{100, 200, 50});
+        second.add(5, std::array<uint32_t, 3>{0, 0, 0});
+        second.add(30, std::array<uint32_t, 3>{1, 2, 3});
+
+        BitStream stream(buff.data(), buff.size());
+        CHECK(encoder.write(stream, 1));
+        stream.setBitIndex(0);
+
+        const Snapshot& read = decoder.read(stream);
+        CHECK(sameEntities(read, second));
+        CHECK(read.find(7).empty());
+        CHECK(read.find(20).empty());
+        // all zero fields but still created
+        CHECK(read.find(5).size() == 3);
+    }
+
+    SUBCASE("Baselines per client")
+    {
+        SnapshotDecoder lagging({12, 12, 7}, 8);
+        full.setBitIndex(0);
+        (void)lagging.read(full);
+
+        Snapshot& second = encoder.next(2);
+        second.add(3, std::array<uint32_t, 3>{110, 200, 50});
+        second.add(20, std::array<uint32_t, 3>{4000, 17, 99});
+
+        BitStream stream(buff.data(), buff.size());
+        CHECK(encoder.write(stream, 1));
+        stream.setBitIndex(0);
+        (void)decoder.read(stream);
+
+        Snapshot& third = encoder.next(3);
+        third.add(3, std::array<uint32_t, 3>{120, 200, 50});
+        third.add(20, std::array<uint32_t, 3>{4000, 17, 99});
+
+        // one client acknowledged tick 2, the other only tick 1
+        BitStream upToDate(buff.data(), buff.size());
+        CHECK(encoder.write(upToDate, 2));
+        upToDate.setBitIndex(0);
+        CHECK(sameEntities(decoder.read(upToDate), third));
+
+        BitStream behind(buff.data(), buff.size());
+        CHECK(encoder.write(behind, 1));
+        behind.setBitIndex(0);
+        CHECK(sameEntities(lagging.read(behind), third));
+    }
+
+    SUBCASE("Baselines that fell out of the history")
+    {
+        for (uint32_t tick = 2; tick < 12; tick++) {
+            Snapshot& snapshot = encoder.next(tick);
+            snapshot.add(3, std::array<uint32_t, 3>{tick, 0, 0});
+        }
+
+        BitStream stream(buff.data(), buff.size());
+        CHECK_FALSE(encoder.write(stream, 1));
+        stream.setBitIndex(0);
+        CHECK(decoder.read(stream).find(3)[0] == 11);
+
+        // the decoder doesn't have tick 5
+        BitStream delta(buff.data(), buff.size());
+        CHECK(encoder.write(delta, 5));
+        delta.setBitIndex(0);
+        CHECK_THROWS_AS((void)decoder.read(delta), std::runtime_error);
+    }
+}
+
+TEST_CASE("Snapshot decoder rejects IDs out of order")
+{
+    SnapshotDecoder decoder({8}, 4);
+    std::vector<uint8_t> buff(256);
+
+    // no baseline, nothing removed, then the changed entities as ID gaps and field masks
+    auto packet = [&](std::span<const uint64_t> gaps) {
+        BitStream stream(buff.data(), buff.size());
+        stream.writeUint32(1);
+        stream.writeBool(false);
+        stream.writeVarUint(0);
+        stream.writeVarUint(gaps.size());
+        for (uint64_t gap : gaps) {
+            stream.writeExpGolomb(gap);
+            stream.writeBits<uint32_t>(1, 1);
+            stream.writeBits<uint32_t>(42, 8);
+        }
+        stream.setBitIndex(0);
+        return stream;
+    };
+
+    // the largest ID is fine
+    BitStream largest = packet(std::array<uint64_t, 2>{5, UINT32_MAX - 6});
+    const Snapshot& read = decoder.read(largest);
+    REQUIRE(read.size() == 2);
+    CHECK(read.id(1) == UINT32_MAX);
+
+    // would wrap around to 4 once truncated to 32 bits
+    BitStream wrapping = packet(std::array<uint64_t, 2>{5, (uint64_t{1} << 32) - 2});
+    CHECK_THROWS_AS((void)decoder.read(wrapping), std::out_of_range);
+
+    // nothing comes after the largest ID
+    BitStream past = packet(std::array<uint64_t, 2>{UINT32_MAX, 0});
+    CHECK_THROWS_AS((void)decoder.read(past), std::out_of_range);
+}
+
+TEST_CASE("Snapshot deltas of random changes")
+{
+    std::vector<uint8_t> bits = {20, 20, 11, 11, 1, 7};
+    SnapshotEncoder encoder(bits, 16);
+    SnapshotDecoder decoder(bits, 16);
+
+    std::mt19937 rng(42);
+    std::vector<uint8_t> buff(1 << 16);
+
+    std::vector<uint32_t> alive(200, 1);
+    std::vector<uint32_t> state(200 * bits.size(), 0);
+
+    uint32_t ackedTick = SnapshotEncoder::NO_BASELINE;
+    for (uint32_t tick = 0; tick < 100; tick++) {
+        for (size_t i = 0; i < alive.size(); i++) {
+            if (rng() % 20 == 0) {
+                alive[i] ^= 1;
+            }
+            for (size_t f = 0; f < bits.size(); f++) {
+                if (rng() % 8 == 0) {
+                    state[(i * bits.size()) + f] = rng() & ((1u << bits[f]) - 1);
+                }
+            }
+        }
+
+        Snapshot& snapshot = encoder.next(tick);
+        for (size_t i = 0; i < alive.size(); i++) {
+            if (alive[i] != 0) {
+                snapshot.add(i * 3, std::span(state).subspan(i * bits.size(), bits.size()));
+            }
+        }
+
+        BitStream stream(buff.data(), buff.size());
+        encoder.write(stream, ackedTick);
+        stream.setBitIndex(0);
+
+        const Snapshot& read = decoder.read(stream);
+        REQUIRE(sameEntities(read, snapshot));
+
+        // packets are sometimes lost so the acknowledged tick lags behind
+        if (rng() % 3 != 0) {
+            ackedTick = tick;
+        }
+    }
+}
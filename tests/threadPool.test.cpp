@@ -0,0 +1,60 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/threadPool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <doctest/doctest.h>
+#include <vector>
+
+TEST_CASE("Thread pool")
+{
+    for (size_t workers : {0, 1, 4}) {
+        INFO(workers);
+
+        ThreadPool pool(workers);
+        REQUIRE(pool.workerCount() == workers);
+
+        // every index is visited once
+        {
+            std::vector<std::atomic<int>> visits(10'000);
+            std::atomic<bool> badChunk = false;
+
+            for (int round = 0; round < 20; round++) {
+                pool.parallelFor(visits.size(), 37, [&](size_t begin, size_t end) {
+                    // assertions can't throw from the workers
+                    if (begin >= end || (workers > 0 && end - begin > 37)) {
+                        badChunk = true;
+                    }
+                    for (size_t i = begin; i < end; i++) {
+                        visits[i]++;
+                    }
+                });
+            }
+
+            CHECK_FALSE(badChunk);
+            for (const auto& count : visits) {
+                REQUIRE(count == 20);
+            }
+        }
+
+        // small and empty loops run inline
+        {
+            size_t calls = 0;
+
+            pool.parallelFor(0, 16, [&](size_t, size_t) { calls++; });
+            CHECK(calls == 0);
+
+            pool.parallelFor(16, 16, [&](size_t begin, size_t end) {
+                CHECK(begin == 0);
+                CHECK(end == 16);
+                calls++;
+            });
+            CHECK(calls == 1);
+        }
+    }
+}
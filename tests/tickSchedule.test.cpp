@@ -0,0 +1,76 @@
+/*
+    This file is part of the firecat2d project.
+    SPDX-License-Identifier: LGPL-3.0-only
+    SPDX-FileCopyrightText: 2026 firecat2d developers
+*/
+
+#include "fc/core/tickSchedule.h"
+
+#include <doctest/doctest.h>
+#include <stdexcept>
+
+/**
+ * Ticks due when waking up at `now`
+ */
+static int runDue(TickSchedule& schedule, double now)
+{
+    int ticks = 0;
+    while (schedule.next(now)) {
+        ticks++;
+    }
+    return ticks;
+}
+
+TEST_CASE("Tick schedule")
+{
+    // a period of 0.25 is exact in a double
+    TickSchedule schedule(4);
+    CHECK(schedule.period() == 0.25);
+    schedule.start(100);
+
+    SUBCASE("Fixed rate")
+    {
+        CHECK(runDue(schedule, 100) == 1);
+        CHECK(schedule.nextTime() == 100.25);
+
+        // woken up early, then on time
+        CHECK(runDue(schedule, 100.2) == 0);
+        CHECK(runDue(schedule, 100.25) == 1);
+
+        // the schedule comes from the start, late wake ups don't push it back
+        CHECK(runDue(schedule, 100.6) == 1);
+        CHECK(schedule.nextTime() == 100.75);
+        CHECK(runDue(schedule, 100.75) == 1);
+
+        // woken up every 0.1 for 10 seconds, still 4 per second
+        int ticks = 0;
+        for (int i = 1; i <= 100; i++) {
+            ticks += runDue(schedule, 100.75 + (i * 0.1));
+        }
+        CHECK(ticks == 40);
+    }
+
+    SUBCASE("Catching up")
+    {
+        CHECK(runDue(schedule, 100) == 1);
+
+        // 1 second late, the 4 missed ticks and the one due now run back to back
+        CHECK(runDue(schedule, 101.25) == 5);
+        CHECK(schedule.nextTime() == 101.5);
+    }
+
+    SUBCASE("Skipping ahead")
+    {
+        CHECK(runDue(schedule, 100) == 1);
+
+        // more than 8 ticks behind, only the one due now runs and the schedule starts over from there
+        CHECK(runDue(schedule, 160) == 1);
+        CHECK(schedule.nextTime() == 160.25);
+        CHECK(runDue(schedule, 160.25) == 1);
+
+        // exactly 8 behind still catches up
+        CHECK(runDue(schedule, 162.5) == 9);
+    }
+
+    CHECK_THROWS_AS(TickSchedule(0), std::invalid_argument);
+}